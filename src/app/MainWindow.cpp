@@ -4,6 +4,7 @@
 #include <QComboBox>
 #include <QDateTime>
 #include <QDir>
+#include <QFile>
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QFormLayout>
@@ -39,12 +40,20 @@
 #include "control/ArtnetInputService.h"
 #include "control/FailoverSyncService.h"
 #include "control/MidiInputService.h"
+#include "control/OscFeedbackPublisher.h"
 #include "control/OscServer.h"
+#include "control/TimecodeChaseClock.h"
+#include "controllers/LatencyMonitor.h"
 #include "controllers/OutputRouter.h"
 #include "controllers/PlaybackController.h"
+#include "controllers/PreloadPlanner.h"
+#include "controllers/ShowScheduler.h"
 #include "core/Cue.h"
 #include "core/CueListModel.h"
+#include "core/Trace.h"
 #include "display/DisplayManager.h"
+#include "media/MediaLibrary.h"
+#include "media/MediaPrefetcher.h"
 #include "ndi/NdiBridge.h"
 #include "output/DeckLinkBridge.h"
 #include "output/SyphonBridge.h"
@@ -52,6 +61,10 @@
 
 namespace {
 
+// Cues warmed ahead of the operator: the live cue's automatic successors, the
+// selection and what follows it.
+constexpr int kPrefetchLookahead = 4;
+
 QMap<QString, QString> parseFilterPresets(const QString& encoded) {
   QMap<QString, QString> presets;
   const QStringList pairs = encoded.split(';', Qt::SkipEmptyParts);
@@ -81,6 +94,11 @@ QString serializeFilterPresets(const QMap<QString, QString>& presets) {
   return pairs.join(';');
 }
 
+QString mediaIndexPath() {
+  const QString appData = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+  return appData.isEmpty() ? QString() : QDir(appData).filePath("media-index.json");
+}
+
 }  // namespace
 
 MainWindow::MainWindow(QWidget* parent)
@@ -89,10 +107,14 @@ MainWindow::MainWindow(QWidget* parent)
       displayManager_(new DisplayManager(this)),
       outputRouter_(new OutputRouter(displayManager_, this)),
       playbackController_(new PlaybackController(cueModel_, outputRouter_, this)),
+      mediaLibrary_(new MediaLibrary(mediaIndexPath(), this)),
+      mediaPrefetcher_(new MediaPrefetcher(this)),
+      oscFeedback_(new OscFeedbackPublisher(this)),
       oscServer_(new OscServer(this)),
       artnetService_(new ArtnetInputService(this)),
       failoverSync_(new FailoverSyncService(this)),
       midiService_(new MidiInputService(this)),
+      timecodeClock_(new TimecodeChaseClock(this)),
       ndiBridge_(new NdiBridge(this)),
       syphonBridge_(new SyphonBridge(this)),
       deckLinkBridge_(new DeckLinkBridge(this)),
@@ -118,6 +140,8 @@ MainWindow::MainWindow(QWidget* parent)
       playlistAdvanceCheck_(new QCheckBox("Playlist Auto Advance", this)),
       playlistLoopCheck_(new QCheckBox("Playlist Loop", this)),
       playlistDelaySpin_(new QSpinBox(this)),
+      advanceTriggerCombo_(new QComboBox(this)),
+      advanceLeadSpin_(new QSpinBox(this)),
       autoStopSpin_(new QSpinBox(this)),
       autoFollowCheck_(new QCheckBox("Auto Follow", this)),
       followCueRowSpin_(new QSpinBox(this)),
@@ -133,6 +157,15 @@ MainWindow::MainWindow(QWidget* parent)
       maskTopSpin_(new QSpinBox(this)),
       maskRightSpin_(new QSpinBox(this)),
       maskBottomSpin_(new QSpinBox(this)),
+      cornerPinCheck_(new QCheckBox("Enable Corner Pin", this)),
+      pinTopLeftXSpin_(new QSpinBox(this)),
+      pinTopLeftYSpin_(new QSpinBox(this)),
+      pinTopRightXSpin_(new QSpinBox(this)),
+      pinTopRightYSpin_(new QSpinBox(this)),
+      pinBottomLeftXSpin_(new QSpinBox(this)),
+      pinBottomLeftYSpin_(new QSpinBox(this)),
+      pinBottomRightXSpin_(new QSpinBox(this)),
+      pinBottomRightYSpin_(new QSpinBox(this)),
       slatePathEdit_(new QLineEdit(this)),
       oscPortSpin_(new QSpinBox(this)),
       relativePathCheck_(new QCheckBox("Use Relative Media Paths", this)),
@@ -152,6 +185,18 @@ MainWindow::MainWindow(QWidget* parent)
       failoverPeerPortSpin_(new QSpinBox(this)),
       failoverListenPortSpin_(new QSpinBox(this)),
       failoverKeyEdit_(new QLineEdit(this)),
+      renderBackendCombo_(new QComboBox(this)),
+      prefetchBudgetSpin_(new QSpinBox(this)),
+      prefetchHeadSpin_(new QSpinBox(this)),
+      prefetchStatsLabel_(new QLabel(this)),
+      timecodeFreewheelSpin_(new QSpinBox(this)),
+      standbyLookaheadSpin_(new QSpinBox(this)),
+      standbyDecodersSpin_(new QSpinBox(this)),
+      standbyBudgetSpin_(new QSpinBox(this)),
+      standbyStatsLabel_(new QLabel(this)),
+      latencyStatsLabel_(new QLabel(this)),
+      traceCheck_(new QCheckBox("Record GO pipeline trace", this)),
+      scheduledLabel_(new QLabel(this)),
       statusLabel_(new QLabel(this)),
       backupNetwork_(new QNetworkAccessManager(this)) {
   setWindowTitle("VideoPlayerForMe (v1.5 show control)");
@@ -177,6 +222,11 @@ MainWindow::MainWindow(QWidget* parent)
   playlistIdEdit_->setPlaceholderText("Optional playlist/group id");
   playlistDelaySpin_->setRange(0, 300000);
   playlistDelaySpin_->setSuffix(" ms");
+  advanceTriggerCombo_->addItem("After Delay", static_cast<int>(AdvanceTrigger::AfterDelay));
+  advanceTriggerCombo_->addItem("At Media End", static_cast<int>(AdvanceTrigger::MediaEnd));
+  advanceLeadSpin_->setRange(0, 60000);
+  advanceLeadSpin_->setSuffix(" ms before end");
+  advanceLeadSpin_->setSpecialValueText("At end");
   autoStopSpin_->setRange(0, 600000);
   autoStopSpin_->setSuffix(" ms");
   autoStopSpin_->setSpecialValueText("Disabled");
@@ -216,6 +266,11 @@ MainWindow::MainWindow(QWidget* parent)
   maskTopSpin_->setSuffix(" px");
   maskRightSpin_->setSuffix(" px");
   maskBottomSpin_->setSuffix(" px");
+  for (QSpinBox* spin : {pinTopLeftXSpin_, pinTopLeftYSpin_, pinTopRightXSpin_, pinTopRightYSpin_,
+                         pinBottomLeftXSpin_, pinBottomLeftYSpin_, pinBottomRightXSpin_, pinBottomRightYSpin_}) {
+    spin->setRange(-2000, 2000);
+    spin->setSuffix(" px");
+  }
 
   oscPortSpin_->setRange(1024, 65535);
   oscPortSpin_->setValue(config_.oscPort);
@@ -247,6 +302,34 @@ MainWindow::MainWindow(QWidget* parent)
   failoverKeyEdit_->setText(config_.failoverSharedKey);
   failoverKeyEdit_->setPlaceholderText("Shared key");
   failoverKeyEdit_->setEchoMode(QLineEdit::Password);
+  renderBackendCombo_->addItem("Native Windows", static_cast<int>(RenderBackend::NativeWindows));
+  renderBackendCombo_->addItem("Software Compositor", static_cast<int>(RenderBackend::SoftwareCompositor));
+  renderBackendCombo_->setCurrentIndex(renderBackendCombo_->findData(static_cast<int>(config_.renderBackend)));
+  prefetchBudgetSpin_->setRange(0, 16384);
+  prefetchBudgetSpin_->setSuffix(" MB");
+  prefetchBudgetSpin_->setValue(config_.prefetchBudgetMb);
+  prefetchHeadSpin_->setRange(1, 1024);
+  prefetchHeadSpin_->setSuffix(" MB");
+  prefetchHeadSpin_->setValue(config_.prefetchHeadMb);
+  prefetchStatsLabel_->setText("-");
+  timecodeFreewheelSpin_->setRange(0, 10000);
+  timecodeFreewheelSpin_->setSingleStep(100);
+  timecodeFreewheelSpin_->setSuffix(" ms");
+  timecodeFreewheelSpin_->setValue(config_.timecodeFreewheelMs);
+  standbyLookaheadSpin_->setRange(0, 32);
+  standbyLookaheadSpin_->setSuffix(" cue(s)");
+  standbyLookaheadSpin_->setToolTip("Upcoming cues kept loaded and paused in off-air players; 0 turns it off.");
+  standbyLookaheadSpin_->setValue(config_.standbyLookahead);
+  standbyDecodersSpin_->setRange(0, 64);
+  standbyDecodersSpin_->setValue(config_.standbyMaxDecoders);
+  standbyBudgetSpin_->setRange(0, 65536);
+  standbyBudgetSpin_->setSuffix(" MB");
+  standbyBudgetSpin_->setSpecialValueText("Unlimited");
+  standbyBudgetSpin_->setValue(config_.standbyBudgetMb);
+  standbyStatsLabel_->setText("-");
+  latencyStatsLabel_->setText("-");
+  traceCheck_->setToolTip("Records routing, transition, filter and load spans for export as a Chrome trace.");
+  scheduledLabel_->setText("None");
 
   auto* addCueButton = new QPushButton("Add Cue", this);
   auto* addPatternButton = new QPushButton("Add Test Pattern", this);
@@ -269,6 +352,9 @@ MainWindow::MainWindow(QWidget* parent)
   auto* refreshDisplaysButton = new QPushButton("Refresh Displays", this);
   auto* startOscButton = new QPushButton("Restart OSC", this);
   auto* browseSlateButton = new QPushButton("Browse Slate", this);
+  auto* exportLatencyButton = new QPushButton("Export Latency", this);
+  auto* resetLatencyButton = new QPushButton("Reset Latency", this);
+  auto* exportTraceButton = new QPushButton("Export Trace", this);
 
   auto* transportControls = new QHBoxLayout();
   transportControls->addWidget(addCueButton);
@@ -318,6 +404,8 @@ MainWindow::MainWindow(QWidget* parent)
   cueForm->addRow("Auto Follow", autoFollowCheck_);
   cueForm->addRow("Follow Row", followCueRowSpin_);
   cueForm->addRow("Follow Delay", followDelaySpin_);
+  cueForm->addRow("Advance On", advanceTriggerCombo_);
+  cueForm->addRow("End Lead", advanceLeadSpin_);
   cueForm->addRow("Auto Stop", autoStopSpin_);
   cueForm->addRow("Hotkey", hotkeyEdit_);
   cueForm->addRow("Timecode", timecodeEdit_);
@@ -345,11 +433,30 @@ MainWindow::MainWindow(QWidget* parent)
   calibrationForm->addRow("Mask Top", maskTopSpin_);
   calibrationForm->addRow("Mask Right", maskRightSpin_);
   calibrationForm->addRow("Mask Bottom", maskBottomSpin_);
+  auto* pinTopLeftRow = new QHBoxLayout();
+  pinTopLeftRow->addWidget(pinTopLeftXSpin_);
+  pinTopLeftRow->addWidget(pinTopLeftYSpin_);
+  auto* pinTopRightRow = new QHBoxLayout();
+  pinTopRightRow->addWidget(pinTopRightXSpin_);
+  pinTopRightRow->addWidget(pinTopRightYSpin_);
+  auto* pinBottomLeftRow = new QHBoxLayout();
+  pinBottomLeftRow->addWidget(pinBottomLeftXSpin_);
+  pinBottomLeftRow->addWidget(pinBottomLeftYSpin_);
+  auto* pinBottomRightRow = new QHBoxLayout();
+  pinBottomRightRow->addWidget(pinBottomRightXSpin_);
+  pinBottomRightRow->addWidget(pinBottomRightYSpin_);
+  calibrationForm->addRow("Corner Pin", cornerPinCheck_);
+  calibrationForm->addRow("Pin Top Left", pinTopLeftRow);
+  calibrationForm->addRow("Pin Top Right", pinTopRightRow);
+  calibrationForm->addRow("Pin Bottom Left", pinBottomLeftRow);
+  calibrationForm->addRow("Pin Bottom Right", pinBottomRightRow);
   calibrationForm->addRow("Fallback Slate", slatePathEdit_);
   calibrationForm->addRow("", browseSlateButton);
 
   auto* calibrationGroup = new QGroupBox("Output Calibration", this);
   calibrationGroup->setLayout(calibrationForm);
+  calibrationGroup->setToolTip(
+      "Keystone and corner pin warp live on both render backends without restarting the video.");
 
   auto* controlForm = new QFormLayout();
   controlForm->addRow("OSC Port", oscPortSpin_);
@@ -370,6 +477,23 @@ MainWindow::MainWindow(QWidget* parent)
   controlForm->addRow("Failover Peer Port", failoverPeerPortSpin_);
   controlForm->addRow("Failover Listen Port", failoverListenPortSpin_);
   controlForm->addRow("Failover Key", failoverKeyEdit_);
+  controlForm->addRow("Render Backend", renderBackendCombo_);
+  controlForm->addRow("Prefetch Budget", prefetchBudgetSpin_);
+  controlForm->addRow("Prefetch Head", prefetchHeadSpin_);
+  controlForm->addRow("Prefetch", prefetchStatsLabel_);
+  controlForm->addRow("Timecode Freewheel", timecodeFreewheelSpin_);
+  controlForm->addRow("Standby Lookahead", standbyLookaheadSpin_);
+  controlForm->addRow("Standby Decoders", standbyDecodersSpin_);
+  controlForm->addRow("Standby Budget", standbyBudgetSpin_);
+  controlForm->addRow("Standby", standbyStatsLabel_);
+  auto* latencyButtons = new QHBoxLayout();
+  latencyButtons->addWidget(exportLatencyButton);
+  latencyButtons->addWidget(resetLatencyButton);
+  controlForm->addRow("Latency", latencyStatsLabel_);
+  controlForm->addRow("", latencyButtons);
+  controlForm->addRow("Tracing", traceCheck_);
+  controlForm->addRow("", exportTraceButton);
+  controlForm->addRow("Scheduled", scheduledLabel_);
 
   auto* controlGroup = new QGroupBox("Control Inputs", this);
   controlGroup->setLayout(controlForm);
@@ -421,9 +545,16 @@ MainWindow::MainWindow(QWidget* parent)
 
   connect(startOscButton, &QPushButton::clicked, this, &MainWindow::restartOscServer);
   connect(browseSlateButton, &QPushButton::clicked, this, &MainWindow::browseSlatePath);
+  connect(exportLatencyButton, &QPushButton::clicked, this, &MainWindow::exportLatency);
+  connect(resetLatencyButton, &QPushButton::clicked, this, &MainWindow::resetLatency);
+  connect(traceCheck_, &QCheckBox::toggled, this, &MainWindow::setTracing);
+  connect(exportTraceButton, &QPushButton::clicked, this, &MainWindow::exportTrace);
 
   connect(cueTable_->selectionModel(), &QItemSelectionModel::currentChanged, this,
-          [this](const QModelIndex&, const QModelIndex&) { syncEditorsFromSelection(); });
+          [this](const QModelIndex&, const QModelIndex&) {
+            syncEditorsFromSelection();
+            refreshLookahead();
+          });
 
   connect(screenCombo_, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
           [this](int) { applyEditorsToSelection(); });
@@ -453,6 +584,10 @@ MainWindow::MainWindow(QWidget* parent)
           [this](int) { applyEditorsToSelection(); });
   connect(followDelaySpin_, QOverload<int>::of(&QSpinBox::valueChanged), this,
           [this](int) { applyEditorsToSelection(); });
+  connect(advanceTriggerCombo_, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+          [this](int) { applyEditorsToSelection(); });
+  connect(advanceLeadSpin_, QOverload<int>::of(&QSpinBox::valueChanged), this,
+          [this](int) { applyEditorsToSelection(); });
   connect(autoStopSpin_, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int) { applyEditorsToSelection(); });
   connect(hotkeyEdit_, &QLineEdit::editingFinished, this, &MainWindow::applyEditorsToSelection);
   connect(timecodeEdit_, &QLineEdit::editingFinished, this, &MainWindow::applyEditorsToSelection);
@@ -483,6 +618,11 @@ MainWindow::MainWindow(QWidget* parent)
   connect(maskTopSpin_, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int) { applyCalibrationToScreen(); });
   connect(maskRightSpin_, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int) { applyCalibrationToScreen(); });
   connect(maskBottomSpin_, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int) { applyCalibrationToScreen(); });
+  connect(cornerPinCheck_, &QCheckBox::toggled, this, [this](bool) { applyCalibrationToScreen(); });
+  for (QSpinBox* spin : {pinTopLeftXSpin_, pinTopLeftYSpin_, pinTopRightXSpin_, pinTopRightYSpin_,
+                         pinBottomLeftXSpin_, pinBottomLeftYSpin_, pinBottomRightXSpin_, pinBottomRightYSpin_}) {
+    connect(spin, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int) { applyCalibrationToScreen(); });
+  }
   connect(slatePathEdit_, &QLineEdit::editingFinished, this, [this]() {
     config_.fallbackSlatePath = slatePathEdit_->text().trimmed();
     outputRouter_->setFallbackSlatePath(config_.fallbackSlatePath);
@@ -509,6 +649,16 @@ MainWindow::MainWindow(QWidget* parent)
   connect(failoverListenPortSpin_, QOverload<int>::of(&QSpinBox::valueChanged), this,
           [this](int) { applyControlConfig(); });
   connect(failoverKeyEdit_, &QLineEdit::editingFinished, this, &MainWindow::applyControlConfig);
+  connect(renderBackendCombo_, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+          [this](int) { applyControlConfig(); });
+  connect(prefetchBudgetSpin_, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int) { applyControlConfig(); });
+  connect(prefetchHeadSpin_, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int) { applyControlConfig(); });
+  connect(timecodeFreewheelSpin_, QOverload<int>::of(&QSpinBox::valueChanged), this,
+          [this](int) { applyControlConfig(); });
+  connect(standbyLookaheadSpin_, QOverload<int>::of(&QSpinBox::valueChanged), this,
+          [this](int) { applyControlConfig(); });
+  connect(standbyDecodersSpin_, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int) { applyControlConfig(); });
+  connect(standbyBudgetSpin_, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int) { applyControlConfig(); });
 
   connect(displayManager_, &DisplayManager::displaysChanged, this, &MainWindow::refreshScreenChoices);
 
@@ -517,6 +667,52 @@ MainWindow::MainWindow(QWidget* parent)
   connect(playbackController_, &PlaybackController::playbackError, this, &MainWindow::showStatus);
   connect(playbackController_, &PlaybackController::playbackStatus, this, &MainWindow::showStatus);
   connect(playbackController_, &PlaybackController::cueWentLive, this, &MainWindow::forwardCueToBackup);
+  connect(playbackController_->scheduler(), &ShowScheduler::pendingChanged, this, [this]() {
+    const ShowScheduler* scheduler = playbackController_->scheduler();
+    const QVector<ScheduledAction> pending = scheduler->pending();
+    if (pending.isEmpty()) {
+      scheduledLabel_->setText("None");
+      scheduledLabel_->setToolTip({});
+      return;
+    }
+
+    constexpr int kListedActions = 20;
+    const qint64 now = scheduler->nowMs();
+    QStringList lines;
+    for (int i = 0; i < pending.size() && i < kListedActions; ++i) {
+      const ScheduledAction& action = pending.at(i);
+      lines.push_back(QString("%1 in %2 s").arg(action.label).arg((action.dueMs - now) / 1000.0, 0, 'f', 1));
+    }
+    if (pending.size() > kListedActions) {
+      lines.push_back(QString("... %1 more").arg(pending.size() - kListedActions));
+    }
+    scheduledLabel_->setText(QString("%1 pending, next: %2").arg(pending.size()).arg(lines.first()));
+    scheduledLabel_->setToolTip(lines.join('\n'));
+  });
+  connect(playbackController_->latencyMonitor(), &LatencyMonitor::sampleRecorded, this,
+          &MainWindow::refreshLatencyStats);
+  connect(playbackController_, &PlaybackController::cueWentLive, this, [this](const Cue& cue) {
+    mediaPrefetcher_->recordGo(cue.filePath);
+    lastLiveCueId_ = cue.id;
+    refreshLookahead();
+  });
+
+  connect(mediaLibrary_, &MediaLibrary::mediaUpdated, cueModel_,
+          [this](const QString&, const MediaInfo& info) { cueModel_->setMediaInfo(info); });
+  connect(mediaLibrary_, &MediaLibrary::scanFinished, this, [this](int probed, int reused, int missing) {
+    const QString relinkNote = missing > 0 ? QString(", %1 missing, run Relink Missing").arg(missing) : QString();
+    showStatus(QString("Media scan: %1 probed, %2 from index%3").arg(probed).arg(reused).arg(relinkNote));
+    refreshLookahead();
+  });
+  connect(mediaPrefetcher_, &MediaPrefetcher::statsChanged, this, [this](const PrefetchStats& stats) {
+    constexpr double kMb = 1024.0 * 1024.0;
+    prefetchStatsLabel_->setText(QString("%1 hit / %2 miss, %3 file(s) warm, %4 / %5 MB")
+                                     .arg(stats.hits)
+                                     .arg(stats.misses)
+                                     .arg(stats.warmFiles)
+                                     .arg(stats.warmBytes / kMb, 0, 'f', 0)
+                                     .arg(stats.budgetBytes / kMb, 0, 'f', 0));
+  });
 
   connect(oscServer_, &OscServer::statusMessage, this, &MainWindow::showStatus);
   connect(oscServer_, &OscServer::playRowRequested, this, &MainWindow::handleExternalPlayRow);
@@ -524,9 +720,34 @@ MainWindow::MainWindow(QWidget* parent)
   connect(oscServer_, &OscServer::preloadRowRequested, this, &MainWindow::handleExternalPreloadRow);
   connect(oscServer_, &OscServer::takeRequested, this, &MainWindow::handleExternalTake);
   connect(oscServer_, &OscServer::stopAllRequested, this, &MainWindow::stopAllCues);
-  connect(oscServer_, &OscServer::timecodeReceived, this, &MainWindow::handleTimecode);
+  connect(oscServer_, &OscServer::timecodeReceived, timecodeClock_,
+          [this](const Timecode& timecode) { timecodeClock_->feed(timecode); });
   connect(oscServer_, &OscServer::dmxValueReceived, this, &MainWindow::handleExternalDmx);
   connect(oscServer_, &OscServer::overlayTextReceived, this, &MainWindow::handleExternalOverlayText);
+  connect(oscServer_, &OscServer::playCueIdRequested, this, &MainWindow::handleExternalCueIdGo);
+  connect(oscServer_, &OscServer::playGroupRequested, this, &MainWindow::handleExternalGroupGo);
+  connect(oscServer_, &OscServer::preloadCueIdRequested, this, &MainWindow::handleExternalCueIdPreload);
+  connect(oscServer_, &OscServer::stopLayerRequested, playbackController_, &PlaybackController::stopLayer);
+  connect(oscServer_, &OscServer::feedbackSubscribeRequested, oscFeedback_, &OscFeedbackPublisher::subscribe);
+  connect(oscServer_, &OscServer::feedbackUnsubscribeRequested, oscFeedback_, &OscFeedbackPublisher::unsubscribe);
+  connect(oscServer_, &OscServer::sessionClosed, oscFeedback_, &OscFeedbackPublisher::dropSession);
+  // sendToSession is thread-safe, so session feedback goes from the publisher
+  // thread to the I/O thread without waiting on the GUI thread.
+  connect(oscFeedback_, &OscFeedbackPublisher::sessionPacketReady, oscServer_, &OscServer::sendToSession,
+          Qt::DirectConnection);
+
+  connect(oscFeedback_, &OscFeedbackPublisher::statusMessage, this, &MainWindow::showStatus);
+  connect(outputRouter_, &OutputRouter::cueOnAir, this, [this](const QString& cueId, int screenIndex, int layer) {
+    const int row = cueModel_->rowForCueId(cueId);
+    oscFeedback_->publishCueLive(cueId, row >= 0 ? cueModel_->cueAt(row).name : QString(), screenIndex, layer);
+  });
+  connect(outputRouter_, &OutputRouter::layerStopped, oscFeedback_, &OscFeedbackPublisher::publishLayerStopped);
+  connect(outputRouter_, &OutputRouter::allStopped, oscFeedback_, &OscFeedbackPublisher::publishAllStopped);
+  connect(outputRouter_, &OutputRouter::cuePositionChanged, oscFeedback_, &OscFeedbackPublisher::publishPosition);
+  connect(outputRouter_, &OutputRouter::routingError, oscFeedback_, &OscFeedbackPublisher::publishError);
+  connect(playbackController_, &PlaybackController::playbackError, oscFeedback_, &OscFeedbackPublisher::publishError);
+  connect(playbackController_, &PlaybackController::cuePreviewed, this,
+          [this](const Cue& cue) { oscFeedback_->publishPreview(cue.id, cue.name); });
 
   connect(artnetService_, &ArtnetInputService::statusMessage, this, &MainWindow::showStatus);
   connect(artnetService_, &ArtnetInputService::dmxValueReceived, this, &MainWindow::handleExternalDmx);
@@ -538,7 +759,32 @@ MainWindow::MainWindow(QWidget* parent)
 
   connect(midiService_, &MidiInputService::statusMessage, this, &MainWindow::showStatus);
   connect(midiService_, &MidiInputService::cueNoteRequested, this, &MainWindow::handleExternalMidiNote);
-  connect(midiService_, &MidiInputService::timecodeReceived, this, &MainWindow::handleTimecode);
+  connect(midiService_, &MidiInputService::timecodeReceived, timecodeClock_, &TimecodeChaseClock::feed);
+  connect(midiService_, &MidiInputService::timecodeLocated, timecodeClock_, &TimecodeChaseClock::locate);
+
+  // Cue triggers run off the chase clock's predicted frame boundaries, not
+  // off raw MTC/OSC arrivals.
+  connect(timecodeClock_, &TimecodeChaseClock::frameReached, this, &MainWindow::handleTimecode);
+  connect(timecodeClock_, &TimecodeChaseClock::jumped, this, [this](const Timecode& from, const Timecode& to) {
+    showStatus(QString("Timecode jump %1 -> %2").arg(from.toString(), to.toString()));
+  });
+  // Queued so the landing frame has reached the trigger table first and the
+  // next timecode cues are looked up from the new position.
+  connect(timecodeClock_, &TimecodeChaseClock::jumped, this, [this]() { refreshLookahead(); }, Qt::QueuedConnection);
+  connect(timecodeClock_, &TimecodeChaseClock::stateChanged, this, [this](TimecodeChaseClock::State state) {
+    const QString position = timecodeClock_->position().toString();
+    switch (state) {
+      case TimecodeChaseClock::State::Locked:
+        showStatus(QString("Timecode locked at %1").arg(position));
+        break;
+      case TimecodeChaseClock::State::Freewheeling:
+        showStatus(QString("Timecode lost, freewheeling from %1").arg(position));
+        break;
+      case TimecodeChaseClock::State::Stopped:
+        showStatus(QString("Timecode stopped at %1").arg(position));
+        break;
+    }
+  });
 
   connect(ndiBridge_, &NdiBridge::statusMessage, this, &MainWindow::showStatus);
   connect(syphonBridge_, &SyphonBridge::statusMessage, this, &MainWindow::showStatus);
@@ -548,7 +794,18 @@ MainWindow::MainWindow(QWidget* parent)
   connect(cueModel_, &QAbstractItemModel::rowsRemoved, this, [this](const QModelIndex&, int, int) { rebuildCueHotkeys(); });
   connect(cueModel_, &QAbstractItemModel::modelReset, this, [this]() { rebuildCueHotkeys(); });
   connect(cueModel_, &QAbstractItemModel::dataChanged, this,
-          [this](const QModelIndex&, const QModelIndex&, const QList<int>&) { rebuildCueHotkeys(); });
+          [this](const QModelIndex& topLeft, const QModelIndex& bottomRight, const QList<int>&) {
+            if (topLeft.column() <= CueListModel::HotkeyColumn && bottomRight.column() >= CueListModel::HotkeyColumn) {
+              rebuildCueHotkeys();
+            }
+          });
+
+  // Edits, inserts, moves and loads can all change which media comes next.
+  connect(cueModel_, &QAbstractItemModel::modelReset, this, &MainWindow::scheduleLookaheadRefresh);
+  connect(cueModel_, &QAbstractItemModel::rowsInserted, this, &MainWindow::scheduleLookaheadRefresh);
+  connect(cueModel_, &QAbstractItemModel::rowsRemoved, this, &MainWindow::scheduleLookaheadRefresh);
+  connect(cueModel_, &QAbstractItemModel::rowsMoved, this, &MainWindow::scheduleLookaheadRefresh);
+  connect(cueModel_, &QAbstractItemModel::dataChanged, this, &MainWindow::scheduleLookaheadRefresh);
 
   refreshScreenChoices();
   refreshFilterPresetChoices();
@@ -599,6 +856,8 @@ void MainWindow::appendCueFromFile() {
   cue.autoFollow = autoFollowCheck_->isChecked();
   cue.followCueRow = followCueRowSpin_->value();
   cue.followDelayMs = followDelaySpin_->value();
+  cue.advanceTrigger = static_cast<AdvanceTrigger>(advanceTriggerCombo_->currentData().toInt());
+  cue.advanceLeadMs = advanceLeadSpin_->value();
   cue.autoStopMs = autoStopSpin_->value();
   cue.hotkey = hotkeyEdit_->text().trimmed();
   cue.timecodeTrigger = timecodeEdit_->text().trimmed();
@@ -607,6 +866,7 @@ void MainWindow::appendCueFromFile() {
   cue.dmxValue = dmxValueSpin_->value();
 
   cueModel_->addCue(cue);
+  mediaLibrary_->scan({cue.filePath});
 
   const int row = cueModel_->rowCount() - 1;
   cueTable_->selectRow(row);
@@ -648,6 +908,8 @@ void MainWindow::appendTestPatternCue() {
   cue.autoFollow = autoFollowCheck_->isChecked();
   cue.followCueRow = followCueRowSpin_->value();
   cue.followDelayMs = followDelaySpin_->value();
+  cue.advanceTrigger = static_cast<AdvanceTrigger>(advanceTriggerCombo_->currentData().toInt());
+  cue.advanceLeadMs = advanceLeadSpin_->value();
   cue.autoStopMs = autoStopSpin_->value();
   cue.hotkey = hotkeyEdit_->text().trimmed();
   cue.timecodeTrigger = timecodeEdit_->text().trimmed();
@@ -656,6 +918,7 @@ void MainWindow::appendTestPatternCue() {
   cue.dmxValue = dmxValueSpin_->value();
 
   cueModel_->addCue(cue);
+  mediaLibrary_->scan({cue.filePath});
   const int row = cueModel_->rowCount() - 1;
   cueTable_->selectRow(row);
   if (cue.preload) {
@@ -666,6 +929,12 @@ void MainWindow::appendTestPatternCue() {
 }
 
 void MainWindow::relinkMissingMedia() {
+  // Missing files come from the media index; the scan stats on a worker.
+  if (mediaLibrary_->pendingCount() > 0) {
+    showStatus(QString("Media scan still running (%1 file(s) left).").arg(mediaLibrary_->pendingCount()));
+    return;
+  }
+
   int missingCount = 0;
   int relinkedCount = 0;
   const QString startDir = currentProjectPath_.isEmpty() ? QDir::homePath() : QFileInfo(currentProjectPath_).absolutePath();
@@ -676,7 +945,7 @@ void MainWindow::relinkMissingMedia() {
       continue;
     }
 
-    if (QFileInfo::exists(cue.filePath)) {
+    if (!mediaLibrary_->isMissing(cue.filePath)) {
       continue;
     }
 
@@ -692,6 +961,7 @@ void MainWindow::relinkMissingMedia() {
     cue.isLiveInput = false;
     cue.liveInputUrl.clear();
     cueModel_->updateCue(row, cue);
+    mediaLibrary_->scan({cue.filePath});
     ++relinkedCount;
   }
 
@@ -815,21 +1085,9 @@ void MainWindow::openProject() {
   currentProjectPath_ = filePath;
   applyLoadedProject(project);
 
-  int missingCount = 0;
-  for (const Cue& cue : cueModel_->cues()) {
-    if (cue.filePath.isEmpty() || cue.filePath.contains("://")) {
-      continue;
-    }
-    if (!QFileInfo::exists(cue.filePath)) {
-      ++missingCount;
-    }
-  }
-
-  if (missingCount > 0) {
-    showStatus(QString("Loaded project: %1 (%2 missing media file(s), run Relink Missing)").arg(filePath).arg(missingCount));
-  } else {
-    showStatus(QString("Loaded project: %1").arg(filePath));
-  }
+  const int prewarmed = outputRouter_->prewarmForCues(cueModel_->cues());
+  const QString prewarmNote = prewarmed > 0 ? QString(", %1 player(s) prewarmed").arg(prewarmed) : QString();
+  showStatus(QString("Loaded project: %1%2, scanning media...").arg(filePath, prewarmNote));
 }
 
 void MainWindow::syncEditorsFromSelection() {
@@ -855,6 +1113,8 @@ void MainWindow::syncEditorsFromSelection() {
   QSignalBlocker blockAutoFollow(autoFollowCheck_);
   QSignalBlocker blockFollowRow(followCueRowSpin_);
   QSignalBlocker blockFollowDelay(followDelaySpin_);
+  QSignalBlocker blockAdvanceTrigger(advanceTriggerCombo_);
+  QSignalBlocker blockAdvanceLead(advanceLeadSpin_);
   QSignalBlocker blockAutoStop(autoStopSpin_);
   QSignalBlocker blockHotkey(hotkeyEdit_);
   QSignalBlocker blockTimecode(timecodeEdit_);
@@ -883,6 +1143,8 @@ void MainWindow::syncEditorsFromSelection() {
     autoFollowCheck_->setChecked(false);
     followCueRowSpin_->setValue(-1);
     followDelaySpin_->setValue(0);
+    advanceTriggerCombo_->setCurrentIndex(0);
+    advanceLeadSpin_->setValue(0);
     autoStopSpin_->setValue(0);
     hotkeyEdit_->setText({});
     timecodeEdit_->setText({});
@@ -933,6 +1195,9 @@ void MainWindow::syncEditorsFromSelection() {
   autoFollowCheck_->setChecked(cue.autoFollow);
   followCueRowSpin_->setValue(cue.followCueRow);
   followDelaySpin_->setValue(cue.followDelayMs);
+  const int advanceTriggerIndex = advanceTriggerCombo_->findData(static_cast<int>(cue.advanceTrigger));
+  advanceTriggerCombo_->setCurrentIndex(advanceTriggerIndex >= 0 ? advanceTriggerIndex : 0);
+  advanceLeadSpin_->setValue(cue.advanceLeadMs);
   autoStopSpin_->setValue(cue.autoStopMs);
   hotkeyEdit_->setText(cue.hotkey);
   timecodeEdit_->setText(cue.timecodeTrigger);
@@ -962,7 +1227,15 @@ void MainWindow::applyEditorsToSelection() {
   cue.isLiveInput = liveInputCheck_->isChecked();
   cue.liveInputUrl = liveInputUrlEdit_->text().trimmed();
   cue.filterPresetId = filterPresetCombo_->currentData().toString();
-  cue.videoFilter = cueFilterEdit_->text().trimmed();
+  // A chain mpv would refuse keeps the cue's previous filter rather than
+  // failing when the cue goes live.
+  QString filterError;
+  const QString videoFilter = cueFilterEdit_->text().trimmed();
+  if (outputRouter_->validateFilterChain(videoFilter, &filterError)) {
+    cue.videoFilter = videoFilter;
+  } else {
+    showStatus(QString("Cue filter rejected: %1").arg(filterError));
+  }
   cue.useTransitionOverride = cueTransitionOverrideCheck_->isChecked();
   cue.transitionStyle = static_cast<TransitionStyle>(cueTransitionCombo_->currentData().toInt());
   cue.transitionDurationMs = cueTransitionDurationSpin_->value();
@@ -973,6 +1246,8 @@ void MainWindow::applyEditorsToSelection() {
   cue.autoFollow = autoFollowCheck_->isChecked();
   cue.followCueRow = followCueRowSpin_->value();
   cue.followDelayMs = followDelaySpin_->value();
+  cue.advanceTrigger = static_cast<AdvanceTrigger>(advanceTriggerCombo_->currentData().toInt());
+  cue.advanceLeadMs = advanceLeadSpin_->value();
   cue.autoStopMs = autoStopSpin_->value();
   cue.hotkey = hotkeyEdit_->text().trimmed();
   cue.timecodeTrigger = timecodeEdit_->text().trimmed();
@@ -1063,6 +1338,15 @@ void MainWindow::syncCalibrationEditors() {
   QSignalBlocker blockMaskTop(maskTopSpin_);
   QSignalBlocker blockMaskRight(maskRightSpin_);
   QSignalBlocker blockMaskBottom(maskBottomSpin_);
+  QSignalBlocker blockCornerPin(cornerPinCheck_);
+  QSignalBlocker blockPinTopLeftX(pinTopLeftXSpin_);
+  QSignalBlocker blockPinTopLeftY(pinTopLeftYSpin_);
+  QSignalBlocker blockPinTopRightX(pinTopRightXSpin_);
+  QSignalBlocker blockPinTopRightY(pinTopRightYSpin_);
+  QSignalBlocker blockPinBottomLeftX(pinBottomLeftXSpin_);
+  QSignalBlocker blockPinBottomLeftY(pinBottomLeftYSpin_);
+  QSignalBlocker blockPinBottomRightX(pinBottomRightXSpin_);
+  QSignalBlocker blockPinBottomRightY(pinBottomRightYSpin_);
 
   const int screenIndex = calibrationScreenCombo_->currentData().toInt();
   const OutputCalibration calibration = outputRouter_->calibrationForScreen(screenIndex);
@@ -1075,6 +1359,15 @@ void MainWindow::syncCalibrationEditors() {
   maskTopSpin_->setValue(calibration.maskTopPx);
   maskRightSpin_->setValue(calibration.maskRightPx);
   maskBottomSpin_->setValue(calibration.maskBottomPx);
+  cornerPinCheck_->setChecked(calibration.cornerPinEnabled);
+  pinTopLeftXSpin_->setValue(calibration.cornerTopLeftX);
+  pinTopLeftYSpin_->setValue(calibration.cornerTopLeftY);
+  pinTopRightXSpin_->setValue(calibration.cornerTopRightX);
+  pinTopRightYSpin_->setValue(calibration.cornerTopRightY);
+  pinBottomLeftXSpin_->setValue(calibration.cornerBottomLeftX);
+  pinBottomLeftYSpin_->setValue(calibration.cornerBottomLeftY);
+  pinBottomRightXSpin_->setValue(calibration.cornerBottomRightX);
+  pinBottomRightYSpin_->setValue(calibration.cornerBottomRightY);
 
   updatingCalibration_ = false;
 }
@@ -1094,6 +1387,15 @@ void MainWindow::applyCalibrationToScreen() {
   calibration.maskTopPx = maskTopSpin_->value();
   calibration.maskRightPx = maskRightSpin_->value();
   calibration.maskBottomPx = maskBottomSpin_->value();
+  calibration.cornerPinEnabled = cornerPinCheck_->isChecked();
+  calibration.cornerTopLeftX = pinTopLeftXSpin_->value();
+  calibration.cornerTopLeftY = pinTopLeftYSpin_->value();
+  calibration.cornerTopRightX = pinTopRightXSpin_->value();
+  calibration.cornerTopRightY = pinTopRightYSpin_->value();
+  calibration.cornerBottomLeftX = pinBottomLeftXSpin_->value();
+  calibration.cornerBottomLeftY = pinBottomLeftYSpin_->value();
+  calibration.cornerBottomRightX = pinBottomRightXSpin_->value();
+  calibration.cornerBottomRightY = pinBottomRightYSpin_->value();
 
   outputRouter_->setOutputCalibration(screenIndex, calibration);
 }
@@ -1111,6 +1413,61 @@ void MainWindow::browseSlatePath() {
   showStatus("Updated fallback slate.");
 }
 
+void MainWindow::exportLatency() {
+  const QString filePath =
+      QFileDialog::getSaveFileName(this, "Export latency", "latency.csv", "CSV (*.csv);;All files (*)");
+  if (filePath.isEmpty()) {
+    return;
+  }
+
+  QFile file(filePath);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+    showStatus(QString("Failed to write latency report: %1").arg(file.errorString()));
+    return;
+  }
+  file.write(playbackController_->latencyMonitor()->toCsv().toUtf8());
+  showStatus(QString("Exported latency report: %1").arg(filePath));
+}
+
+void MainWindow::resetLatency() {
+  playbackController_->latencyMonitor()->reset();
+  refreshLatencyStats();
+  showStatus("Latency statistics reset.");
+}
+
+void MainWindow::setTracing(bool enabled) {
+  if (enabled) {
+    Trace::start();
+    showStatus("Tracing started.");
+  } else {
+    Trace::stop();
+    showStatus("Tracing stopped.");
+  }
+}
+
+void MainWindow::exportTrace() {
+  // The buffers are only read once every thread has stopped adding to them.
+  traceCheck_->setChecked(false);
+
+  const QString filePath =
+      QFileDialog::getSaveFileName(this, "Export trace", "trace.json", "Chrome trace (*.json);;All files (*)");
+  if (filePath.isEmpty()) {
+    return;
+  }
+
+  TraceStats stats;
+  QString error;
+  if (!Trace::writeChromeJson(filePath, &stats, &error)) {
+    showStatus(error);
+    return;
+  }
+  showStatus(QString("Exported %1 trace event(s) from %2 thread(s), %3 dropped: %4")
+                 .arg(stats.events)
+                 .arg(stats.threads)
+                 .arg(stats.dropped)
+                 .arg(filePath));
+}
+
 void MainWindow::restartOscServer() {
   config_.oscPort = oscPortSpin_->value();
   oscServer_->start(static_cast<quint16>(config_.oscPort));
@@ -1123,6 +1480,15 @@ void MainWindow::applyControlConfig() {
   config_.syphonEnabled = syphonEnableCheck_->isChecked();
   config_.deckLinkEnabled = deckLinkEnableCheck_->isChecked();
   config_.filterPresets = parseFilterPresets(filterPresetsEdit_->text());
+  for (auto it = config_.filterPresets.begin(); it != config_.filterPresets.end();) {
+    QString error;
+    if (outputRouter_->validateFilterChain(it.value(), &error)) {
+      ++it;
+      continue;
+    }
+    showStatus(QString("Filter preset '%1' rejected: %2").arg(it.key(), error));
+    it = config_.filterPresets.erase(it);
+  }
   config_.artnetEnabled = artnetEnableCheck_->isChecked();
   config_.artnetPort = artnetPortSpin_->value();
   config_.artnetUniverse = artnetUniverseSpin_->value();
@@ -1134,9 +1500,21 @@ void MainWindow::applyControlConfig() {
   config_.failoverPeerPort = failoverPeerPortSpin_->value();
   config_.failoverListenPort = failoverListenPortSpin_->value();
   config_.failoverSharedKey = failoverKeyEdit_->text().trimmed();
+  config_.renderBackend = static_cast<RenderBackend>(renderBackendCombo_->currentData().toInt());
+  config_.prefetchBudgetMb = prefetchBudgetSpin_->value();
+  config_.prefetchHeadMb = prefetchHeadSpin_->value();
+  config_.timecodeFreewheelMs = timecodeFreewheelSpin_->value();
+  config_.standbyLookahead = standbyLookaheadSpin_->value();
+  config_.standbyMaxDecoders = standbyDecodersSpin_->value();
+  config_.standbyBudgetMb = standbyBudgetSpin_->value();
 
   refreshFilterPresetChoices();
   outputRouter_->setFilterPresets(config_.filterPresets);
+  outputRouter_->setRenderBackend(config_.renderBackend);
+  mediaPrefetcher_->setHeadBytes(static_cast<qint64>(config_.prefetchHeadMb) * 1024 * 1024);
+  mediaPrefetcher_->setBudgetBytes(static_cast<qint64>(config_.prefetchBudgetMb) * 1024 * 1024);
+  timecodeClock_->setFreewheelMs(config_.timecodeFreewheelMs);
+  refreshStandbys();
 
   if (config_.midiEnabled) {
     if (!midiService_->start()) {
@@ -1202,10 +1580,10 @@ void MainWindow::applyControlConfig() {
   }
 }
 
-void MainWindow::handleExternalPlayRow(int row) {
+void MainWindow::handleExternalPlayRow(int row, const TriggerStamp& stamp) {
   const int resolvedRow = resolveCueRowFromIndex(row);
   selectRowIfValid(resolvedRow);
-  playbackController_->playCueAtRow(resolvedRow, selectedTransitionStyle(), selectedTransitionDuration());
+  playbackController_->playCueAtRow(resolvedRow, selectedTransitionStyle(), selectedTransitionDuration(), stamp);
 }
 
 void MainWindow::handleExternalPreviewRow(int row) {
@@ -1220,16 +1598,23 @@ void MainWindow::handleExternalPreloadRow(int row) {
   playbackController_->preloadCueAtRow(resolvedRow);
 }
 
-void MainWindow::handleExternalMidiNote(int note) {
-  const int resolvedRow = resolveCueRowFromMidiNote(note);
+void MainWindow::handleExternalMidiNote(int note, const TriggerStamp& stamp) {
+  const int resolvedRow = cueModel_->rowForMidiNote(note);
+  if (resolvedRow < 0) {
+    return;
+  }
   selectRowIfValid(resolvedRow);
-  playbackController_->playCueAtRow(resolvedRow, selectedTransitionStyle(), selectedTransitionDuration());
+  playbackController_->playCueAtRow(resolvedRow, selectedTransitionStyle(), selectedTransitionDuration(), stamp);
 }
 
-void MainWindow::handleExternalDmx(int channel, int value) {
-  const int resolvedRow = resolveCueRowFromDmx(channel, value);
+void MainWindow::handleExternalDmx(int channel, int value, const TriggerStamp& stamp) {
+  // Most channel changes map to no cue; skip them without an error.
+  const int resolvedRow = cueModel_->rowForDmx(channel, value);
+  if (resolvedRow < 0) {
+    return;
+  }
   selectRowIfValid(resolvedRow);
-  playbackController_->playCueAtRow(resolvedRow, selectedTransitionStyle(), selectedTransitionDuration());
+  playbackController_->playCueAtRow(resolvedRow, selectedTransitionStyle(), selectedTransitionDuration(), stamp);
 }
 
 void MainWindow::handleExternalOverlayText(const QString& text) {
@@ -1249,10 +1634,45 @@ void MainWindow::handleExternalOverlayText(const QString& text) {
   failoverSync_->publishOverlayText(trimmed);
 }
 
-void MainWindow::handleExternalTake() { playbackController_->takePreviewCue(selectedTransitionStyle(), selectedTransitionDuration()); }
+void MainWindow::handleExternalTake(const TriggerStamp& stamp) {
+  playbackController_->takePreviewCue(selectedTransitionStyle(), selectedTransitionDuration(), stamp);
+}
+
+void MainWindow::handleExternalCueIdGo(const QString& cueId, const TriggerStamp& stamp) {
+  selectRowIfValid(cueModel_->rowForCueId(cueId));
+  playbackController_->playCueById(cueId, selectedTransitionStyle(), selectedTransitionDuration(), false, stamp);
+}
+
+void MainWindow::handleExternalGroupGo(const QVector<int>& rows, const QStringList& cueIds, const TriggerStamp& stamp) {
+  QVector<int> resolvedRows = rows;
+  for (const QString& cueId : cueIds) {
+    const int row = cueModel_->rowForCueId(cueId);
+    if (row < 0) {
+      showStatus(QString("No cue with id '%1'.").arg(cueId));
+      continue;
+    }
+    resolvedRows.push_back(row);
+  }
+  if (!resolvedRows.isEmpty()) {
+    selectRowIfValid(resolvedRows.first());
+  }
+  playbackController_->playCueRowsTogether(resolvedRows, selectedTransitionStyle(), selectedTransitionDuration(),
+                                           stamp);
+}
+
+void MainWindow::handleExternalCueIdPreload(const QString& cueId) {
+  const int row = cueModel_->rowForCueId(cueId);
+  if (row < 0) {
+    showStatus(QString("No cue with id '%1'.").arg(cueId));
+    return;
+  }
+  selectRowIfValid(row);
+  playbackController_->preloadCueAtRow(row);
+}
 
-void MainWindow::handleTimecode(const QString& timecode) {
-  playbackController_->triggerByTimecode(timecode.trimmed(), selectedTransitionStyle(), selectedTransitionDuration());
+void MainWindow::handleTimecode(const Timecode& timecode) {
+  playbackController_->triggerByTimecode(timecode, selectedTransitionStyle(), selectedTransitionDuration(),
+                                         TriggerStamp::now(TriggerSource::Timecode));
 }
 
 void MainWindow::handleRemoteCueLive(const QString& cueId) {
@@ -1329,10 +1749,13 @@ void MainWindow::rebuildCueHotkeys() {
   }
   cueHotkeys_.clear();
 
-  const QVector<Cue> cues = cueModel_->cues();
-  for (const Cue& cue : cues) {
+  const QVector<Cue>& cues = cueModel_->cues();
+  for (int row = 0; row < cues.size(); ++row) {
+    const Cue& cue = cues.at(row);
     const QString key = cue.hotkey.trimmed();
-    if (cue.id.isEmpty() || key.isEmpty()) {
+    // A shared hotkey goes to its lowest row; a second shortcut on the same
+    // sequence would only make Qt report it as ambiguous.
+    if (cue.id.isEmpty() || key.isEmpty() || cueModel_->rowForHotkey(key) != row) {
       continue;
     }
 
@@ -1344,7 +1767,10 @@ void MainWindow::rebuildCueHotkeys() {
     auto* shortcut = new QShortcut(sequence, this);
     shortcut->setContext(Qt::ApplicationShortcut);
     connect(shortcut, &QShortcut::activated, this,
-            [this, cueId = cue.id]() { playbackController_->playCueById(cueId, selectedTransitionStyle(), selectedTransitionDuration(), false); });
+            [this, cueId = cue.id]() {
+              playbackController_->playCueById(cueId, selectedTransitionStyle(), selectedTransitionDuration(), false,
+                                               TriggerStamp::now(TriggerSource::Hotkey));
+            });
 
     cueHotkeys_.insert(cue.id, shortcut);
   }
@@ -1386,36 +1812,6 @@ int MainWindow::resolveCueRowFromIndex(int row) const {
   return -1;
 }
 
-int MainWindow::resolveCueRowFromMidiNote(int note) const {
-  const QVector<Cue> cues = cueModel_->cues();
-  for (int i = 0; i < cues.size(); ++i) {
-    if (cues.at(i).midiNote == note) {
-      return i;
-    }
-  }
-
-  return -1;
-}
-
-int MainWindow::resolveCueRowFromDmx(int channel, int value) const {
-  if (channel < 0) {
-    return -1;
-  }
-
-  const QVector<Cue> cues = cueModel_->cues();
-  for (int i = 0; i < cues.size(); ++i) {
-    const Cue& cue = cues.at(i);
-    if (cue.dmxChannel < 0) {
-      continue;
-    }
-    if (cue.dmxChannel == channel && value >= cue.dmxValue) {
-      return i;
-    }
-  }
-
-  return -1;
-}
-
 void MainWindow::selectRowIfValid(int row) {
   if (!cueModel_->isValidRow(row)) {
     return;
@@ -1474,7 +1870,19 @@ TransitionStyle MainWindow::selectedTransitionStyle() const {
 int MainWindow::selectedTransitionDuration() const { return transitionDurationSpin_->value(); }
 
 void MainWindow::applyLoadedProject(const ProjectData& project) {
+  // Entries still in the index show up at once; the scan only re-stats them
+  // and probes whatever changed or is new.
+  QStringList mediaPaths;
+  mediaPaths.reserve(project.cues.size());
+  for (const Cue& cue : project.cues) {
+    if (mediaLibrary_->isKnown(cue.filePath)) {
+      cueModel_->setMediaInfo(mediaLibrary_->info(cue.filePath));
+    }
+    mediaPaths.push_back(cue.filePath);
+  }
+
   cueModel_->setCues(project.cues);
+  mediaLibrary_->scan(mediaPaths);
 
   outputRouter_->clearCalibrations();
   for (auto it = project.calibrations.constBegin(); it != project.calibrations.constEnd(); ++it) {
@@ -1504,6 +1912,13 @@ void MainWindow::applyLoadedProject(const ProjectData& project) {
     QSignalBlocker blockFailoverPeerPort(failoverPeerPortSpin_);
     QSignalBlocker blockFailoverListenPort(failoverListenPortSpin_);
     QSignalBlocker blockFailoverKey(failoverKeyEdit_);
+    QSignalBlocker blockRenderBackend(renderBackendCombo_);
+    QSignalBlocker blockPrefetchBudget(prefetchBudgetSpin_);
+    QSignalBlocker blockPrefetchHead(prefetchHeadSpin_);
+    QSignalBlocker blockTimecodeFreewheel(timecodeFreewheelSpin_);
+    QSignalBlocker blockStandbyLookahead(standbyLookaheadSpin_);
+    QSignalBlocker blockStandbyDecoders(standbyDecodersSpin_);
+    QSignalBlocker blockStandbyBudget(standbyBudgetSpin_);
 
     const int styleIndex = transitionCombo_->findData(static_cast<int>(config_.transitionStyle));
     if (styleIndex >= 0) {
@@ -1528,6 +1943,13 @@ void MainWindow::applyLoadedProject(const ProjectData& project) {
     failoverPeerPortSpin_->setValue(config_.failoverPeerPort);
     failoverListenPortSpin_->setValue(config_.failoverListenPort);
     failoverKeyEdit_->setText(config_.failoverSharedKey);
+    renderBackendCombo_->setCurrentIndex(renderBackendCombo_->findData(static_cast<int>(config_.renderBackend)));
+    prefetchBudgetSpin_->setValue(config_.prefetchBudgetMb);
+    prefetchHeadSpin_->setValue(config_.prefetchHeadMb);
+    timecodeFreewheelSpin_->setValue(config_.timecodeFreewheelMs);
+    standbyLookaheadSpin_->setValue(config_.standbyLookahead);
+    standbyDecodersSpin_->setValue(config_.standbyMaxDecoders);
+    standbyBudgetSpin_->setValue(config_.standbyBudgetMb);
   }
 
   slatePathEdit_->setText(config_.fallbackSlatePath);
@@ -1546,13 +1968,18 @@ void MainWindow::connectCoreShortcuts() {
   connect(previewShortcut, &QShortcut::activated, this, &MainWindow::previewSelectedCue);
 
   auto* takeShortcut1 = new QShortcut(QKeySequence(Qt::Key_Return), this);
-  connect(takeShortcut1, &QShortcut::activated, this, &MainWindow::takePreviewCue);
+  connect(takeShortcut1, &QShortcut::activated, this,
+          [this]() { handleExternalTake(TriggerStamp::now(TriggerSource::Hotkey)); });
 
   auto* takeShortcut2 = new QShortcut(QKeySequence(Qt::Key_Enter), this);
-  connect(takeShortcut2, &QShortcut::activated, this, &MainWindow::takePreviewCue);
+  connect(takeShortcut2, &QShortcut::activated, this,
+          [this]() { handleExternalTake(TriggerStamp::now(TriggerSource::Hotkey)); });
 
   auto* liveShortcut = new QShortcut(QKeySequence(Qt::Key_G), this);
-  connect(liveShortcut, &QShortcut::activated, this, &MainWindow::playSelectedCue);
+  connect(liveShortcut, &QShortcut::activated, this, [this]() {
+    playbackController_->playCueAtRow(selectedRow(), selectedTransitionStyle(), selectedTransitionDuration(),
+                                      TriggerStamp::now(TriggerSource::Hotkey));
+  });
 
   auto* preloadShortcut = new QShortcut(QKeySequence(Qt::CTRL | Qt::Key_L), this);
   connect(preloadShortcut, &QShortcut::activated, this, &MainWindow::preloadSelectedCue);
@@ -1583,6 +2010,89 @@ void MainWindow::connectCoreShortcuts() {
     connect(previewRowShortcut, &QShortcut::activated, this, [this, i]() { handleExternalPreviewRow(i); });
 
     auto* liveRowShortcut = new QShortcut(QKeySequence(QString("Shift+%1").arg(i + 1)), this);
-    connect(liveRowShortcut, &QShortcut::activated, this, [this, i]() { handleExternalPlayRow(i); });
+    connect(liveRowShortcut, &QShortcut::activated, this,
+            [this, i]() { handleExternalPlayRow(i, TriggerStamp::now(TriggerSource::Hotkey)); });
+  }
+}
+
+void MainWindow::refreshLookahead() {
+  refreshStandbys();
+
+  const int liveRow = cueModel_->rowForCueId(lastLiveCueId_);
+  QStringList paths;
+  for (int row : playbackController_->upcomingRows(liveRow, selectedRow(), kPrefetchLookahead)) {
+    const Cue& cue = cueModel_->cueAt(row);
+    if (!cue.isLiveInput) {
+      paths.push_back(cue.filePath);
+    }
   }
+  mediaPrefetcher_->prefetch(paths);
+}
+
+void MainWindow::scheduleLookaheadRefresh() {
+  if (lookaheadRefreshQueued_) {
+    return;
+  }
+  lookaheadRefreshQueued_ = true;
+  QMetaObject::invokeMethod(
+      this,
+      [this]() {
+        lookaheadRefreshQueued_ = false;
+        refreshLookahead();
+      },
+      Qt::QueuedConnection);
+}
+
+void MainWindow::refreshStandbys() {
+  QVector<PreloadCandidate> candidates;
+  if (config_.standbyLookahead > 0) {
+    const int liveRow = cueModel_->rowForCueId(lastLiveCueId_);
+    for (int row : playbackController_->upcomingRows(liveRow, selectedRow(), config_.standbyLookahead)) {
+      PreloadCandidate candidate;
+      candidate.cue = cueModel_->cueAt(row);
+      candidate.estimatedBytes = PreloadPlanner::estimateBytes(cueModel_->mediaInfo(candidate.cue.filePath));
+      candidates.push_back(candidate);
+    }
+  }
+
+  PreloadBudget budget;
+  budget.maxDecoders = config_.standbyMaxDecoders;
+  budget.maxBytes = static_cast<qint64>(config_.standbyBudgetMb) * 1024 * 1024;
+  const PreloadPlan plan = outputRouter_->syncStandbys(candidates, budget);
+
+  constexpr double kMb = 1024.0 * 1024.0;
+  standbyStatsLabel_->setText(QString("%1 cue(s) in %2 player(s), ~%3 MB")
+                                  .arg(plan.plannedCues)
+                                  .arg(plan.slots.size())
+                                  .arg(plan.plannedBytes / kMb, 0, 'f', 0));
+  standbyStatsLabel_->setToolTip(QString("%1 skipped: layer standby already taken\n%2 skipped: over budget")
+                                     .arg(plan.layerConflicts)
+                                     .arg(plan.overBudget));
+}
+
+void MainWindow::refreshLatencyStats() {
+  const QVector<LatencySummary> summaries = playbackController_->latencyMonitor()->summaries();
+  if (summaries.isEmpty()) {
+    latencyStatsLabel_->setText("-");
+    latencyStatsLabel_->setToolTip({});
+    return;
+  }
+
+  QStringList brief;
+  QStringList lines;
+  for (const LatencySummary& summary : summaries) {
+    const QString source = triggerSourceToString(summary.source);
+    brief.push_back(QString("%1 p95 %2 ms").arg(source).arg(summary.p95Ms, 0, 'f', 1));
+    lines.push_back(QString("%1: %2 GO(s), p50 %3 / p95 %4 / p99 %5 / max %6 ms")
+                        .arg(source)
+                        .arg(summary.count)
+                        .arg(summary.p50Ms, 0, 'f', 1)
+                        .arg(summary.p95Ms, 0, 'f', 1)
+                        .arg(summary.p99Ms, 0, 'f', 1)
+                        .arg(summary.maxMs, 0, 'f', 1));
+  }
+  // A cold player start is what an unwarmed layer adds to its first GO.
+  lines.push_back(QString("Players: %1").arg(outputRouter_->describePlayerPools()));
+  latencyStatsLabel_->setText(brief.join(", "));
+  latencyStatsLabel_->setToolTip(lines.join('\n'));
 }
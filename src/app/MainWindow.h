@@ -3,20 +3,28 @@
 #include <QMainWindow>
 #include <QMap>
 #include <QString>
+#include <QStringList>
+#include <QVector>
 
 #include "core/AppConfig.h"
+#include "core/Timecode.h"
+#include "core/TriggerStamp.h"
 
 class CueListModel;
 class DisplayManager;
 class ArtnetInputService;
 class FailoverSyncService;
+class MediaLibrary;
+class MediaPrefetcher;
 class DeckLinkBridge;
 class MidiInputService;
 class NdiBridge;
+class OscFeedbackPublisher;
 class OscServer;
 class OutputRouter;
 class PlaybackController;
 class SyphonBridge;
+class TimecodeChaseClock;
 class QCheckBox;
 class QComboBox;
 class QLineEdit;
@@ -64,19 +72,27 @@ class MainWindow : public QMainWindow {
   void restartOscServer();
   void applyControlConfig();
 
-  void handleExternalPlayRow(int row);
+  void handleExternalPlayRow(int row, const TriggerStamp& stamp);
   void handleExternalPreviewRow(int row);
   void handleExternalPreloadRow(int row);
-  void handleExternalMidiNote(int note);
-  void handleExternalDmx(int channel, int value);
+  void handleExternalMidiNote(int note, const TriggerStamp& stamp);
+  void handleExternalDmx(int channel, int value, const TriggerStamp& stamp);
   void handleExternalOverlayText(const QString& text);
-  void handleExternalTake();
-  void handleTimecode(const QString& timecode);
+  void handleExternalTake(const TriggerStamp& stamp);
+  void handleExternalCueIdGo(const QString& cueId, const TriggerStamp& stamp);
+  void handleExternalGroupGo(const QVector<int>& rows, const QStringList& cueIds, const TriggerStamp& stamp);
+  void handleExternalCueIdPreload(const QString& cueId);
+  void handleTimecode(const Timecode& timecode);
   void handleRemoteCueLive(const QString& cueId);
   void handleRemoteStopAll();
   void handleRemoteOverlayText(const QString& text);
   void forwardCueToBackup(const Cue& cue);
 
+  void exportLatency();
+  void resetLatency();
+  void setTracing(bool enabled);
+  void exportTrace();
+
   void rebuildCueHotkeys();
   void refreshFilterPresetChoices();
   void showOutputs();
@@ -88,23 +104,33 @@ class MainWindow : public QMainWindow {
  private:
   int selectedRow() const;
   int resolveCueRowFromIndex(int row) const;
-  int resolveCueRowFromMidiNote(int note) const;
-  int resolveCueRowFromDmx(int channel, int value) const;
   void selectRowIfValid(int row);
   QString ensureColorBarsPatternPath() const;
   TransitionStyle selectedTransitionStyle() const;
   int selectedTransitionDuration() const;
   void applyLoadedProject(const ProjectData& project);
   void connectCoreShortcuts();
+  // Prefetches upcoming media and replans the standby players.
+  void refreshLookahead();
+  // Coalesces the model's change signals into one refresh.
+  void scheduleLookaheadRefresh();
+  void refreshStandbys();
+  void refreshLatencyStats();
 
   CueListModel* cueModel_;
   DisplayManager* displayManager_;
   OutputRouter* outputRouter_;
   PlaybackController* playbackController_;
+  MediaLibrary* mediaLibrary_;
+  MediaPrefetcher* mediaPrefetcher_;
+  // Created first so it is deleted first: its thread calls straight into
+  // the server and must be stopped before the server goes.
+  OscFeedbackPublisher* oscFeedback_;
   OscServer* oscServer_;
   ArtnetInputService* artnetService_;
   FailoverSyncService* failoverSync_;
   MidiInputService* midiService_;
+  TimecodeChaseClock* timecodeClock_;
   NdiBridge* ndiBridge_;
   SyphonBridge* syphonBridge_;
   DeckLinkBridge* deckLinkBridge_;
@@ -131,6 +157,8 @@ class MainWindow : public QMainWindow {
   QCheckBox* playlistAdvanceCheck_;
   QCheckBox* playlistLoopCheck_;
   QSpinBox* playlistDelaySpin_;
+  QComboBox* advanceTriggerCombo_;
+  QSpinBox* advanceLeadSpin_;
   QSpinBox* autoStopSpin_;
   QCheckBox* autoFollowCheck_;
   QSpinBox* followCueRowSpin_;
@@ -148,6 +176,15 @@ class MainWindow : public QMainWindow {
   QSpinBox* maskTopSpin_;
   QSpinBox* maskRightSpin_;
   QSpinBox* maskBottomSpin_;
+  QCheckBox* cornerPinCheck_;
+  QSpinBox* pinTopLeftXSpin_;
+  QSpinBox* pinTopLeftYSpin_;
+  QSpinBox* pinTopRightXSpin_;
+  QSpinBox* pinTopRightYSpin_;
+  QSpinBox* pinBottomLeftXSpin_;
+  QSpinBox* pinBottomLeftYSpin_;
+  QSpinBox* pinBottomRightXSpin_;
+  QSpinBox* pinBottomRightYSpin_;
   QLineEdit* slatePathEdit_;
 
   QSpinBox* oscPortSpin_;
@@ -168,15 +205,29 @@ class MainWindow : public QMainWindow {
   QSpinBox* failoverPeerPortSpin_;
   QSpinBox* failoverListenPortSpin_;
   QLineEdit* failoverKeyEdit_;
+  QComboBox* renderBackendCombo_;
+  QSpinBox* prefetchBudgetSpin_;
+  QSpinBox* prefetchHeadSpin_;
+  QLabel* prefetchStatsLabel_;
+  QSpinBox* timecodeFreewheelSpin_;
+  QSpinBox* standbyLookaheadSpin_;
+  QSpinBox* standbyDecodersSpin_;
+  QSpinBox* standbyBudgetSpin_;
+  QLabel* standbyStatsLabel_;
+  QLabel* latencyStatsLabel_;
+  QCheckBox* traceCheck_;
+  QLabel* scheduledLabel_;
   QLabel* statusLabel_;
   QNetworkAccessManager* backupNetwork_;
 
   bool updatingEditors_ = false;
   bool updatingCalibration_ = false;
+  bool lookaheadRefreshQueued_ = false;
   bool suppressFailoverCuePublish_ = false;
   bool suppressFailoverStopPublish_ = false;
   bool suppressFailoverOverlayPublish_ = false;
   QString currentProjectPath_;
+  QString lastLiveCueId_;
   AppConfig config_;
   QMap<QString, QShortcut*> cueHotkeys_;
 };
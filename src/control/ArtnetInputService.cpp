@@ -5,6 +5,8 @@
 #include <QUdpSocket>
 #include <QtGlobal>
 
+#include "core/Trace.h"
+
 ArtnetInputService::ArtnetInputService(QObject* parent) : QObject(parent), socket_(new QUdpSocket(this)) {
   connect(socket_, &QUdpSocket::readyRead, this, &ArtnetInputService::readPendingDatagrams);
 }
@@ -54,6 +56,8 @@ void ArtnetInputService::readPendingDatagrams() {
     QByteArray datagram;
     datagram.resize(static_cast<int>(socket_->pendingDatagramSize()));
     socket_->readDatagram(datagram.data(), datagram.size());
+    const TriggerStamp stamp = TriggerStamp::now(TriggerSource::Dmx);
+    const TraceScope trace("control", "artnetDatagram");
 
     int packetUniverse = -1;
     QByteArray levels;
@@ -79,7 +83,7 @@ void ArtnetInputService::readPendingDatagrams() {
       }
 
       lastLevels_[channel] = static_cast<char>(level);
-      emit dmxValueReceived(channel + 1, static_cast<int>(level));
+      emit dmxValueReceived(channel + 1, static_cast<int>(level), stamp);
     }
   }
 }
@@ -4,6 +4,8 @@
 #include <QObject>
 #include <QString>
 
+#include "core/TriggerStamp.h"
+
 class QUdpSocket;
 
 class ArtnetInputService : public QObject {
@@ -19,7 +21,7 @@ class ArtnetInputService : public QObject {
   int universe() const;
 
  signals:
-  void dmxValueReceived(int channel, int value);
+  void dmxValueReceived(int channel, int value, const TriggerStamp& stamp);
   void statusMessage(const QString& message);
 
  private slots:
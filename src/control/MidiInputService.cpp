@@ -2,10 +2,39 @@
 
 #include <QMetaObject>
 
+#include <algorithm>
+#include <array>
+
 #ifdef HAVE_RTMIDI
 #include <RtMidi.h>
 #endif
 
+#include "core/Trace.h"
+
+#ifdef HAVE_RTMIDI
+namespace {
+
+// The top bits of the MTC hour byte carry the rate: 24, 25, 29.97
+// drop-frame, 30.
+Timecode mtcTimecode(int hourByte, int minute, int second, int frame) {
+  static constexpr int kRateFps[4] = {24, 25, 30, 30};
+  const int rateCode = (hourByte >> 5) & 0x3;
+  TimecodeParts parts;
+  parts.hour = hourByte & 0x1F;
+  parts.minute = minute;
+  parts.second = second;
+  parts.frame = frame;
+  return Timecode::fromParts(parts, kRateFps[rateCode], rateCode == 2);
+}
+
+Timecode advanceFrames(const Timecode& timecode, int frames) {
+  return Timecode::fromFrames((timecode.frames() + frames) % timecode.framesPerDay(), timecode.fps(),
+                              timecode.dropFrame());
+}
+
+}  // namespace
+#endif
+
 MidiInputService::MidiInputService(QObject* parent) : QObject(parent) {}
 
 MidiInputService::~MidiInputService() { stop(); }
@@ -67,45 +96,96 @@ void MidiInputService::midiCallback(double, std::vector<unsigned char>* message,
     return;
   }
 
+  // Stamped here rather than in handleMessage so the queued hop to the GUI
+  // thread counts towards the latency.
+  const qint64 ingressNs = monotonicNowNs();
+  Trace::instant("control", "midiCallback");
+
+  // Channel and quarter-frame messages are at most three bytes; carry them by
+  // value instead of copying the vector onto the heap.
+  if (message->size() <= 3) {
+    std::array<unsigned char, 3> bytes = {0, 0, 0};
+    std::copy(message->begin(), message->end(), bytes.begin());
+    const std::size_t size = message->size();
+    QMetaObject::invokeMethod(
+        self, [self, bytes, size, ingressNs]() { self->handleMessage(bytes.data(), size, ingressNs); },
+        Qt::QueuedConnection);
+    return;
+  }
+
   const std::vector<unsigned char> copy = *message;
-  QMetaObject::invokeMethod(self, [self, copy]() { self->handleMessage(copy); }, Qt::QueuedConnection);
+  QMetaObject::invokeMethod(
+      self, [self, copy, ingressNs]() { self->handleMessage(copy.data(), copy.size(), ingressNs); },
+      Qt::QueuedConnection);
 }
 
-void MidiInputService::handleMessage(const std::vector<unsigned char>& message) {
-  if (message.empty()) {
+void MidiInputService::handleMessage(const unsigned char* message, std::size_t size, qint64 ingressNs) {
+  if (size == 0) {
     return;
   }
 
+  const TraceScope trace("control", "midiMessage");
   const unsigned char status = message[0];
 
   // Note on: emit the incoming MIDI note number for cue-note matching in the UI layer.
-  if ((status & 0xF0) == 0x90 && message.size() >= 3) {
+  if ((status & 0xF0) == 0x90 && size >= 3) {
     const int note = static_cast<int>(message[1]);
     const int velocity = static_cast<int>(message[2]);
     if (velocity > 0) {
-      emit cueNoteRequested(note);
+      emit cueNoteRequested(note, TriggerStamp{TriggerSource::Midi, ingressNs});
+    }
+    return;
+  }
+
+  // MTC full-frame SysEx: F0 7F <device> 01 01 hh mm ss ff F7, sent on locate.
+  if (status == 0xF0 && size >= 10 && message[1] == 0x7F && message[3] == 0x01 && message[4] == 0x01) {
+    mtcLast_ = {};
+    mtcInOrder_ = false;
+    const Timecode timecode = mtcTimecode(message[5], message[6], message[7], message[8]);
+    if (timecode.isValid()) {
+      emit timecodeLocated(timecode);
     }
     return;
   }
 
   // MTC quarter frame message.
-  if (status == 0xF1 && message.size() >= 2) {
+  if (status == 0xF1 && size >= 2) {
     const int data = static_cast<int>(message[1]);
     const int type = (data >> 4) & 0x07;
     const int value = data & 0x0F;
+
+    // Pieces arrive 0..7 while rolling forward. Anything else (a dropped
+    // byte, reverse play) breaks the chain until the next piece 0.
+    if (type != mtcNextPiece_) {
+      mtcLast_ = {};
+      mtcInOrder_ = false;
+    }
+    if (type == 0) {
+      mtcInOrder_ = true;
+    }
+    mtcNextPiece_ = (type + 1) % 8;
     mtcNibbles_[type] = value;
+    if (!mtcInOrder_) {
+      return;
+    }
+
+    // A sequence carries the frame in which its piece 0 was sent and spans
+    // two frames, so pieces 0 and 4 of the next one open frames +2 and +3.
+    if (mtcLast_.isValid() && (type == 0 || type == 4)) {
+      emit timecodeReceived(advanceFrames(mtcLast_, type == 0 ? 2 : 3), 0.0);
+    }
 
     if (type == 7) {
       const int frame = mtcNibbles_[0] | ((mtcNibbles_[1] & 0x1) << 4);
       const int second = mtcNibbles_[2] | (mtcNibbles_[3] << 4);
       const int minute = mtcNibbles_[4] | (mtcNibbles_[5] << 4);
-      const int hour = mtcNibbles_[6] | ((mtcNibbles_[7] & 0x1) << 4);
+      const int hourByte = mtcNibbles_[6] | (mtcNibbles_[7] << 4);
 
-      emit timecodeReceived(QString("%1:%2:%3:%4")
-                                .arg(hour, 2, 10, QChar('0'))
-                                .arg(minute, 2, 10, QChar('0'))
-                                .arg(second, 2, 10, QChar('0'))
-                                .arg(frame, 2, 10, QChar('0')));
+      mtcLast_ = mtcTimecode(hourByte, minute, second, frame);
+      if (mtcLast_.isValid()) {
+        // Piece 7 lands three quarters into the second frame of the sequence.
+        emit timecodeReceived(mtcLast_, 1.75);
+      }
     }
   }
 }
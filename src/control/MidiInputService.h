@@ -3,8 +3,12 @@
 #include <QObject>
 #include <QString>
 
+#include <cstddef>
 #include <vector>
 
+#include "core/Timecode.h"
+#include "core/TriggerStamp.h"
+
 #ifdef HAVE_RTMIDI
 #include <memory>
 
@@ -23,17 +27,24 @@ class MidiInputService : public QObject {
   bool isAvailable() const;
 
  signals:
-  void cueNoteRequested(int note);
-  void timecodeReceived(const QString& timecode);
+  void cueNoteRequested(int note, const TriggerStamp& stamp);
+  // Running MTC: the source is elapsedFrames past the start of timecode.
+  void timecodeReceived(const Timecode& timecode, double elapsedFrames);
+  // MTC full-frame locate.
+  void timecodeLocated(const Timecode& timecode);
   void statusMessage(const QString& message);
 
  private:
 #ifdef HAVE_RTMIDI
   static void midiCallback(double timestamp, std::vector<unsigned char>* message, void* userData);
-  void handleMessage(const std::vector<unsigned char>& message);
+  // ingressNs is when the RtMidi callback saw the message.
+  void handleMessage(const unsigned char* message, std::size_t size, qint64 ingressNs);
 
   std::unique_ptr<RtMidiIn> midiIn_;
   int mtcNibbles_[8] = {0};
+  int mtcNextPiece_ = 0;
+  bool mtcInOrder_ = false;
+  Timecode mtcLast_;
 #endif
 
   bool running_ = false;
@@ -0,0 +1,216 @@
+#include "control/OscAddressSpace.h"
+
+#include <algorithm>
+
+namespace {
+
+bool isPlaceholder(std::string_view segment) {
+  return segment.size() > 2 && segment.front() == '<' && segment.back() == '>';
+}
+
+// One [...] set against c; the set text excludes the brackets.
+bool matchSet(std::string_view set, char c) {
+  const bool negate = !set.empty() && set.front() == '!';
+  if (negate) {
+    set.remove_prefix(1);
+  }
+
+  bool found = false;
+  for (std::size_t i = 0; i < set.size() && !found; ++i) {
+    // A '-' that starts or ends the set is literal.
+    if (i + 2 < set.size() && set[i + 1] == '-') {
+      found = set[i] <= c && c <= set[i + 2];
+      i += 2;
+    } else {
+      found = set[i] == c;
+    }
+  }
+  return found != negate;
+}
+
+}  // namespace
+
+bool OscAddressSpace::addRoute(std::string_view route, int id) {
+  if (id < 0 || route.size() < 2 || route.front() != '/') {
+    return false;
+  }
+
+  int nodeIndex = 0;
+  int depth = 0;
+  int placeholders = 0;
+  std::string_view rest = route.substr(1);
+  while (!rest.empty()) {
+    const std::size_t slash = rest.find('/');
+    const std::string_view segment = rest.substr(0, slash);
+    rest = slash == std::string_view::npos ? std::string_view() : rest.substr(slash + 1);
+    if (segment.empty() || ++depth > kMaxDepth) {
+      return false;
+    }
+
+    if (isPlaceholder(segment)) {
+      if (++placeholders > OscRouteMatch::kMaxCaptures) {
+        return false;
+      }
+      if (nodes_[static_cast<std::size_t>(nodeIndex)].placeholderChild < 0) {
+        nodes_.emplace_back();
+        nodes_[static_cast<std::size_t>(nodeIndex)].placeholderChild = static_cast<int>(nodes_.size()) - 1;
+      }
+      nodeIndex = nodes_[static_cast<std::size_t>(nodeIndex)].placeholderChild;
+      continue;
+    }
+
+    if (isPattern(segment)) {
+      return false;
+    }
+    int child = literalChild(nodes_[static_cast<std::size_t>(nodeIndex)], segment);
+    if (child < 0) {
+      Node node;
+      node.segment = std::string(segment);
+      nodes_.push_back(std::move(node));
+      child = static_cast<int>(nodes_.size()) - 1;
+
+      std::vector<int>& children = nodes_[static_cast<std::size_t>(nodeIndex)].children;
+      const auto position =
+          std::lower_bound(children.begin(), children.end(), segment, [this](int index, std::string_view key) {
+            return nodes_[static_cast<std::size_t>(index)].segment < key;
+          });
+      children.insert(position, child);
+    }
+    nodeIndex = child;
+  }
+
+  Node& node = nodes_[static_cast<std::size_t>(nodeIndex)];
+  if (node.route >= 0) {
+    return false;
+  }
+  node.route = id;
+  return true;
+}
+
+void OscAddressSpace::clear() { nodes_ = std::vector<Node>(1); }
+
+int OscAddressSpace::match(std::string_view address, OscRouteMatch* matches, int maxMatches) const {
+  if (matches == nullptr || maxMatches <= 0 || address.empty() || address.front() != '/') {
+    return 0;
+  }
+
+  Walk state;
+  state.matches = matches;
+  state.maxMatches = maxMatches;
+  walk(0, address.substr(1), &state);
+  return state.found;
+}
+
+bool OscAddressSpace::isPattern(std::string_view segment) {
+  return segment.find_first_of("*?[]{}") != std::string_view::npos;
+}
+
+bool OscAddressSpace::matchPattern(std::string_view pattern, std::string_view text) {
+  while (!pattern.empty()) {
+    switch (pattern.front()) {
+      case '*': {
+        while (!pattern.empty() && pattern.front() == '*') {
+          pattern.remove_prefix(1);
+        }
+        if (pattern.empty()) {
+          return true;
+        }
+        for (std::size_t i = 0; i <= text.size(); ++i) {
+          if (matchPattern(pattern, text.substr(i))) {
+            return true;
+          }
+        }
+        return false;
+      }
+      case '?':
+        if (text.empty()) {
+          return false;
+        }
+        break;
+      case '[': {
+        const std::size_t close = pattern.find(']', 1);
+        if (text.empty() || close == std::string_view::npos || !matchSet(pattern.substr(1, close - 1), text.front())) {
+          return false;
+        }
+        pattern.remove_prefix(close);
+        break;
+      }
+      case '{': {
+        const std::size_t close = pattern.find('}', 1);
+        if (close == std::string_view::npos) {
+          return false;
+        }
+        std::string_view alternatives = pattern.substr(1, close - 1);
+        const std::string_view after = pattern.substr(close + 1);
+        while (true) {
+          const std::size_t comma = alternatives.find(',');
+          const std::string_view alternative = alternatives.substr(0, comma);
+          if (text.starts_with(alternative) && matchPattern(after, text.substr(alternative.size()))) {
+            return true;
+          }
+          if (comma == std::string_view::npos) {
+            return false;
+          }
+          alternatives.remove_prefix(comma + 1);
+        }
+      }
+      default:
+        if (text.empty() || text.front() != pattern.front()) {
+          return false;
+        }
+        break;
+    }
+    pattern.remove_prefix(1);
+    text.remove_prefix(1);
+  }
+  return text.empty();
+}
+
+int OscAddressSpace::literalChild(const Node& node, std::string_view segment) const {
+  const auto position =
+      std::lower_bound(node.children.begin(), node.children.end(), segment, [this](int index, std::string_view key) {
+        return nodes_[static_cast<std::size_t>(index)].segment < key;
+      });
+  if (position == node.children.end() || nodes_[static_cast<std::size_t>(*position)].segment != segment) {
+    return -1;
+  }
+  return *position;
+}
+
+void OscAddressSpace::walk(int nodeIndex, std::string_view rest, Walk* state) const {
+  if (state->found >= state->maxMatches) {
+    return;
+  }
+
+  const Node& node = nodes_[static_cast<std::size_t>(nodeIndex)];
+  if (rest.empty()) {
+    if (node.route >= 0) {
+      state->current.route = node.route;
+      state->matches[state->found++] = state->current;
+    }
+    return;
+  }
+
+  const std::size_t slash = rest.find('/');
+  const std::string_view segment = rest.substr(0, slash);
+  const std::string_view next = slash == std::string_view::npos ? std::string_view() : rest.substr(slash + 1);
+
+  if (isPattern(segment)) {
+    for (const int child : node.children) {
+      if (matchPattern(segment, nodes_[static_cast<std::size_t>(child)].segment)) {
+        walk(child, next, state);
+      }
+    }
+    return;
+  }
+
+  const int child = literalChild(node, segment);
+  if (child >= 0) {
+    walk(child, next, state);
+  }
+  if (node.placeholderChild >= 0 && !segment.empty() && state->current.captureCount < OscRouteMatch::kMaxCaptures) {
+    state->current.captures[static_cast<std::size_t>(state->current.captureCount++)] = segment;
+    walk(node.placeholderChild, next, state);
+    --state->current.captureCount;
+  }
+}
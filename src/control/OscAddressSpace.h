@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct OscRouteMatch {
+  static constexpr int kMaxCaptures = 4;
+
+  int route = -1;
+  // The address segments that filled the route's <placeholders>, in order.
+  std::array<std::string_view, kMaxCaptures> captures;
+  int captureCount = 0;
+};
+
+// The OSC server's address space, compiled into a trie once. Routes are
+// literal segments and <name> placeholders, e.g. /cue/id/<id>/go. Incoming
+// addresses may use OSC 1.0 patterns (* ? [] {}) in any segment; a pattern
+// matches literal route segments only, since placeholder values such as cue
+// ids cannot be enumerated. A plain address costs one child lookup per
+// segment and matching never allocates.
+class OscAddressSpace {
+ public:
+  static constexpr int kMaxDepth = 8;
+
+  // False if the route is malformed, too deep or has too many placeholders.
+  bool addRoute(std::string_view route, int id);
+  void clear();
+
+  // Fills matches with every route the address reaches and returns how many
+  // were found, at most maxMatches.
+  int match(std::string_view address, OscRouteMatch* matches, int maxMatches) const;
+
+  static bool isPattern(std::string_view segment);
+  static bool matchPattern(std::string_view pattern, std::string_view text);
+
+ private:
+  struct Node {
+    std::string segment;
+    int route = -1;
+    int placeholderChild = -1;
+    // Literal children, sorted by segment.
+    std::vector<int> children;
+  };
+
+  struct Walk {
+    OscRouteMatch current;
+    OscRouteMatch* matches = nullptr;
+    int maxMatches = 0;
+    int found = 0;
+  };
+
+  int literalChild(const Node& node, std::string_view segment) const;
+  void walk(int nodeIndex, std::string_view rest, Walk* state) const;
+
+  std::vector<Node> nodes_ = std::vector<Node>(1);
+};
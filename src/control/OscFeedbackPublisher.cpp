@@ -0,0 +1,378 @@
+#include "control/OscFeedbackPublisher.h"
+
+#include <QHash>
+#include <QMetaObject>
+#include <QSet>
+#include <QThread>
+#include <QTimer>
+#include <QUdpSocket>
+#include <QVector>
+
+#include <string_view>
+
+#include "control/OscWriter.h"
+#include "core/Trace.h"
+#include "core/TriggerStamp.h"
+
+namespace {
+
+constexpr int kFlushTickMs = 10;
+
+quint64 layerKey(int screenIndex, int layer) {
+  return (static_cast<quint64>(static_cast<quint32>(screenIndex)) << 32) | static_cast<quint32>(layer);
+}
+
+std::string_view view(const QByteArray& bytes) {
+  return std::string_view(bytes.constData(), static_cast<std::size_t>(bytes.size()));
+}
+
+}  // namespace
+
+// Owns the socket and all feedback state; lives on the publisher's thread.
+class OscFeedbackPublisher::Sender : public QObject {
+ public:
+  explicit Sender(OscFeedbackPublisher* publisher)
+      : publisher_(publisher), socket_(new QUdpSocket(this)), flushTimer_(new QTimer(this)) {
+    flushTimer_->setInterval(kFlushTickMs);
+    connect(flushTimer_, &QTimer::timeout, this, &Sender::flushPositions);
+  }
+
+  void subscribe(const QHostAddress& host, quint16 port, quint32 session, int maxRateHz) {
+    const int rateHz = maxRateHz > 0 ? qMin(maxRateHz, kMaxRateHz) : kDefaultRateHz;
+    Subscriber* subscriber = find(host, port, session);
+    if (subscriber == nullptr) {
+      Subscriber added;
+      added.host = host;
+      added.port = port;
+      added.session = session;
+      if (subscribers_.size() >= kMaxSubscribers) {
+        emit publisher_->statusMessage(
+            QString("OSC feedback: %1 subscribers already, ignored %2.").arg(kMaxSubscribers).arg(describe(added)));
+        return;
+      }
+      subscribers_.push_back(added);
+      subscriber = &subscribers_.last();
+      publisher_->subscribers_.store(static_cast<int>(subscribers_.size()), std::memory_order_relaxed);
+      emit publisher_->statusMessage(QString("OSC feedback to %1 at %2 Hz.").arg(describe(added)).arg(rateHz));
+    }
+    subscriber->intervalNs = 1000000000LL / rateHz;
+    sendSnapshot(subscriber);
+  }
+
+  void unsubscribe(const QHostAddress& host, quint16 port, quint32 session) {
+    Subscriber* subscriber = find(host, port, session);
+    if (subscriber != nullptr) {
+      remove(static_cast<int>(subscriber - subscribers_.data()));
+    }
+  }
+
+  void dropSession(quint32 session) {
+    for (int i = 0; i < subscribers_.size(); ++i) {
+      if (subscribers_.at(i).session == session) {
+        remove(i);
+        return;
+      }
+    }
+  }
+
+  void cueLive(const QString& cueId, const QString& cueName, int screenIndex, int layer) {
+    const quint64 key = layerKey(screenIndex, layer);
+    auto it = layers_.find(key);
+    if (it != layers_.end() && it->cueId != cueId) {
+      sendStopped(*it, screenIndex, layer);
+    }
+
+    LayerState& state = layers_[key];
+    if (state.cueAddress.isEmpty()) {
+      const QByteArray prefix = "/feedback/layer/" + QByteArray::number(screenIndex) + '/' + QByteArray::number(layer);
+      state.cueAddress = prefix + "/cue";
+      state.timeAddress = prefix + "/time";
+    }
+    state.cueId = cueId;
+    state.idUtf8 = cueId.toUtf8();
+    state.nameUtf8 = cueName.toUtf8();
+    state.positionSec = 0.0;
+    state.durationSec = 0.0;
+
+    for (const Subscriber& subscriber : subscribers_) {
+      sendLive(subscriber, state, screenIndex, layer);
+    }
+  }
+
+  void layerStopped(int screenIndex, int layer) {
+    const quint64 key = layerKey(screenIndex, layer);
+    auto it = layers_.find(key);
+    if (it == layers_.end()) {
+      return;
+    }
+    sendStopped(*it, screenIndex, layer);
+    layers_.erase(it);
+    for (Subscriber& subscriber : subscribers_) {
+      subscriber.dirtyLayers.remove(key);
+    }
+  }
+
+  void allStopped() {
+    for (auto it = layers_.begin(); it != layers_.end(); ++it) {
+      sendStopped(it.value(), static_cast<int>(it.key() >> 32), static_cast<int>(static_cast<quint32>(it.key())));
+    }
+    layers_.clear();
+    for (Subscriber& subscriber : subscribers_) {
+      subscriber.dirtyLayers.clear();
+    }
+  }
+
+  void position(const QString& cueId, int screenIndex, int layer, double positionSec, double durationSec) {
+    const quint64 key = layerKey(screenIndex, layer);
+    auto it = layers_.find(key);
+    // Late updates from a player that was just replaced are dropped.
+    if (it == layers_.end() || it->cueId != cueId) {
+      return;
+    }
+    it->positionSec = positionSec;
+    it->durationSec = durationSec;
+    for (Subscriber& subscriber : subscribers_) {
+      subscriber.dirtyLayers.insert(key);
+    }
+    if (!subscribers_.isEmpty() && !flushTimer_->isActive()) {
+      flushTimer_->start();
+    }
+  }
+
+  void preview(const QString& cueId, const QString& cueName) {
+    previewIdUtf8_ = cueId.toUtf8();
+    previewNameUtf8_ = cueName.toUtf8();
+    for (const Subscriber& subscriber : subscribers_) {
+      sendPreview(subscriber);
+    }
+  }
+
+  void error(const QString& message) {
+    const QByteArray text = message.toUtf8();
+    writer_.begin("/feedback/error", "s");
+    writer_.addString(view(text));
+    for (const Subscriber& subscriber : subscribers_) {
+      send(subscriber);
+    }
+  }
+
+ private:
+  struct Subscriber {
+    QHostAddress host;
+    quint16 port = 0;
+    // Non-zero for a TCP session, which is answered on its own connection.
+    quint32 session = 0;
+    qint64 intervalNs = 1000000000LL / kDefaultRateHz;
+    qint64 nextPositionNs = 0;
+    // Layers whose position changed since this subscriber was last sent one.
+    QSet<quint64> dirtyLayers;
+  };
+
+  struct LayerState {
+    QString cueId;
+    QByteArray idUtf8;
+    QByteArray nameUtf8;
+    QByteArray cueAddress;
+    QByteArray timeAddress;
+    double positionSec = 0.0;
+    double durationSec = 0.0;
+  };
+
+  Subscriber* find(const QHostAddress& host, quint16 port, quint32 session) {
+    for (Subscriber& subscriber : subscribers_) {
+      const bool samePeer = subscriber.session == 0 && subscriber.port == port && subscriber.host.isEqual(host);
+      if (session != 0 ? subscriber.session == session : samePeer) {
+        return &subscriber;
+      }
+    }
+    return nullptr;
+  }
+
+  void remove(int index) {
+    const QString peer = describe(subscribers_.at(index));
+    subscribers_.removeAt(index);
+    publisher_->subscribers_.store(static_cast<int>(subscribers_.size()), std::memory_order_relaxed);
+    emit publisher_->statusMessage(QString("OSC feedback to %1 stopped.").arg(peer));
+  }
+
+  static QString describe(const Subscriber& subscriber) {
+    const QString peer = QString("%1:%2").arg(subscriber.host.toString()).arg(subscriber.port);
+    return subscriber.session != 0 ? QString("TCP session %1 (%2)").arg(subscriber.session).arg(peer) : peer;
+  }
+
+  void send(const Subscriber& subscriber) {
+    if (subscriber.session != 0) {
+      emit publisher_->sessionPacketReady(subscriber.session, writer_.data());
+      return;
+    }
+    socket_->writeDatagram(writer_.data(), subscriber.host, subscriber.port);
+  }
+
+  void sendSnapshot(Subscriber* subscriber) {
+    for (auto it = layers_.begin(); it != layers_.end(); ++it) {
+      sendLive(*subscriber, it.value(), static_cast<int>(it.key() >> 32),
+               static_cast<int>(static_cast<quint32>(it.key())));
+      subscriber->dirtyLayers.insert(it.key());
+    }
+    if (!previewIdUtf8_.isEmpty()) {
+      sendPreview(*subscriber);
+    }
+    if (!subscriber->dirtyLayers.isEmpty() && !flushTimer_->isActive()) {
+      flushTimer_->start();
+    }
+  }
+
+  void sendLive(const Subscriber& subscriber, const LayerState& state, int screenIndex, int layer) {
+    writer_.begin("/feedback/cue/live", "ssii");
+    writer_.addString(view(state.idUtf8));
+    writer_.addString(view(state.nameUtf8));
+    writer_.addInt(screenIndex);
+    writer_.addInt(layer);
+    send(subscriber);
+
+    writer_.begin(view(state.cueAddress), "ss");
+    writer_.addString(view(state.idUtf8));
+    writer_.addString(view(state.nameUtf8));
+    send(subscriber);
+  }
+
+  void sendStopped(const LayerState& state, int screenIndex, int layer) {
+    for (const Subscriber& subscriber : subscribers_) {
+      writer_.begin("/feedback/cue/stopped", "sii");
+      writer_.addString(view(state.idUtf8));
+      writer_.addInt(screenIndex);
+      writer_.addInt(layer);
+      send(subscriber);
+
+      writer_.begin(view(state.cueAddress), "ss");
+      writer_.addString({});
+      writer_.addString({});
+      send(subscriber);
+    }
+  }
+
+  void sendPreview(const Subscriber& subscriber) {
+    writer_.begin("/feedback/preview", "ss");
+    writer_.addString(view(previewIdUtf8_));
+    writer_.addString(view(previewNameUtf8_));
+    send(subscriber);
+  }
+
+  // Each subscriber gets the latest position of every layer that moved, at
+  // most once per its interval; updates in between are folded together.
+  void flushPositions() {
+    const TraceScope trace("control", "oscFeedbackFlush");
+    const qint64 nowNs = monotonicNowNs();
+    bool pending = false;
+    for (Subscriber& subscriber : subscribers_) {
+      if (subscriber.dirtyLayers.isEmpty()) {
+        continue;
+      }
+      if (nowNs < subscriber.nextPositionNs) {
+        pending = true;
+        continue;
+      }
+
+      for (const quint64 key : subscriber.dirtyLayers) {
+        const auto it = layers_.constFind(key);
+        if (it == layers_.cend()) {
+          continue;
+        }
+        writer_.begin(view(it->timeAddress), "fff");
+        writer_.addFloat(static_cast<float>(it->positionSec));
+        writer_.addFloat(static_cast<float>(qMax(0.0, it->durationSec - it->positionSec)));
+        writer_.addFloat(static_cast<float>(it->durationSec));
+        send(subscriber);
+      }
+      subscriber.dirtyLayers.clear();
+      subscriber.nextPositionNs = nowNs + subscriber.intervalNs;
+    }
+    if (!pending) {
+      flushTimer_->stop();
+    }
+  }
+
+  OscFeedbackPublisher* publisher_;
+  QUdpSocket* socket_;
+  QTimer* flushTimer_;
+  OscWriter writer_;
+  QVector<Subscriber> subscribers_;
+  QHash<quint64, LayerState> layers_;
+  QByteArray previewIdUtf8_;
+  QByteArray previewNameUtf8_;
+};
+
+OscFeedbackPublisher::OscFeedbackPublisher(QObject* parent)
+    : QObject(parent), thread_(new QThread(this)), sender_(new Sender(this)) {
+  thread_->setObjectName("OSC feedback");
+  sender_->moveToThread(thread_);
+  connect(thread_, &QThread::finished, sender_, &QObject::deleteLater);
+  thread_->start();
+}
+
+OscFeedbackPublisher::~OscFeedbackPublisher() {
+  thread_->quit();
+  thread_->wait();
+}
+
+void OscFeedbackPublisher::subscribe(const QHostAddress& host, quint16 port, quint32 session, int maxRateHz) {
+  QMetaObject::invokeMethod(
+      sender_,
+      [sender = sender_, host, port, session, maxRateHz]() { sender->subscribe(host, port, session, maxRateHz); },
+      Qt::QueuedConnection);
+}
+
+void OscFeedbackPublisher::unsubscribe(const QHostAddress& host, quint16 port, quint32 session) {
+  QMetaObject::invokeMethod(
+      sender_, [sender = sender_, host, port, session]() { sender->unsubscribe(host, port, session); },
+      Qt::QueuedConnection);
+}
+
+void OscFeedbackPublisher::dropSession(quint32 session) {
+  QMetaObject::invokeMethod(
+      sender_, [sender = sender_, session]() { sender->dropSession(session); }, Qt::QueuedConnection);
+}
+
+int OscFeedbackPublisher::subscriberCount() const { return subscribers_.load(std::memory_order_relaxed); }
+
+void OscFeedbackPublisher::publishCueLive(const QString& cueId, const QString& cueName, int screenIndex, int layer) {
+  QMetaObject::invokeMethod(
+      sender_,
+      [sender = sender_, cueId, cueName, screenIndex, layer]() { sender->cueLive(cueId, cueName, screenIndex, layer); },
+      Qt::QueuedConnection);
+}
+
+void OscFeedbackPublisher::publishLayerStopped(int screenIndex, int layer) {
+  QMetaObject::invokeMethod(
+      sender_, [sender = sender_, screenIndex, layer]() { sender->layerStopped(screenIndex, layer); },
+      Qt::QueuedConnection);
+}
+
+void OscFeedbackPublisher::publishAllStopped() {
+  QMetaObject::invokeMethod(sender_, [sender = sender_]() { sender->allStopped(); }, Qt::QueuedConnection);
+}
+
+void OscFeedbackPublisher::publishPosition(const QString& cueId, int screenIndex, int layer, double positionSec,
+                                           double durationSec) {
+  if (subscriberCount() == 0) {
+    return;
+  }
+  QMetaObject::invokeMethod(
+      sender_,
+      [sender = sender_, cueId, screenIndex, layer, positionSec, durationSec]() {
+        sender->position(cueId, screenIndex, layer, positionSec, durationSec);
+      },
+      Qt::QueuedConnection);
+}
+
+void OscFeedbackPublisher::publishPreview(const QString& cueId, const QString& cueName) {
+  QMetaObject::invokeMethod(
+      sender_, [sender = sender_, cueId, cueName]() { sender->preview(cueId, cueName); }, Qt::QueuedConnection);
+}
+
+void OscFeedbackPublisher::publishError(const QString& message) {
+  if (subscriberCount() == 0) {
+    return;
+  }
+  QMetaObject::invokeMethod(sender_, [sender = sender_, message]() { sender->error(message); }, Qt::QueuedConnection);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHostAddress>
+#include <QObject>
+#include <QString>
+
+#include <atomic>
+
+class QThread;
+
+// Pushes show state to subscribed OSC controllers so tablets follow what is
+// live without polling:
+//   /feedback/cue/live ,ssii       id name screen layer
+//   /feedback/cue/stopped ,sii     id screen layer
+//   /feedback/layer/<s>/<l>/cue ,ss        id name (empty once stopped)
+//   /feedback/layer/<s>/<l>/time ,fff      position remaining duration (s)
+//   /feedback/preview ,ss          id name
+//   /feedback/error ,s             message
+// Subscribers are UDP host:port pairs or TCP sessions; a session's packets
+// are handed out through sessionPacketReady for its own connection.
+// Encoding and sending run on a thread of their own; the calls here only
+// post the change. Positions and errors are not posted at all while no one
+// is subscribed; positions are coalesced per subscriber and sent at most at
+// its rate.
+class OscFeedbackPublisher : public QObject {
+  Q_OBJECT
+
+ public:
+  static constexpr int kDefaultRateHz = 10;
+  static constexpr int kMaxRateHz = 60;
+  static constexpr int kMaxSubscribers = 16;
+
+  explicit OscFeedbackPublisher(QObject* parent = nullptr);
+  ~OscFeedbackPublisher() override;
+
+  // A non-zero session subscribes that TCP session rather than host:port.
+  // Subscribing again updates the rate; 0 keeps the default. A new
+  // subscriber gets the current state straight away.
+  void subscribe(const QHostAddress& host, quint16 port, quint32 session, int maxRateHz);
+  void unsubscribe(const QHostAddress& host, quint16 port, quint32 session);
+  // Forgets a TCP session that has closed.
+  void dropSession(quint32 session);
+  int subscriberCount() const;
+
+  void publishCueLive(const QString& cueId, const QString& cueName, int screenIndex, int layer);
+  void publishLayerStopped(int screenIndex, int layer);
+  void publishAllStopped();
+  void publishPosition(const QString& cueId, int screenIndex, int layer, double positionSec, double durationSec);
+  void publishPreview(const QString& cueId, const QString& cueName);
+  void publishError(const QString& message);
+
+ signals:
+  void statusMessage(const QString& message);
+  // Emitted on the publisher's thread.
+  void sessionPacketReady(quint32 session, const QByteArray& packet);
+
+ private:
+  class Sender;
+
+  QThread* thread_;
+  Sender* sender_;
+  std::atomic<int> subscribers_{0};
+};
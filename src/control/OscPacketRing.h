@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QByteArray>
+#include <QtGlobal>
+
+#include <atomic>
+#include <memory>
+
+#include "control/OscParser.h"
+
+// Where a packet came from; IPv4 in host byte order, 0 when unknown.
+struct OscSender {
+  quint32 address = 0;
+  quint16 port = 0;
+  // The TCP session it arrived on; 0 for UDP.
+  quint32 session = 0;
+};
+
+// A received datagram, parsed in place on the I/O thread. The message and
+// bundle views point into data, so a packet is only read while its slot is
+// held.
+struct OscPacket {
+  static constexpr int kCapacity = 2048;
+
+  char data[kCapacity];
+  // Stream frames too big for data. Emptied with resize(0) so the allocation
+  // stays with the slot for the next oversized frame.
+  QByteArray spill;
+  int size = 0;
+  qint64 ingressNs = -1;
+  OscSender sender;
+  bool parsed = false;
+  bool isBundle = false;
+  OscMessageView message;
+  OscBundleView bundle;
+
+  char* bytes() { return size > kCapacity && !spill.isEmpty() ? spill.data() : data; }
+};
+
+// Single-producer, single-consumer ring of preallocated packets between the
+// OSC I/O thread and the GUI thread. The producer fills free slots in place
+// and publishes them in one step; the consumer reads and releases them in
+// order. Neither side locks or allocates.
+class OscPacketRing {
+ public:
+  static constexpr quint32 kSlots = 512;
+
+  OscPacketRing() : packets_(std::make_unique<OscPacket[]>(kSlots)) {}
+
+  // Producer side.
+  int freeSlots() const {
+    return static_cast<int>(kSlots - (tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_acquire)));
+  }
+  // index counts from the first unpublished slot and must be below freeSlots().
+  OscPacket& writable(int index) { return packets_[(tail_.load(std::memory_order_relaxed) + index) % kSlots]; }
+  void publish(int count) { tail_.fetch_add(static_cast<quint32>(count), std::memory_order_release); }
+  // True when the consumer already has a drain on the way; otherwise claims
+  // it, and the caller must schedule one.
+  bool drainScheduled() { return drainScheduled_.exchange(true, std::memory_order_acq_rel); }
+
+  // Consumer side. Clear the drain flag before emptying the ring so a
+  // publish that races the last pop schedules another drain.
+  void clearDrainScheduled() { drainScheduled_.store(false, std::memory_order_release); }
+  OscPacket* front() {
+    const quint32 head = head_.load(std::memory_order_relaxed);
+    return head == tail_.load(std::memory_order_acquire) ? nullptr : &packets_[head % kSlots];
+  }
+  void pop() { head_.fetch_add(1, std::memory_order_release); }
+
+ private:
+  std::unique_ptr<OscPacket[]> packets_;
+  alignas(64) std::atomic<quint32> head_{0};
+  alignas(64) std::atomic<quint32> tail_{0};
+  alignas(64) std::atomic<bool> drainScheduled_{false};
+};
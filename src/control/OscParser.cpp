@@ -0,0 +1,262 @@
+#include "control/OscParser.h"
+
+#include <QtEndian>
+
+#include <charconv>
+#include <cstring>
+
+namespace {
+
+struct CommandAlias {
+  std::string_view word;
+  std::string_view address;
+};
+
+constexpr std::array<CommandAlias, 8> kCommandAliases = {{
+    {"play", "/cue/play"},
+    {"preview", "/cue/preview"},
+    {"preload", "/cue/preload"},
+    {"take", "/cue/take"},
+    {"stopall", "/cue/stop_all"},
+    {"timecode", "/timecode"},
+    {"dmx", "/dmx"},
+    {"text", "/text"},
+}};
+
+bool readPaddedString(const char* data, int size, int* offset, std::string_view* out) {
+  if (*offset < 0 || *offset >= size) {
+    return false;
+  }
+
+  const void* terminator = std::memchr(data + *offset, '\0', static_cast<std::size_t>(size - *offset));
+  if (terminator == nullptr) {
+    return false;
+  }
+
+  // The terminator counts towards the string's 4-byte padding.
+  const int end = static_cast<int>(static_cast<const char*>(terminator) - data);
+  const int aligned = (end + 4) & ~3;
+  if (aligned > size) {
+    return false;
+  }
+
+  *out = std::string_view(data + *offset, static_cast<std::size_t>(end - *offset));
+  *offset = aligned;
+  return true;
+}
+
+bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v'; }
+
+std::string_view trimmed(std::string_view text) {
+  while (!text.empty() && isSpace(text.front())) {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && isSpace(text.back())) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+std::string_view nextToken(std::string_view* rest) {
+  std::size_t start = 0;
+  while (start < rest->size() && isSpace((*rest)[start])) {
+    ++start;
+  }
+  std::size_t end = start;
+  while (end < rest->size() && !isSpace((*rest)[end])) {
+    ++end;
+  }
+  const std::string_view token = rest->substr(start, end - start);
+  rest->remove_prefix(end);
+  return token;
+}
+
+constexpr char kBundleTag[8] = {'#', 'b', 'u', 'n', 'd', 'l', 'e', '\0'};
+// Seconds from the NTP epoch (1900) to the Unix epoch (1970).
+constexpr qint64 kNtpToUnixSeconds = 2208988800LL;
+
+bool appendBundle(const char* data, int size, quint64 enclosingTimetag, int depth, OscBundleView* bundle) {
+  if (depth >= OscBundleView::kMaxDepth || !OscParser::isBundle(data, size) || size < 16) {
+    return false;
+  }
+
+  // A nested bundle may not run earlier than the bundle holding it.
+  const quint64 timetag = qMax(qFromBigEndian<quint64>(data + 8), enclosingTimetag);
+
+  int offset = 16;
+  while (offset < size) {
+    if (offset + 4 > size) {
+      return false;
+    }
+    const qint32 elementSize = qFromBigEndian<qint32>(data + offset);
+    offset += 4;
+    if (elementSize <= 0 || elementSize % 4 != 0 || elementSize > size - offset) {
+      return false;
+    }
+
+    const char* element = data + offset;
+    if (element[0] == '#') {
+      if (!appendBundle(element, elementSize, timetag, depth + 1, bundle)) {
+        return false;
+      }
+    } else {
+      OscMessageView message;
+      if (bundle->messageCount >= OscBundleView::kMaxMessages ||
+          !OscParser::parseMessage(element, elementSize, &message)) {
+        return false;
+      }
+      OscBundleElement& entry = bundle->messages[static_cast<std::size_t>(bundle->messageCount++)];
+      entry.bytes = std::string_view(element, static_cast<std::size_t>(elementSize));
+      entry.timetag = timetag;
+      entry.dueNs = 0;
+    }
+    offset += elementSize;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool OscParser::parseMessage(const char* data, int size, OscMessageView* message) {
+  if (message == nullptr || data == nullptr || size <= 0 || data[0] != '/') {
+    return false;
+  }
+
+  int offset = 0;
+  std::string_view typeTags;
+  if (!readPaddedString(data, size, &offset, &message->address) ||
+      !readPaddedString(data, size, &offset, &typeTags)) {
+    return false;
+  }
+  if (typeTags.empty() || typeTags.front() != ',') {
+    return false;
+  }
+
+  message->argCount = 0;
+  for (std::size_t i = 1; i < typeTags.size(); ++i) {
+    OscArgumentView arg;
+    switch (typeTags[i]) {
+      case 'i':
+        if (offset + 4 > size) {
+          return false;
+        }
+        arg.type = OscArgumentView::Type::Int;
+        arg.intValue = qFromBigEndian<qint32>(data + offset);
+        offset += 4;
+        break;
+      case 'f': {
+        if (offset + 4 > size) {
+          return false;
+        }
+        const quint32 raw = qFromBigEndian<quint32>(data + offset);
+        static_assert(sizeof(float) == sizeof(quint32), "Unexpected float size");
+        arg.type = OscArgumentView::Type::Float;
+        std::memcpy(&arg.floatValue, &raw, sizeof(float));
+        offset += 4;
+        break;
+      }
+      case 's':
+        arg.type = OscArgumentView::Type::String;
+        if (!readPaddedString(data, size, &offset, &arg.stringValue)) {
+          return false;
+        }
+        break;
+      default:
+        return false;
+    }
+
+    if (message->argCount < OscMessageView::kMaxArguments) {
+      message->args[static_cast<std::size_t>(message->argCount++)] = arg;
+    }
+  }
+
+  return true;
+}
+
+bool OscParser::isBundle(const char* data, int size) {
+  return data != nullptr && size >= 8 && std::memcmp(data, kBundleTag, sizeof(kBundleTag)) == 0;
+}
+
+bool OscParser::parseBundle(const char* data, int size, OscBundleView* bundle) {
+  if (bundle == nullptr) {
+    return false;
+  }
+  bundle->messageCount = 0;
+  return appendBundle(data, size, kImmediately, 0, bundle);
+}
+
+bool OscParser::parseTextCommand(char* data, int size, OscMessageView* message) {
+  if (message == nullptr || data == nullptr || size <= 0) {
+    return false;
+  }
+
+  std::string_view rest(data, static_cast<std::size_t>(size));
+  const std::string_view command = nextToken(&rest);
+  if (command.empty()) {
+    return false;
+  }
+
+  char* word = data + (command.data() - data);
+  for (std::size_t i = 0; i < command.size(); ++i) {
+    if (word[i] >= 'A' && word[i] <= 'Z') {
+      word[i] = static_cast<char>(word[i] - 'A' + 'a');
+    }
+  }
+
+  std::string_view address = command;
+  if (command.front() != '/') {
+    address = {};
+    for (const CommandAlias& alias : kCommandAliases) {
+      if (alias.word == command) {
+        address = alias.address;
+        break;
+      }
+    }
+    if (address.empty()) {
+      return false;
+    }
+  }
+
+  message->address = address;
+  message->argCount = 0;
+
+  // Overlay text keeps its spacing and runs to the end of the line.
+  if (address == "/text") {
+    const std::string_view text = trimmed(rest);
+    if (!text.empty()) {
+      message->args[0].type = OscArgumentView::Type::String;
+      message->args[0].stringValue = text;
+      message->argCount = 1;
+    }
+    return true;
+  }
+
+  for (std::string_view token = nextToken(&rest); !token.empty(); token = nextToken(&rest)) {
+    OscArgumentView arg;
+    if (parseInt(token, &arg.intValue)) {
+      arg.type = OscArgumentView::Type::Int;
+    } else {
+      arg.type = OscArgumentView::Type::String;
+      arg.stringValue = token;
+    }
+    if (message->argCount < OscMessageView::kMaxArguments) {
+      message->args[static_cast<std::size_t>(message->argCount++)] = arg;
+    }
+  }
+  return true;
+}
+
+bool OscParser::parseInt(std::string_view text, qint32* value) {
+  if (text.size() > 1 && text.front() == '+') {
+    text.remove_prefix(1);
+  }
+  const char* end = text.data() + text.size();
+  const auto [last, error] = std::from_chars(text.data(), end, *value);
+  return error == std::errc() && last == end;
+}
+
+qint64 OscParser::timetagToUnixNs(quint64 timetag) {
+  const qint64 seconds = static_cast<qint64>(timetag >> 32) - kNtpToUnixSeconds;
+  const qint64 fraction = static_cast<qint64>(((timetag & 0xffffffffULL) * 1000000000ULL) >> 32);
+  return seconds * 1000000000LL + fraction;
+}
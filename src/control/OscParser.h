@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <array>
+#include <string_view>
+
+struct OscArgumentView {
+  enum class Type { Int, Float, String } type = Type::String;
+  qint32 intValue = 0;
+  float floatValue = 0.0f;
+  // Points into the datagram.
+  std::string_view stringValue;
+};
+
+// One OSC message as views into the datagram it was parsed from; valid for
+// as long as those bytes are. Arguments past kMaxArguments are checked but
+// not kept.
+struct OscMessageView {
+  static constexpr int kMaxArguments = 8;
+
+  std::string_view address;
+  std::array<OscArgumentView, kMaxArguments> args;
+  int argCount = 0;
+
+  bool hasArg(int index, OscArgumentView::Type type) const {
+    return index < argCount && args[static_cast<std::size_t>(index)].type == type;
+  }
+};
+
+// A #bundle flattened to its messages in wire order, nested bundles
+// included. Each message carries the timetag it is due at: its innermost
+// bundle's, never earlier than an enclosing one.
+struct OscBundleElement {
+  std::string_view bytes;
+  quint64 timetag = 1;
+  // Monotonic due time, filled in by the receiver; 0 runs on arrival.
+  qint64 dueNs = 0;
+};
+
+struct OscBundleView {
+  static constexpr int kMaxMessages = 64;
+  static constexpr int kMaxDepth = 8;
+
+  std::array<OscBundleElement, kMaxMessages> messages;
+  int messageCount = 0;
+};
+
+// Parsers for the OSC server's wire formats. None of them allocates.
+class OscParser {
+ public:
+  // The OSC timetag meaning "run immediately".
+  static constexpr quint64 kImmediately = 1;
+
+  // A binary OSC message with i, f and s arguments.
+  static bool parseMessage(const char* data, int size, OscMessageView* message);
+  static bool isBundle(const char* data, int size);
+  // Rejects the whole bundle if any message in it is malformed.
+  static bool parseBundle(const char* data, int size, OscBundleView* bundle);
+  // A plain-text command such as "play 3" or "/cue/take", for consoles that
+  // cannot send binary OSC. Lower-cases the command word in place.
+  static bool parseTextCommand(char* data, int size, OscMessageView* message);
+
+  // A whole decimal token; a leading '+' is allowed.
+  static bool parseInt(std::string_view text, qint32* value);
+  // An NTP timetag as nanoseconds since the Unix epoch.
+  static qint64 timetagToUnixNs(quint64 timetag);
+};
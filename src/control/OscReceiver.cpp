@@ -0,0 +1,277 @@
+#include "control/OscReceiver.h"
+
+#include <QSocketNotifier>
+
+#include <array>
+#include <chrono>
+
+#ifdef Q_OS_UNIX
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#else
+#include <QHostAddress>
+#include <QUdpSocket>
+#endif
+
+#include "control/OscPacketRing.h"
+#include "core/Trace.h"
+#include "core/TriggerStamp.h"
+
+namespace {
+
+constexpr int kBatchSize = 64;
+// Room for a few hundred packets while the receiver is descheduled.
+constexpr int kReceiveBufferBytes = 1 << 20;
+
+}  // namespace
+
+struct OscReceiver::Batch {
+#ifdef Q_OS_LINUX
+  std::array<mmsghdr, kBatchSize> headers{};
+  std::array<iovec, kBatchSize> vectors{};
+  std::array<sockaddr_in, kBatchSize> senders{};
+#endif
+  char scratch[OscPacket::kCapacity];
+};
+
+OscReceiver::OscReceiver(OscPacketRing* ring, QObject* parent)
+    : QObject(parent), ring_(ring), batch_(std::make_unique<Batch>()) {}
+
+OscReceiver::~OscReceiver() { close(); }
+
+#ifdef Q_OS_UNIX
+bool OscReceiver::open(quint16 port, QString* errorMessage) {
+  close();
+
+  const auto fail = [this, errorMessage](const char* step) {
+    if (errorMessage != nullptr) {
+      *errorMessage = QString("%1: %2").arg(step, qt_error_string(errno));
+    }
+    close();
+    return false;
+  };
+
+  fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd_ < 0) {
+    return fail("socket");
+  }
+  ::fcntl(fd_, F_SETFD, FD_CLOEXEC);
+  if (::fcntl(fd_, F_SETFL, ::fcntl(fd_, F_GETFL) | O_NONBLOCK) < 0) {
+    return fail("non-blocking");
+  }
+
+  // Shared like the QUdpSocket this replaces, so a second instance can
+  // listen alongside.
+  const int reuse = 1;
+  ::setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  const int receiveBuffer = kReceiveBufferBytes;
+  ::setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &receiveBuffer, sizeof(receiveBuffer));
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (::bind(fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0) {
+    return fail("bind");
+  }
+
+  socklen_t length = sizeof(address);
+  ::getsockname(fd_, reinterpret_cast<sockaddr*>(&address), &length);
+  port_ = ntohs(address.sin_port);
+
+  notifier_ = new QSocketNotifier(fd_, QSocketNotifier::Read, this);
+  connect(notifier_, &QSocketNotifier::activated, this, &OscReceiver::readPending);
+  return true;
+}
+
+void OscReceiver::close() {
+  delete notifier_;
+  notifier_ = nullptr;
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  port_ = 0;
+}
+
+int OscReceiver::receiveBatch(int room) {
+#ifdef Q_OS_LINUX
+  for (int i = 0; i < room; ++i) {
+    OscPacket& packet = ring_->writable(i);
+    batch_->vectors[i] = {packet.data, sizeof(packet.data)};
+    batch_->headers[i] = {};
+    batch_->headers[i].msg_hdr.msg_iov = &batch_->vectors[i];
+    batch_->headers[i].msg_hdr.msg_iovlen = 1;
+    batch_->headers[i].msg_hdr.msg_name = &batch_->senders[i];
+    batch_->headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+  }
+
+  // MSG_TRUNC makes msg_len the full datagram length, so oversized packets
+  // are recognised rather than parsed cut short.
+  const int count = ::recvmmsg(fd_, batch_->headers.data(), static_cast<unsigned int>(room), MSG_DONTWAIT | MSG_TRUNC,
+                               nullptr);
+  for (int i = 0; i < count; ++i) {
+    OscPacket& packet = ring_->writable(i);
+    packet.size = static_cast<int>(batch_->headers[i].msg_len);
+    packet.sender = {ntohl(batch_->senders[i].sin_addr.s_addr), ntohs(batch_->senders[i].sin_port)};
+  }
+  return qMax(0, count);
+#else
+  int count = 0;
+  while (count < room) {
+    OscPacket& packet = ring_->writable(count);
+    iovec vector = {packet.data, sizeof(packet.data)};
+    sockaddr_in sender{};
+    msghdr header{};
+    header.msg_iov = &vector;
+    header.msg_iovlen = 1;
+    header.msg_name = &sender;
+    header.msg_namelen = sizeof(sender);
+    const ssize_t received = ::recvmsg(fd_, &header, MSG_DONTWAIT);
+    if (received < 0) {
+      break;
+    }
+    packet.size = (header.msg_flags & MSG_TRUNC) != 0 ? OscPacket::kCapacity + 1 : static_cast<int>(received);
+    packet.sender = {ntohl(sender.sin_addr.s_addr), ntohs(sender.sin_port)};
+    ++count;
+  }
+  return count;
+#endif
+}
+
+void OscReceiver::discardPending() {
+  while (::recv(fd_, batch_->scratch, sizeof(batch_->scratch), MSG_DONTWAIT) >= 0) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+#else
+bool OscReceiver::open(quint16 port, QString* errorMessage) {
+  close();
+
+  socket_ = new QUdpSocket(this);
+  socket_->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, kReceiveBufferBytes);
+  if (!socket_->bind(QHostAddress::AnyIPv4, port, QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint)) {
+    if (errorMessage != nullptr) {
+      *errorMessage = socket_->errorString();
+    }
+    close();
+    return false;
+  }
+
+  port_ = socket_->localPort();
+  connect(socket_, &QUdpSocket::readyRead, this, &OscReceiver::readPending);
+  return true;
+}
+
+void OscReceiver::close() {
+  delete socket_;
+  socket_ = nullptr;
+  port_ = 0;
+}
+
+int OscReceiver::receiveBatch(int room) {
+  int count = 0;
+  while (count < room && socket_->hasPendingDatagrams()) {
+    OscPacket& packet = ring_->writable(count);
+    const qint64 pending = socket_->pendingDatagramSize();
+    QHostAddress host;
+    quint16 port = 0;
+    const qint64 received = socket_->readDatagram(packet.data, sizeof(packet.data), &host, &port);
+    if (received < 0) {
+      break;
+    }
+    packet.size = pending > OscPacket::kCapacity ? OscPacket::kCapacity + 1 : static_cast<int>(received);
+    packet.sender = {host.toIPv4Address(), port};
+    ++count;
+  }
+  return count;
+}
+
+void OscReceiver::discardPending() {
+  while (socket_->hasPendingDatagrams() && socket_->readDatagram(batch_->scratch, sizeof(batch_->scratch)) >= 0) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+#endif
+
+quint16 OscReceiver::port() const { return port_; }
+
+qint64 OscReceiver::takeDropped() { return dropped_.exchange(0, std::memory_order_relaxed); }
+
+void OscReceiver::readPending() {
+  const TraceScope trace("control", "oscBatch");
+  int published = 0;
+  while (true) {
+    const int room = qMin(kBatchSize, ring_->freeSlots());
+    if (room == 0) {
+      discardPending();
+      break;
+    }
+
+    const int count = receiveBatch(room);
+    if (count == 0) {
+      break;
+    }
+
+    // Taken at the socket read; the stamp is shared by the batch.
+    const qint64 ingressNs = monotonicNowNs();
+    const qint64 wallOffsetNs = wallToMonotonicNs(ingressNs);
+    for (int i = 0; i < count; ++i) {
+      OscPacket& packet = ring_->writable(i);
+      packet.ingressNs = ingressNs;
+      // A stream frame may have left its spill in this slot.
+      packet.spill.resize(0);
+      parse(&packet, wallOffsetNs);
+    }
+    ring_->publish(count);
+    published += count;
+    if (count < room) {
+      break;
+    }
+  }
+
+  if (published > 0 && !ring_->drainScheduled()) {
+    emit packetsReady();
+  }
+}
+
+qint64 OscReceiver::wallToMonotonicNs(qint64 monotonicNs) {
+  const qint64 wallNs =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+  return wallNs - monotonicNs;
+}
+
+void OscReceiver::parse(OscPacket* packet, qint64 wallToMonotonicNs) {
+  packet->parsed = false;
+  packet->isBundle = false;
+  if (packet->size <= 0 || (packet->size > OscPacket::kCapacity && packet->spill.isEmpty())) {
+    return;
+  }
+
+  char* data = packet->bytes();
+  if (OscParser::isBundle(data, packet->size)) {
+    packet->isBundle = true;
+    packet->parsed = OscParser::parseBundle(data, packet->size, &packet->bundle);
+    if (!packet->parsed) {
+      return;
+    }
+
+    // Timetags are wall-clock; move them onto the monotonic clock now so a
+    // later clock step cannot shift a scheduled GO. Late ones run on arrival.
+    for (int i = 0; i < packet->bundle.messageCount; ++i) {
+      OscBundleElement& element = packet->bundle.messages[static_cast<std::size_t>(i)];
+      if (element.timetag != OscParser::kImmediately) {
+        const qint64 dueNs = OscParser::timetagToUnixNs(element.timetag) - wallToMonotonicNs;
+        element.dueNs = dueNs > packet->ingressNs ? dueNs : 0;
+      }
+    }
+    return;
+  }
+
+  packet->parsed = OscParser::parseMessage(data, packet->size, &packet->message) ||
+                   OscParser::parseTextCommand(data, packet->size, &packet->message);
+}
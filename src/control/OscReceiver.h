@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+
+#include <atomic>
+#include <memory>
+
+class OscPacketRing;
+struct OscPacket;
+class QSocketNotifier;
+class QUdpSocket;
+
+// Receives OSC datagrams on the thread it lives on. Each wakeup drains the
+// socket in batches straight into the ring's free slots (recvmmsg on Linux)
+// and parses them there, then wakes the consumer once for the whole batch.
+// When the ring is full, further datagrams are read off the socket and
+// counted as dropped so the kernel buffer never wedges the receiver.
+class OscReceiver : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit OscReceiver(OscPacketRing* ring, QObject* parent = nullptr);
+  ~OscReceiver() override;
+
+  // Must run on the receiver's thread. Port 0 binds an ephemeral port.
+  bool open(quint16 port, QString* errorMessage);
+  void close();
+  quint16 port() const;
+  // Packets dropped since the last call.
+  qint64 takeDropped();
+
+  // Parses a filled slot in place; TCP sessions share it. The offset maps
+  // bundle timetags onto the monotonic clock.
+  static void parse(OscPacket* packet, qint64 wallToMonotonicNs);
+  static qint64 wallToMonotonicNs(qint64 monotonicNs);
+
+ signals:
+  // Emitted once per batch, only when no drain is already on the way.
+  void packetsReady();
+
+ private:
+  struct Batch;
+
+  void readPending();
+  int receiveBatch(int room);
+  void discardPending();
+
+  OscPacketRing* ring_;
+  std::unique_ptr<Batch> batch_;
+#ifdef Q_OS_UNIX
+  int fd_ = -1;
+  QSocketNotifier* notifier_ = nullptr;
+#else
+  QUdpSocket* socket_ = nullptr;
+#endif
+  quint16 port_ = 0;
+  std::atomic<qint64> dropped_{0};
+};
@@ -1,311 +1,473 @@
 #include "control/OscServer.h"
 
-#include <cstring>
+#include <QMetaObject>
+#include <QStringView>
+#include <QThread>
+#include <QTimer>
 
-#include <QtEndian>
-#include <QHostAddress>
-#include <QRegularExpression>
-#include <QUdpSocket>
+#include <array>
+#include <string_view>
+#include <utility>
+
+#include "control/OscParser.h"
+#include "control/OscReceiver.h"
+#include "control/OscTcpServer.h"
+#include "core/Trace.h"
 
 namespace {
 
-bool readPaddedString(const QByteArray& data, int* offset, QString* out) {
-  if (offset == nullptr || out == nullptr || *offset < 0 || *offset >= data.size()) {
-    return false;
-  }
+// Bundles further ahead than this are taken as a sender clock error.
+constexpr qint64 kMaxScheduleAheadNs = 60LL * 1000 * 1000 * 1000;
+constexpr std::size_t kMaxScheduledBundles = 256;
+// Qt timers are millisecond-grained; a bundle this close to due runs now.
+constexpr qint64 kScheduleSlackNs = 1000 * 1000;
+constexpr int kMaxRouteMatches = 16;
+constexpr qint64 kUnknownReportIntervalMs = 1000;
 
-  const int start = *offset;
-  int end = start;
-  while (end < data.size() && data.at(end) != '\0') {
-    ++end;
-  }
+QString toQString(std::string_view text) { return QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size())); }
 
-  if (end >= data.size()) {
+// Timecode strings are short ASCII; widen them on the stack for the parser.
+bool parseTimecodeArg(std::string_view text, Timecode* timecode, int fps) {
+  std::array<char16_t, 32> wide{};
+  if (text.size() > wide.size()) {
     return false;
   }
+  for (std::size_t i = 0; i < text.size(); ++i) {
+    wide[i] = static_cast<unsigned char>(text[i]);
+  }
+  return Timecode::parse(QStringView(wide.data(), static_cast<qsizetype>(text.size())), timecode, fps);
+}
 
-  *out = QString::fromUtf8(data.constData() + start, end - start);
-
-  int aligned = end + 1;
-  while (aligned % 4 != 0) {
-    ++aligned;
+// Host and port from the arguments, else the sender's own. A TCP sender
+// naming neither, or port 0, is answered on its session. nextArg is the
+// first argument after them.
+bool readFeedbackPeer(const OscMessageView& message, const OscSender& sender, QHostAddress* host, quint16* port,
+                      quint32* session, int* nextArg) {
+  using Type = OscArgumentView::Type;
+
+  int index = 0;
+  bool named = false;
+  if (message.hasArg(0, Type::String)) {
+    *host = QHostAddress(toQString(message.args[0].stringValue));
+    index = 1;
+    named = true;
+  } else if (sender.address != 0) {
+    *host = QHostAddress(sender.address);
   }
 
-  if (aligned > data.size()) {
+  int value = sender.port;
+  if (message.hasArg(index, Type::Int)) {
+    value = message.args[static_cast<std::size_t>(index)].intValue;
+    ++index;
+    named = named || value != 0;
+  }
+  *nextArg = index;
+  *session = 0;
+  if (sender.session != 0 && !named) {
+    *host = QHostAddress(sender.address);
+    *port = sender.port;
+    *session = sender.session;
+    return true;
+  }
+  if (host->isNull() || value <= 0 || value > 65535) {
     return false;
   }
-
-  *offset = aligned;
+  *port = static_cast<quint16>(value);
   return true;
 }
 
-int extractTrailingRow(const QString& address) {
-  const QStringList segments = address.split('/', Qt::SkipEmptyParts);
-  if (segments.isEmpty()) {
-    return -1;
+}  // namespace
+
+OscServer::OscServer(QObject* parent)
+    : QObject(parent),
+      ring_(std::make_unique<OscPacketRing>()),
+      ioThread_(new QThread(this)),
+      receiver_(new OscReceiver(ring_.get())),
+      tcp_(new OscTcpServer(ring_.get())),
+      scheduleTimer_(new QTimer(this)) {
+  scheduleTimer_->setSingleShot(true);
+  scheduleTimer_->setTimerType(Qt::PreciseTimer);
+  connect(scheduleTimer_, &QTimer::timeout, this, &OscServer::runScheduled);
+
+  const std::pair<std::string_view, Route> routes[] = {
+      {"/cue/play", Route::PlayRow},
+      {"/cue/play/<row>", Route::PlayRow},
+      {"/cue/preview", Route::PreviewRow},
+      {"/cue/preview/<row>", Route::PreviewRow},
+      {"/cue/preload", Route::PreloadRow},
+      {"/cue/preload/<row>", Route::PreloadRow},
+      {"/cue/take", Route::Take},
+      {"/take", Route::Take},
+      {"/cue/stop_all", Route::StopAll},
+      {"/stop_all", Route::StopAll},
+      {"/timecode", Route::Timecode},
+      {"/tc", Route::Timecode},
+      {"/dmx", Route::Dmx},
+      {"/text", Route::Text},
+      {"/overlay/text", Route::Text},
+      {"/cue/id/<id>/go", Route::CueIdGo},
+      {"/cue/id/<id>/preload", Route::CueIdPreload},
+      {"/layer/<screen>/<layer>/stop", Route::LayerStop},
+      {"/feedback/subscribe", Route::FeedbackSubscribe},
+      {"/feedback/unsubscribe", Route::FeedbackUnsubscribe},
+  };
+  for (const auto& [address, route] : routes) {
+    addressSpace_.addRoute(address, static_cast<int>(route));
   }
 
-  bool ok = false;
-  const int row = segments.last().toInt(&ok);
-  return ok ? row : -1;
+  ioThread_->setObjectName("OSC I/O");
+  receiver_->moveToThread(ioThread_);
+  connect(ioThread_, &QThread::finished, receiver_, &QObject::deleteLater);
+  connect(receiver_, &OscReceiver::packetsReady, this, &OscServer::drainPackets, Qt::QueuedConnection);
+  tcp_->moveToThread(ioThread_);
+  connect(ioThread_, &QThread::finished, tcp_, &QObject::deleteLater);
+  connect(tcp_, &OscTcpServer::packetsReady, this, &OscServer::drainPackets, Qt::QueuedConnection);
+  connect(tcp_, &OscTcpServer::sessionClosed, this, &OscServer::sessionClosed, Qt::QueuedConnection);
+  ioThread_->start();
 }
 
-}  // namespace
-
-OscServer::OscServer(QObject* parent) : QObject(parent), socket_(new QUdpSocket(this)) {
-  connect(socket_, &QUdpSocket::readyRead, this, &OscServer::readPendingDatagrams);
+OscServer::~OscServer() {
+  QMetaObject::invokeMethod(receiver_, [receiver = receiver_]() { receiver->close(); }, Qt::BlockingQueuedConnection);
+  QMetaObject::invokeMethod(tcp_, [tcp = tcp_]() { tcp->close(); }, Qt::BlockingQueuedConnection);
+  ioThread_->quit();
+  ioThread_->wait();
 }
 
 bool OscServer::start(quint16 port) {
   stop();
 
-  if (!socket_->bind(QHostAddress::AnyIPv4, port, QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint)) {
-    emit statusMessage(QString("OSC bind failed on port %1: %2").arg(port).arg(socket_->errorString()));
+  bool ok = false;
+  QString error;
+  QMetaObject::invokeMethod(
+      receiver_, [&, receiver = receiver_]() { ok = receiver->open(port, &error); }, Qt::BlockingQueuedConnection);
+  if (!ok) {
+    emit statusMessage(QString("OSC bind failed on port %1: %2").arg(port).arg(error));
     return false;
   }
 
-  port_ = port;
-  emit statusMessage(QString("OSC listening on UDP %1").arg(port_));
+  port_ = receiver_->port();
+
+  // TCP shares the UDP port; without it UDP still serves.
+  QMetaObject::invokeMethod(
+      tcp_, [&, tcp = tcp_]() { tcpListening_ = tcp->listen(port_, &error); }, Qt::BlockingQueuedConnection);
+  if (!tcpListening_) {
+    emit statusMessage(QString("OSC listening on UDP %1; TCP listen failed: %2").arg(port_).arg(error));
+    return true;
+  }
+  emit statusMessage(QString("OSC listening on UDP and TCP %1").arg(port_));
   return true;
 }
 
 void OscServer::stop() {
-  if (socket_->state() == QAbstractSocket::BoundState) {
-    socket_->close();
-    emit statusMessage("OSC stopped.");
+  scheduled_.clear();
+  scheduleTimer_->stop();
+  if (port_ == 0) {
+    return;
   }
+
+  QMetaObject::invokeMethod(receiver_, [receiver = receiver_]() { receiver->close(); }, Qt::BlockingQueuedConnection);
+  QMetaObject::invokeMethod(tcp_, [tcp = tcp_]() { tcp->close(); }, Qt::BlockingQueuedConnection);
   port_ = 0;
+  tcpListening_ = false;
+  emit statusMessage("OSC stopped.");
 }
 
 quint16 OscServer::port() const { return port_; }
 
-void OscServer::readPendingDatagrams() {
-  while (socket_->hasPendingDatagrams()) {
-    QByteArray datagram;
-    datagram.resize(static_cast<int>(socket_->pendingDatagramSize()));
-    socket_->readDatagram(datagram.data(), datagram.size());
-
-    OscMessage message;
-    if (!parseOscPacket(datagram, &message) && !parseTextCommand(datagram, &message)) {
-      emit statusMessage("Received unsupported OSC packet.");
-      continue;
-    }
+bool OscServer::tcpListening() const { return tcpListening_; }
 
-    dispatch(message);
-  }
+void OscServer::sendToSession(quint32 session, const QByteArray& packet) {
+  QMetaObject::invokeMethod(tcp_, [tcp = tcp_, session, packet]() { tcp->send(session, packet); });
 }
 
-bool OscServer::parseOscPacket(const QByteArray& datagram, OscMessage* message) {
-  if (message == nullptr || datagram.isEmpty() || datagram.at(0) != '/') {
-    return false;
-  }
+quint64 OscServer::unknownAddressCount() const { return unknownAddresses_; }
 
-  int offset = 0;
-  if (!readPaddedString(datagram, &offset, &message->address)) {
-    return false;
+void OscServer::drainPackets() {
+  // A handler that spins a nested event loop must not pop the packet the
+  // outer drain is still dispatching. The outer drain goes round again
+  // instead, clearing the drain flag the producer claimed for the nested
+  // call, so nothing is stranded in the ring.
+  if (draining_) {
+    redrainRequested_ = true;
+    return;
   }
+  draining_ = true;
+
+  do {
+    redrainRequested_ = false;
+    ring_->clearDrainScheduled();
+    while (OscPacket* packet = ring_->front()) {
+      if (packet->parsed && packet->isBundle) {
+        runBundle(*packet);
+      } else if (packet->parsed) {
+        const TraceScope trace("control", "oscDispatch");
+        dispatch(packet->message, TriggerStamp{TriggerSource::Osc, packet->ingressNs}, packet->sender);
+      } else if (packet->size > OscPacket::kCapacity && packet->spill.isEmpty()) {
+        emit statusMessage(QString("Dropped OSC packet larger than %1 bytes.").arg(OscPacket::kCapacity));
+      } else {
+        emit statusMessage("Received unsupported OSC packet.");
+      }
+      ring_->pop();
+    }
+  } while (redrainRequested_);
 
-  QString typeTags;
-  if (!readPaddedString(datagram, &offset, &typeTags)) {
-    return false;
+  const qint64 dropped = receiver_->takeDropped();
+  if (dropped > 0) {
+    emit statusMessage(QString("OSC queue full: dropped %1 packet(s).").arg(dropped));
   }
-
-  if (!typeTags.startsWith(',')) {
-    return false;
+  const qint64 tcpDropped = tcp_->takeDropped();
+  if (tcpDropped > 0) {
+    emit statusMessage(QString("OSC TCP: dropped %1 oversized frame(s) or undeliverable reply(ies).").arg(tcpDropped));
   }
+  draining_ = false;
+}
 
-  message->args.clear();
-
-  for (int i = 1; i < typeTags.size(); ++i) {
-    const QChar type = typeTags.at(i);
-    OscArgument arg;
-
-    if (type == 'i') {
-      if (offset + 4 > datagram.size()) {
-        return false;
-      }
-      arg.type = OscArgument::Type::Int;
-      arg.intValue = static_cast<int>(qFromBigEndian<qint32>(reinterpret_cast<const uchar*>(datagram.constData() + offset)));
-      offset += 4;
-      message->args.push_back(arg);
+void OscServer::runBundle(const OscPacket& packet) {
+  const TraceScope trace("control", "oscBundle");
+  const OscBundleView& bundle = packet.bundle;
+  const qint64 nowNs = monotonicNowNs();
+
+  // Everything already due runs now, in wire order, before anything else.
+  const TriggerStamp stamp{TriggerSource::Osc, packet.ingressNs};
+  std::array<bool, OscBundleView::kMaxMessages> handled{};
+  beginBundleGo();
+  for (int i = 0; i < bundle.messageCount; ++i) {
+    const OscBundleElement& element = bundle.messages[static_cast<std::size_t>(i)];
+    if (element.dueNs > nowNs + kScheduleSlackNs) {
       continue;
     }
+    handled[static_cast<std::size_t>(i)] = true;
+    OscMessageView message;
+    if (OscParser::parseMessage(element.bytes.data(), static_cast<int>(element.bytes.size()), &message)) {
+      dispatch(message, stamp, packet.sender);
+    }
+  }
+  endBundleGo(stamp);
 
-    if (type == 'f') {
-      if (offset + 4 > datagram.size()) {
-        return false;
-      }
-      arg.type = OscArgument::Type::Float;
-      quint32 raw = qFromBigEndian<quint32>(reinterpret_cast<const uchar*>(datagram.constData() + offset));
-      float value;
-      static_assert(sizeof(float) == sizeof(quint32), "Unexpected float size");
-      std::memcpy(&value, &raw, sizeof(float));
-      arg.floatValue = value;
-      offset += 4;
-      message->args.push_back(arg);
+  // The rest is held, one entry per distinct due time.
+  for (int i = 0; i < bundle.messageCount; ++i) {
+    if (handled[static_cast<std::size_t>(i)]) {
       continue;
     }
-
-    if (type == 's') {
-      arg.type = OscArgument::Type::String;
-      if (!readPaddedString(datagram, &offset, &arg.stringValue)) {
-        return false;
+    const qint64 dueNs = bundle.messages[static_cast<std::size_t>(i)].dueNs;
+    ScheduledBundle scheduled;
+    scheduled.sender = packet.sender;
+    for (int j = i; j < bundle.messageCount; ++j) {
+      const OscBundleElement& element = bundle.messages[static_cast<std::size_t>(j)];
+      if (!handled[static_cast<std::size_t>(j)] && element.dueNs == dueNs) {
+        handled[static_cast<std::size_t>(j)] = true;
+        scheduled.bytes.append(element.bytes.data(), static_cast<qsizetype>(element.bytes.size()));
+        scheduled.sizes.push_back(static_cast<int>(element.bytes.size()));
       }
-      message->args.push_back(arg);
-      continue;
     }
 
-    return false;
+    if (dueNs - nowNs > kMaxScheduleAheadNs) {
+      emit statusMessage(QString("Dropped OSC bundle timetagged %1 s ahead.").arg((dueNs - nowNs) / 1000000000LL));
+      continue;
+    }
+    if (scheduled_.size() >= kMaxScheduledBundles) {
+      emit statusMessage(QString("Dropped OSC bundle: %1 already scheduled.").arg(kMaxScheduledBundles));
+      continue;
+    }
+    scheduled_.emplace(dueNs, std::move(scheduled));
   }
-
-  return true;
+  armScheduleTimer();
 }
 
-bool OscServer::parseTextCommand(const QByteArray& datagram, OscMessage* message) {
-  if (message == nullptr) {
-    return false;
-  }
-
-  const QString line = QString::fromUtf8(datagram).trimmed();
-  if (line.isEmpty()) {
-    return false;
+void OscServer::runScheduled() {
+  while (!scheduled_.empty() && scheduled_.begin()->first <= monotonicNowNs() + kScheduleSlackNs) {
+    auto node = scheduled_.extract(scheduled_.begin());
+    // Stamped at the due time: the wait was asked for, so it is not latency.
+    const TraceScope trace("control", "oscScheduledBundle");
+    dispatchBundle(node.mapped(), TriggerStamp{TriggerSource::Osc, node.key()});
   }
+  armScheduleTimer();
+}
 
-  const QStringList parts = line.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
-  if (parts.isEmpty()) {
-    return false;
+void OscServer::armScheduleTimer() {
+  if (scheduled_.empty()) {
+    scheduleTimer_->stop();
+    return;
   }
+  const qint64 waitNs = scheduled_.begin()->first - monotonicNowNs();
+  scheduleTimer_->start(static_cast<int>(qMax<qint64>(0, waitNs / 1000000)));
+}
 
-  OscMessage parsed;
-  QString command = parts.first().toLower();
-
-  if (!command.startsWith('/')) {
-    if (command == "play") {
-      command = "/cue/play";
-    } else if (command == "preview") {
-      command = "/cue/preview";
-    } else if (command == "preload") {
-      command = "/cue/preload";
-    } else if (command == "take") {
-      command = "/cue/take";
-    } else if (command == "stopall") {
-      command = "/cue/stop_all";
-    } else if (command == "timecode") {
-      command = "/timecode";
-    } else if (command == "dmx") {
-      command = "/dmx";
-    } else if (command == "text") {
-      command = "/text";
-    } else {
-      return false;
+void OscServer::dispatchBundle(const ScheduledBundle& bundle, const TriggerStamp& stamp) {
+  beginBundleGo();
+  int offset = 0;
+  for (const int size : bundle.sizes) {
+    OscMessageView message;
+    if (OscParser::parseMessage(bundle.bytes.constData() + offset, size, &message)) {
+      dispatch(message, stamp, bundle.sender);
     }
+    offset += size;
   }
+  endBundleGo(stamp);
+}
 
-  parsed.address = command;
+void OscServer::beginBundleGo() {
+  // A bundle run from a nested event loop adds its GOs to the outer one's.
+  if (bundleDepth_++ == 0) {
+    bundleGoRows_.clear();
+    bundleGoCueIds_.clear();
+  }
+}
 
-  if (parsed.address == "/text") {
-    OscArgument arg;
-    arg.type = OscArgument::Type::String;
-    arg.stringValue = parts.mid(1).join(' ');
-    if (!arg.stringValue.isNull()) {
-      parsed.args.push_back(arg);
-    }
-    *message = parsed;
-    return true;
+void OscServer::endBundleGo(const TriggerStamp& stamp) {
+  if (--bundleDepth_ > 0) {
+    return;
   }
+  // Taken out first: the handlers may run another bundle.
+  const QVector<int> rows = std::exchange(bundleGoRows_, {});
+  const QStringList cueIds = std::exchange(bundleGoCueIds_, {});
+  if (rows.size() + cueIds.size() > 1) {
+    emit playGroupRequested(rows, cueIds, stamp);
+  } else if (rows.size() == 1) {
+    emit playRowRequested(rows.first(), stamp);
+  } else if (cueIds.size() == 1) {
+    emit playCueIdRequested(cueIds.first(), stamp);
+  }
+}
 
-  for (int i = 1; i < parts.size(); ++i) {
-    const QString token = parts.at(i);
-    bool ok = false;
-    const int value = token.toInt(&ok);
-    OscArgument arg;
-    if (ok) {
-      arg.type = OscArgument::Type::Int;
-      arg.intValue = value;
-    } else {
-      arg.type = OscArgument::Type::String;
-      arg.stringValue = token;
-    }
-    parsed.args.push_back(arg);
+void OscServer::dispatch(const OscMessageView& message, const TriggerStamp& stamp, const OscSender& sender) {
+  // A pattern address may reach several routes; each runs in trie order.
+  std::array<OscRouteMatch, kMaxRouteMatches> matches;
+  const int count = addressSpace_.match(message.address, matches.data(), kMaxRouteMatches);
+  if (count == 0) {
+    noteUnknownAddress(message.address);
+    return;
   }
 
-  *message = parsed;
-  return true;
+  for (int i = 0; i < count; ++i) {
+    dispatchRoute(matches[static_cast<std::size_t>(i)], message, stamp, sender);
+  }
 }
 
-void OscServer::dispatch(const OscMessage& message) {
-  auto readRowArg = [&message]() -> int {
-    if (!message.args.isEmpty() && message.args.first().type == OscArgument::Type::Int) {
-      return message.args.first().intValue;
+void OscServer::dispatchRoute(const OscRouteMatch& match, const OscMessageView& message, const TriggerStamp& stamp,
+                              const OscSender& sender) {
+  using Type = OscArgumentView::Type;
+
+  // An int argument wins over a row given in the address.
+  auto readRowArg = [&match, &message]() -> int {
+    if (message.hasArg(0, Type::Int)) {
+      return message.args[0].intValue;
     }
-    return extractTrailingRow(message.address);
+    qint32 row = -1;
+    return match.captureCount > 0 && OscParser::parseInt(match.captures[0], &row) ? row : -1;
   };
 
-  if (message.address.startsWith("/cue/play")) {
-    const int row = readRowArg();
-    if (row >= 0) {
-      emit playRowRequested(row);
+  switch (static_cast<Route>(match.route)) {
+    case Route::PlayRow: {
+      const int row = readRowArg();
+      if (row >= 0 && bundleDepth_ > 0) {
+        bundleGoRows_.push_back(row);
+      } else if (row >= 0) {
+        emit playRowRequested(row, stamp);
+      }
+      return;
     }
-    return;
-  }
-
-  if (message.address.startsWith("/cue/preview")) {
-    const int row = readRowArg();
-    if (row >= 0) {
-      emit previewRowRequested(row);
+    case Route::PreviewRow: {
+      const int row = readRowArg();
+      if (row >= 0) {
+        emit previewRowRequested(row);
+      }
+      return;
     }
-    return;
-  }
-
-  if (message.address.startsWith("/cue/preload")) {
-    const int row = readRowArg();
-    if (row >= 0) {
-      emit preloadRowRequested(row);
+    case Route::PreloadRow: {
+      const int row = readRowArg();
+      if (row >= 0) {
+        emit preloadRowRequested(row);
+      }
+      return;
     }
-    return;
-  }
-
-  if (message.address == "/cue/take" || message.address == "/take") {
-    emit takeRequested();
-    return;
-  }
+    case Route::Take:
+      emit takeRequested(stamp);
+      return;
+    case Route::StopAll:
+      emit stopAllRequested();
+      return;
+    case Route::Timecode: {
+      if (message.argCount == 0) {
+        return;
+      }
 
-  if (message.address == "/cue/stop_all" || message.address == "/stop_all") {
-    emit stopAllRequested();
-    return;
-  }
+      // An optional second argument gives the frame rate; an int first
+      // argument is frames since midnight.
+      const int fps = message.hasArg(1, Type::Int) ? message.args[1].intValue : Timecode::kDefaultFps;
 
-  if (message.address == "/timecode" || message.address == "/tc") {
-    if (!message.args.isEmpty()) {
-      if (message.args.first().type == OscArgument::Type::String) {
-        emit timecodeReceived(message.args.first().stringValue);
-      } else if (message.args.first().type == OscArgument::Type::Int) {
-        emit timecodeReceived(QString::number(message.args.first().intValue));
+      Timecode timecode;
+      if (message.hasArg(0, Type::String)) {
+        parseTimecodeArg(message.args[0].stringValue, &timecode, fps);
+      } else if (message.hasArg(0, Type::Int)) {
+        timecode = Timecode::fromFrames(message.args[0].intValue, fps);
       }
+      if (timecode.isValid()) {
+        emit timecodeReceived(timecode);
+      }
+      return;
     }
-    return;
-  }
-
-  if (message.address == "/dmx") {
-    if (message.args.size() >= 2 && message.args.at(0).type == OscArgument::Type::Int &&
-        message.args.at(1).type == OscArgument::Type::Int) {
-      emit dmxValueReceived(message.args.at(0).intValue, message.args.at(1).intValue);
+    case Route::Dmx:
+      if (message.hasArg(0, Type::Int) && message.hasArg(1, Type::Int)) {
+        emit dmxValueReceived(message.args[0].intValue, message.args[1].intValue, stamp);
+      }
+      return;
+    case Route::Text:
+      if (message.hasArg(0, Type::String)) {
+        emit overlayTextReceived(toQString(message.args[0].stringValue));
+      } else if (message.hasArg(0, Type::Int)) {
+        emit overlayTextReceived(QString::number(message.args[0].intValue));
+      } else if (message.argCount == 0) {
+        emit overlayTextReceived(QString());
+      }
+      return;
+    case Route::CueIdGo:
+      if (bundleDepth_ > 0) {
+        bundleGoCueIds_.push_back(toQString(match.captures[0]));
+      } else {
+        emit playCueIdRequested(toQString(match.captures[0]), stamp);
+      }
+      return;
+    case Route::CueIdPreload:
+      emit preloadCueIdRequested(toQString(match.captures[0]));
+      return;
+    case Route::LayerStop: {
+      qint32 screenIndex = -1;
+      qint32 layer = -1;
+      if (OscParser::parseInt(match.captures[0], &screenIndex) && OscParser::parseInt(match.captures[1], &layer)) {
+        emit stopLayerRequested(screenIndex, layer);
+      }
+      return;
     }
-    return;
-  }
-
-  if (message.address == "/text" || message.address == "/overlay/text") {
-    if (!message.args.isEmpty()) {
-      if (message.args.first().type == OscArgument::Type::String) {
-        emit overlayTextReceived(message.args.first().stringValue);
-      } else if (message.args.first().type == OscArgument::Type::Int) {
-        emit overlayTextReceived(QString::number(message.args.first().intValue));
+    case Route::FeedbackSubscribe:
+    case Route::FeedbackUnsubscribe: {
+      QHostAddress host;
+      quint16 port = 0;
+      quint32 session = 0;
+      int nextArg = 0;
+      if (!readFeedbackPeer(message, sender, &host, &port, &session, &nextArg)) {
+        emit statusMessage("OSC feedback request needs a host and port.");
+        return;
+      }
+      if (static_cast<Route>(match.route) == Route::FeedbackUnsubscribe) {
+        emit feedbackUnsubscribeRequested(host, port, session);
+        return;
       }
-    } else {
-      emit overlayTextReceived(QString());
+      const int maxRateHz = message.hasArg(nextArg, OscArgumentView::Type::Int)
+                                ? message.args[static_cast<std::size_t>(nextArg)].intValue
+                                : 0;
+      emit feedbackSubscribeRequested(host, port, session, maxRateHz);
+      return;
     }
-    return;
   }
+}
 
-  emit statusMessage(QString("Unhandled OSC address: %1").arg(message.address));
+void OscServer::noteUnknownAddress(std::string_view address) {
+  ++unknownAddresses_;
+  if (unknownReportTimer_.isValid() && unknownReportTimer_.elapsed() < kUnknownReportIntervalMs) {
+    return;
+  }
+  unknownReportTimer_.start();
+  emit statusMessage(
+      QString("Unhandled OSC address: %1 (%2 unhandled so far)").arg(toQString(address)).arg(unknownAddresses_));
 }
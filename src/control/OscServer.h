@@ -1,52 +1,125 @@
 #pragma once
 
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHostAddress>
 #include <QObject>
 #include <QString>
+#include <QStringList>
 #include <QVector>
 
-class QUdpSocket;
+#include <map>
+#include <memory>
+#include <string_view>
 
+#include "control/OscAddressSpace.h"
+#include "control/OscPacketRing.h"
+#include "core/Timecode.h"
+#include "core/TriggerStamp.h"
+
+class OscReceiver;
+class OscTcpServer;
+class QThread;
+class QTimer;
+
+// OSC and plain-text control over UDP, and over SLIP-framed TCP sessions on
+// the same port. Packets are received and parsed on a dedicated I/O thread
+// (see OscReceiver and OscTcpServer) and handed over through one lock-free
+// ring; the GUI thread only dispatches them, a batch per wakeup.
+// The messages of a bundle run back to back in one go; a bundle timetagged
+// in the future is held and run when it falls due on the monotonic clock.
+// The GOs in a bundle (by row or cue id) are collected while it runs and
+// leave together as one grouped GO once its other messages are done.
 class OscServer : public QObject {
   Q_OBJECT
 
  public:
   explicit OscServer(QObject* parent = nullptr);
+  ~OscServer() override;
 
+  // Port 0 picks a free port; port() reports the one bound.
   bool start(quint16 port);
   void stop();
   quint16 port() const;
+  bool tcpListening() const;
+  // Thread-safe; SLIP-frames packet onto an open TCP session.
+  void sendToSession(quint32 session, const QByteArray& packet);
+  // Messages whose address matched no route since startup.
+  quint64 unknownAddressCount() const;
 
  signals:
-  void playRowRequested(int row);
+  void playRowRequested(int row, const TriggerStamp& stamp);
   void previewRowRequested(int row);
   void preloadRowRequested(int row);
-  void takeRequested();
+  void takeRequested(const TriggerStamp& stamp);
   void stopAllRequested();
-  void timecodeReceived(const QString& timecode);
-  void dmxValueReceived(int channel, int value);
+  void timecodeReceived(const Timecode& timecode);
+  void dmxValueReceived(int channel, int value, const TriggerStamp& stamp);
   void overlayTextReceived(const QString& text);
+  void playCueIdRequested(const QString& cueId, const TriggerStamp& stamp);
+  // More than one GO arrived in a bundle; rows and cue ids start together.
+  void playGroupRequested(const QVector<int>& rows, const QStringList& cueIds, const TriggerStamp& stamp);
+  void preloadCueIdRequested(const QString& cueId);
+  void stopLayerRequested(int screenIndex, int layer);
+  // session is the TCP session to reply on, or 0 to send to host and port
+  // over UDP. maxRateHz 0 keeps the publisher's default position rate.
+  void feedbackSubscribeRequested(const QHostAddress& host, quint16 port, quint32 session, int maxRateHz);
+  void feedbackUnsubscribeRequested(const QHostAddress& host, quint16 port, quint32 session);
+  void sessionClosed(quint32 session);
   void statusMessage(const QString& message);
 
- private slots:
-  void readPendingDatagrams();
-
  private:
-  struct OscArgument {
-    enum class Type { Int, Float, String } type = Type::String;
-    int intValue = 0;
-    float floatValue = 0.0f;
-    QString stringValue;
+  enum class Route {
+    PlayRow,
+    PreviewRow,
+    PreloadRow,
+    Take,
+    StopAll,
+    Timecode,
+    Dmx,
+    Text,
+    CueIdGo,
+    CueIdPreload,
+    LayerStop,
+    FeedbackSubscribe,
+    FeedbackUnsubscribe,
   };
 
-  struct OscMessage {
-    QString address;
-    QVector<OscArgument> args;
+  // Messages sharing a due time, copied out of the ring slot.
+  struct ScheduledBundle {
+    QByteArray bytes;
+    QVector<int> sizes;
+    OscSender sender;
   };
 
-  static bool parseOscPacket(const QByteArray& datagram, OscMessage* message);
-  static bool parseTextCommand(const QByteArray& datagram, OscMessage* message);
-  void dispatch(const OscMessage& message);
+  void drainPackets();
+  void runBundle(const OscPacket& packet);
+  void runScheduled();
+  void armScheduleTimer();
+  void dispatchBundle(const ScheduledBundle& bundle, const TriggerStamp& stamp);
+  void beginBundleGo();
+  void endBundleGo(const TriggerStamp& stamp);
+  void dispatch(const OscMessageView& message, const TriggerStamp& stamp, const OscSender& sender);
+  void dispatchRoute(const OscRouteMatch& match, const OscMessageView& message, const TriggerStamp& stamp,
+                     const OscSender& sender);
+  void noteUnknownAddress(std::string_view address);
 
-  QUdpSocket* socket_;
+  std::unique_ptr<OscPacketRing> ring_;
+  QThread* ioThread_;
+  OscReceiver* receiver_;
+  OscTcpServer* tcp_;
+  // Keyed by monotonic due time; equal keys keep arrival order.
+  std::multimap<qint64, ScheduledBundle> scheduled_;
+  QTimer* scheduleTimer_;
+  OscAddressSpace addressSpace_;
+  quint64 unknownAddresses_ = 0;
+  QElapsedTimer unknownReportTimer_;
   quint16 port_ = 0;
+  bool tcpListening_ = false;
+  // Non-zero while a bundle runs; its GOs gather here instead of going out.
+  int bundleDepth_ = 0;
+  QVector<int> bundleGoRows_;
+  QStringList bundleGoCueIds_;
+  bool draining_ = false;
+  bool redrainRequested_ = false;
 };
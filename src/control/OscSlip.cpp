@@ -0,0 +1,85 @@
+#include "control/OscSlip.h"
+
+namespace {
+
+constexpr char kEnd = static_cast<char>(0xC0);
+constexpr char kEsc = static_cast<char>(0xDB);
+constexpr char kEscEnd = static_cast<char>(0xDC);
+constexpr char kEscEsc = static_cast<char>(0xDD);
+
+}  // namespace
+
+int OscSlipDecoder::feed(const char* data, int size, bool* frameReady) {
+  *frameReady = false;
+  if (complete_) {
+    // Keeps the capacity, so steady traffic stops allocating.
+    frame_.resize(0);
+    complete_ = false;
+  }
+
+  for (int i = 0; i < size; ++i) {
+    const char c = data[i];
+    if (c == kEnd) {
+      escaped_ = false;
+      if (oversized_) {
+        oversized_ = false;
+        frame_.resize(0);
+        continue;
+      }
+      if (!frame_.isEmpty()) {
+        complete_ = true;
+        *frameReady = true;
+        return i + 1;
+      }
+      continue;
+    }
+
+    if (oversized_) {
+      continue;
+    }
+
+    char byte = c;
+    if (escaped_) {
+      escaped_ = false;
+      // A protocol violation; keep the byte rather than lose the frame.
+      byte = c == kEscEnd ? kEnd : c == kEscEsc ? kEsc : c;
+    } else if (c == kEsc) {
+      escaped_ = true;
+      continue;
+    }
+
+    if (frame_.size() >= kMaxFrame) {
+      oversized_ = true;
+      ++oversizedFrames_;
+      frame_.resize(0);
+      continue;
+    }
+    frame_.append(byte);
+  }
+  return size;
+}
+
+const QByteArray& OscSlipDecoder::frame() const { return frame_; }
+
+qint64 OscSlipDecoder::takeOversized() {
+  const qint64 count = oversizedFrames_;
+  oversizedFrames_ = 0;
+  return count;
+}
+
+void OscSlipDecoder::encode(const QByteArray& packet, QByteArray* out) {
+  out->reserve(out->size() + packet.size() + 8);
+  out->append(kEnd);
+  for (const char c : packet) {
+    if (c == kEnd) {
+      out->append(kEsc);
+      out->append(kEscEnd);
+    } else if (c == kEsc) {
+      out->append(kEsc);
+      out->append(kEscEsc);
+    } else {
+      out->append(c);
+    }
+  }
+  out->append(kEnd);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QByteArray>
+
+// SLIP framing for OSC 1.1 over stream transports. Frames are sent
+// double-ended (END, escaped packet, END); empty frames are ignored.
+class OscSlipDecoder {
+ public:
+  static constexpr int kMaxFrame = 64 * 1024;
+
+  // Consumes bytes up to and including the END closing the next frame and
+  // returns how many were used. *frameReady is set when frame() then holds
+  // that frame; it stays valid until the next feed. Frames over kMaxFrame
+  // are skipped and counted.
+  int feed(const char* data, int size, bool* frameReady);
+  const QByteArray& frame() const;
+  qint64 takeOversized();
+
+  static void encode(const QByteArray& packet, QByteArray* out);
+
+ private:
+  QByteArray frame_;
+  bool complete_ = false;
+  bool escaped_ = false;
+  bool oversized_ = false;
+  qint64 oversizedFrames_ = 0;
+};
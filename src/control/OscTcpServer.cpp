@@ -0,0 +1,207 @@
+#include "control/OscTcpServer.h"
+
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include <cstring>
+#include <utility>
+
+#include "control/OscReceiver.h"
+#include "core/Trace.h"
+#include "core/TriggerStamp.h"
+
+namespace {
+
+constexpr qint64 kReadChunkBytes = 64 * 1024;
+// How soon a session paused on a full ring is read again.
+constexpr int kResumeIntervalMs = 2;
+
+}  // namespace
+
+OscTcpServer::OscTcpServer(OscPacketRing* ring, QObject* parent)
+    : QObject(parent), ring_(ring), resumeTimer_(new QTimer(this)) {
+  resumeTimer_->setSingleShot(true);
+  resumeTimer_->setInterval(kResumeIntervalMs);
+  connect(resumeTimer_, &QTimer::timeout, this, &OscTcpServer::resumeBlocked);
+}
+
+OscTcpServer::~OscTcpServer() { close(); }
+
+bool OscTcpServer::listen(quint16 port, QString* errorMessage) {
+  close();
+
+  server_ = new QTcpServer(this);
+  if (!server_->listen(QHostAddress::AnyIPv4, port)) {
+    if (errorMessage != nullptr) {
+      *errorMessage = server_->errorString();
+    }
+    close();
+    return false;
+  }
+
+  port_ = server_->serverPort();
+  connect(server_, &QTcpServer::newConnection, this, &OscTcpServer::acceptSessions);
+  return true;
+}
+
+void OscTcpServer::close() {
+  resumeTimer_->stop();
+  blocked_ = false;
+
+  // Taken first: aborting a socket may emit disconnected synchronously.
+  const QHash<quint32, Session*> sessions = std::exchange(sessions_, {});
+  sessionCount_.store(0, std::memory_order_relaxed);
+  for (Session* session : sessions) {
+    disconnect(session->socket, nullptr, this, nullptr);
+    session->socket->abort();
+    session->socket->deleteLater();
+    emit sessionClosed(session->id);
+    delete session;
+  }
+
+  delete server_;
+  server_ = nullptr;
+  port_ = 0;
+}
+
+quint16 OscTcpServer::port() const { return port_; }
+
+int OscTcpServer::sessionCount() const { return sessionCount_.load(std::memory_order_relaxed); }
+
+void OscTcpServer::send(quint32 session, const QByteArray& packet) {
+  Session* target = sessions_.value(session);
+  if (target == nullptr) {
+    return;
+  }
+  // A controller that stopped reading must not grow our buffer forever.
+  if (target->socket->bytesToWrite() > kMaxPendingWriteBytes) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  encoded_.resize(0);
+  OscSlipDecoder::encode(packet, &encoded_);
+  target->socket->write(encoded_);
+}
+
+qint64 OscTcpServer::takeDropped() { return dropped_.exchange(0, std::memory_order_relaxed); }
+
+void OscTcpServer::acceptSessions() {
+  while (QTcpSocket* socket = server_->nextPendingConnection()) {
+    if (sessions_.size() >= kMaxSessions) {
+      socket->abort();
+      socket->deleteLater();
+      continue;
+    }
+
+    auto* session = new Session;
+    session->id = nextSessionId_++;
+    if (nextSessionId_ == 0) {
+      nextSessionId_ = 1;
+    }
+    session->socket = socket;
+    session->peer = {socket->peerAddress().toIPv4Address(), socket->peerPort(), session->id};
+    socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    sessions_.insert(session->id, session);
+
+    const quint32 id = session->id;
+    connect(socket, &QTcpSocket::readyRead, this, [this, id]() {
+      // A paused session is picked up again by resumeBlocked.
+      Session* ready = sessions_.value(id);
+      if (ready != nullptr && !blocked_ && !readSession(ready)) {
+        blocked_ = true;
+        resumeTimer_->start();
+      }
+    });
+    connect(socket, &QTcpSocket::disconnected, this, [this, id]() { closeSession(id); });
+    emit sessionOpened(id, QString("%1:%2").arg(socket->peerAddress().toString()).arg(socket->peerPort()));
+  }
+  sessionCount_.store(static_cast<int>(sessions_.size()), std::memory_order_relaxed);
+}
+
+void OscTcpServer::closeSession(quint32 id) {
+  Session* session = sessions_.take(id);
+  if (session == nullptr) {
+    return;
+  }
+  session->socket->deleteLater();
+  delete session;
+  sessionCount_.store(static_cast<int>(sessions_.size()), std::memory_order_relaxed);
+  emit sessionClosed(id);
+}
+
+bool OscTcpServer::readSession(Session* session) {
+  const TraceScope trace("control", "oscTcpRead");
+  const qint64 ingressNs = monotonicNowNs();
+  const qint64 wallOffsetNs = OscReceiver::wallToMonotonicNs(ingressNs);
+
+  bool drained = true;
+  int published = 0;
+  while (true) {
+    if (session->inputOffset >= session->input.size()) {
+      const qint64 available = qMin(session->socket->bytesAvailable(), kReadChunkBytes);
+      if (available <= 0) {
+        break;
+      }
+      session->input.resize(available);
+      const qint64 read = session->socket->read(session->input.data(), available);
+      session->input.resize(qMax<qint64>(0, read));
+      session->inputOffset = 0;
+      if (read <= 0) {
+        break;
+      }
+    }
+
+    // Whatever is left stays in the input buffer and the socket.
+    if (ring_->freeSlots() == 0) {
+      drained = false;
+      break;
+    }
+
+    bool frameReady = false;
+    session->inputOffset += session->decoder.feed(session->input.constData() + session->inputOffset,
+                                                  static_cast<int>(session->input.size()) - session->inputOffset,
+                                                  &frameReady);
+    if (frameReady) {
+      publishFrame(session, ingressNs, wallOffsetNs);
+      ++published;
+    }
+  }
+
+  dropped_.fetch_add(session->decoder.takeOversized(), std::memory_order_relaxed);
+  if (published > 0 && !ring_->drainScheduled()) {
+    emit packetsReady();
+  }
+  return drained;
+}
+
+void OscTcpServer::publishFrame(Session* session, qint64 ingressNs, qint64 wallOffsetNs) {
+  const QByteArray& frame = session->decoder.frame();
+  OscPacket& packet = ring_->writable(0);
+  packet.size = static_cast<int>(frame.size());
+  if (packet.size <= OscPacket::kCapacity) {
+    std::memcpy(packet.data, frame.constData(), static_cast<std::size_t>(packet.size));
+    packet.spill.resize(0);
+  } else {
+    // Copied rather than shared so neither buffer reallocates on reuse.
+    packet.spill.resize(packet.size);
+    std::memcpy(packet.spill.data(), frame.constData(), static_cast<std::size_t>(packet.size));
+  }
+  packet.ingressNs = ingressNs;
+  packet.sender = session->peer;
+  OscReceiver::parse(&packet, wallOffsetNs);
+  ring_->publish(1);
+}
+
+void OscTcpServer::resumeBlocked() {
+  blocked_ = false;
+  for (Session* session : std::as_const(sessions_)) {
+    if (!readSession(session)) {
+      blocked_ = true;
+      resumeTimer_->start();
+      return;
+    }
+  }
+}
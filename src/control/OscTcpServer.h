@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QString>
+
+#include <atomic>
+
+#include "control/OscPacketRing.h"
+#include "control/OscSlip.h"
+
+class QTcpServer;
+class QTcpSocket;
+class QTimer;
+
+// OSC 1.1 over TCP: SLIP-framed packets on persistent sessions, living on
+// the OSC I/O thread next to OscReceiver and feeding the same ring, so both
+// transports reach the same dispatcher in arrival order. Frames up to
+// OscSlipDecoder::kMaxFrame are accepted; those over a ring slot spill into
+// the slot's own buffer. A full ring pauses reading instead of dropping:
+// the data waits in the socket and TCP pushes back on the sender.
+class OscTcpServer : public QObject {
+  Q_OBJECT
+
+ public:
+  static constexpr int kMaxSessions = 256;
+  // A session this far behind on replies has them dropped.
+  static constexpr qint64 kMaxPendingWriteBytes = 1 << 20;
+
+  explicit OscTcpServer(OscPacketRing* ring, QObject* parent = nullptr);
+  ~OscTcpServer() override;
+
+  // Must run on the server's thread.
+  bool listen(quint16 port, QString* errorMessage);
+  void close();
+  quint16 port() const;
+  int sessionCount() const;
+  // SLIP-frames packet onto a session; unknown sessions are ignored.
+  void send(quint32 session, const QByteArray& packet);
+  // Frames over the size limit or replies dropped since the last call.
+  qint64 takeDropped();
+
+ signals:
+  void packetsReady();
+  void sessionOpened(quint32 session, const QString& peer);
+  void sessionClosed(quint32 session);
+
+ private:
+  struct Session {
+    quint32 id = 0;
+    QTcpSocket* socket = nullptr;
+    OscSender peer;
+    OscSlipDecoder decoder;
+    QByteArray input;
+    int inputOffset = 0;
+  };
+
+  void acceptSessions();
+  void closeSession(quint32 id);
+  // Decodes what the session has buffered into the ring until either runs
+  // out; returns false if the ring filled first.
+  bool readSession(Session* session);
+  void publishFrame(Session* session, qint64 ingressNs, qint64 wallOffsetNs);
+  void resumeBlocked();
+
+  OscPacketRing* ring_;
+  QTcpServer* server_ = nullptr;
+  QTimer* resumeTimer_;
+  QHash<quint32, Session*> sessions_;
+  QByteArray encoded_;
+  quint32 nextSessionId_ = 1;
+  quint16 port_ = 0;
+  bool blocked_ = false;
+  std::atomic<int> sessionCount_{0};
+  std::atomic<qint64> dropped_{0};
+};
@@ -0,0 +1,38 @@
+#include "control/OscWriter.h"
+
+#include <QtEndian>
+
+#include <cstring>
+
+void OscWriter::begin(std::string_view address, std::string_view typeTags) {
+  // resize(0) keeps the allocation; clear() would free it every message.
+  buffer_.resize(0);
+  appendPadded(address);
+  buffer_.append(',');
+  appendPadded(typeTags);
+}
+
+void OscWriter::addInt(qint32 value) {
+  char raw[4];
+  qToBigEndian(value, raw);
+  buffer_.append(raw, sizeof(raw));
+}
+
+void OscWriter::addFloat(float value) {
+  quint32 bits = 0;
+  static_assert(sizeof(float) == sizeof(quint32), "Unexpected float size");
+  std::memcpy(&bits, &value, sizeof(bits));
+  char raw[4];
+  qToBigEndian(bits, raw);
+  buffer_.append(raw, sizeof(raw));
+}
+
+void OscWriter::addString(std::string_view value) { appendPadded(value); }
+
+const QByteArray& OscWriter::data() const { return buffer_; }
+
+void OscWriter::appendPadded(std::string_view text) {
+  buffer_.append(text.data(), static_cast<qsizetype>(text.size()));
+  // At least one terminating NUL, then up to the next 4-byte boundary.
+  buffer_.append(4 - (buffer_.size() % 4), '\0');
+}
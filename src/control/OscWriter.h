@@ -0,0 +1,22 @@
+#pragma once
+
+#include <QByteArray>
+
+#include <string_view>
+
+// Builds one OSC message at a time into a reused buffer. The type tags are
+// given up front and the add calls must follow them.
+class OscWriter {
+ public:
+  void begin(std::string_view address, std::string_view typeTags);
+  void addInt(qint32 value);
+  void addFloat(float value);
+  void addString(std::string_view value);
+
+  const QByteArray& data() const;
+
+ private:
+  void appendPadded(std::string_view text);
+
+  QByteArray buffer_;
+};
@@ -0,0 +1,180 @@
+#include "control/TimecodeChaseClock.h"
+
+#include <QTimer>
+#include <QtGlobal>
+
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Larger disagreements between a report and the prediction are jumps rather
+// than jitter. MTC reports every two frames, so this leaves headroom.
+constexpr double kJumpFrames = 4.0;
+// A late timer never replays more than this many frames; a longer stall
+// resumes at the current frame.
+constexpr qint64 kMaxCatchUpFrames = 4;
+// Silence longer than this many frames counts as signal loss.
+constexpr double kDropoutFrames = 4.0;
+constexpr qint64 kNoFrame = std::numeric_limits<qint64>::min();
+
+}  // namespace
+
+TimecodeChaseClock::TimecodeChaseClock(QObject* parent)
+    : QObject(parent), frameTimer_(new QTimer(this)), lastEmittedFrames_(kNoFrame) {
+  clock_.start();
+  frameTimer_->setSingleShot(true);
+  frameTimer_->setTimerType(Qt::PreciseTimer);
+  connect(frameTimer_, &QTimer::timeout, this, &TimecodeChaseClock::handleFrameTimer);
+}
+
+void TimecodeChaseClock::setFreewheelMs(int ms) { freewheelMs_ = qMax(0, ms); }
+
+void TimecodeChaseClock::feed(const Timecode& timecode, double elapsedFrames) {
+  if (!timecode.isValid()) {
+    return;
+  }
+
+  const qint64 now = clock_.nsecsElapsed();
+  const double reported = timecode.frames() + elapsedFrames;
+  const bool sameRate = anchor_.fps() == timecode.fps() && anchor_.dropFrame() == timecode.dropFrame();
+
+  if (state_ == State::Stopped || !sameRate) {
+    // First report after silence, or a new rate: park on it and fire it.
+    running_ = false;
+    lastEmittedFrames_ = static_cast<qint64>(std::floor(reported)) - 1;
+  } else {
+    // Compare modulo one day so midnight is not a jump.
+    const qint64 day = timecode.framesPerDay();
+    double error = reported - predictedFrames(now);
+    const qint64 wraps = qRound64(error / day);
+    error -= static_cast<double>(wraps * day);
+
+    if (qAbs(error) > kJumpFrames) {
+      emit jumped(position(), timecode);
+      running_ = false;
+      lastEmittedFrames_ = static_cast<qint64>(std::floor(reported)) - 1;
+    } else {
+      if (lastEmittedFrames_ != kNoFrame) {
+        lastEmittedFrames_ += wraps * day;
+      }
+      // A parked clock starts running once a report shows forward motion.
+      running_ = running_ || error > 0.0;
+    }
+  }
+
+  anchorAt(timecode, elapsedFrames, now);
+  setState(State::Locked);
+  emitDueFrames(now);
+  scheduleNextFrame(now);
+}
+
+void TimecodeChaseClock::locate(const Timecode& timecode) {
+  if (!timecode.isValid()) {
+    return;
+  }
+
+  const Timecode from = position();
+  if (from.isValid() && (from.fps() != timecode.fps() || qAbs(from.frames() - timecode.frames()) > kJumpFrames)) {
+    emit jumped(from, timecode);
+  }
+
+  running_ = false;
+  anchorAt(timecode, 0.0, clock_.nsecsElapsed());
+  frameTimer_->stop();
+  setState(State::Stopped);
+}
+
+TimecodeChaseClock::State TimecodeChaseClock::state() const { return state_; }
+
+Timecode TimecodeChaseClock::position() const {
+  if (!anchor_.isValid()) {
+    return {};
+  }
+  return wrapped(static_cast<qint64>(std::floor(predictedFrames(clock_.nsecsElapsed()))));
+}
+
+double TimecodeChaseClock::predictedFrames(qint64 nowNs) const {
+  const double base = anchor_.frames() + anchorOffsetFrames_;
+  if (!running_ || state_ == State::Stopped) {
+    return base;
+  }
+  return base + static_cast<double>(nowNs - anchorNs_) * anchor_.framesPerSecond() / 1e9;
+}
+
+Timecode TimecodeChaseClock::wrapped(qint64 frames) const {
+  const qint64 day = anchor_.framesPerDay();
+  const qint64 inDay = ((frames % day) + day) % day;
+  return Timecode::fromFrames(static_cast<qint32>(inDay), anchor_.fps(), anchor_.dropFrame());
+}
+
+void TimecodeChaseClock::anchorAt(const Timecode& timecode, double elapsedFrames, qint64 nowNs) {
+  anchor_ = timecode;
+  anchorOffsetFrames_ = elapsedFrames;
+  anchorNs_ = nowNs;
+}
+
+void TimecodeChaseClock::emitDueFrames(qint64 nowNs) {
+  if (state_ == State::Stopped) {
+    return;
+  }
+
+  const qint64 current = static_cast<qint64>(std::floor(predictedFrames(nowNs)));
+  if (lastEmittedFrames_ == kNoFrame || current - lastEmittedFrames_ > kMaxCatchUpFrames) {
+    lastEmittedFrames_ = current - 1;
+  }
+  while (lastEmittedFrames_ < current) {
+    ++lastEmittedFrames_;
+    emit frameReached(wrapped(lastEmittedFrames_));
+  }
+}
+
+void TimecodeChaseClock::handleFrameTimer() {
+  const qint64 now = clock_.nsecsElapsed();
+  const double frameNs = 1e9 / anchor_.framesPerSecond();
+  const double silentNs = static_cast<double>(now - anchorNs_);
+  const double dropoutNs = kDropoutFrames * frameNs;
+
+  if (state_ == State::Locked && silentNs > dropoutNs) {
+    if (running_ && freewheelMs_ > 0) {
+      setState(State::Freewheeling);
+    } else {
+      locate(position());
+      return;
+    }
+  }
+  if (state_ == State::Freewheeling && silentNs > dropoutNs + freewheelMs_ * 1e6) {
+    // Park where the prediction got to, so a later report is judged against it.
+    locate(position());
+    return;
+  }
+
+  emitDueFrames(now);
+  scheduleNextFrame(now);
+}
+
+void TimecodeChaseClock::scheduleNextFrame(qint64 nowNs) {
+  if (state_ == State::Stopped) {
+    frameTimer_->stop();
+    return;
+  }
+
+  const double frameNs = 1e9 / anchor_.framesPerSecond();
+  double waitNs = 0.0;
+  if (running_) {
+    const double predicted = predictedFrames(nowNs);
+    waitNs = (std::floor(predicted) + 1.0 - predicted) * frameNs;
+  } else {
+    // Parked: only the dropout check is pending.
+    waitNs = static_cast<double>(anchorNs_ - nowNs) + kDropoutFrames * frameNs;
+  }
+  frameTimer_->start(qMax(1, static_cast<int>(std::ceil(waitNs / 1e6))));
+}
+
+void TimecodeChaseClock::setState(State state) {
+  if (state_ == state) {
+    return;
+  }
+  state_ = state;
+  emit stateChanged(state_);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+
+#include "core/Timecode.h"
+
+class QTimer;
+
+// Chases an external timecode source (MTC, OSC). Sources report where they
+// are; between reports the clock extrapolates on a monotonic clock and emits
+// every frame at its predicted boundary, so cue triggers do not depend on
+// when a report happens to arrive. A source is only treated as running once
+// a second report confirms the motion. On dropout a running clock freewheels
+// for the configured time before stopping, and a report that disagrees with
+// the prediction by more than a couple of frames is a jump.
+class TimecodeChaseClock : public QObject {
+  Q_OBJECT
+
+ public:
+  enum class State { Stopped, Locked, Freewheeling };
+
+  explicit TimecodeChaseClock(QObject* parent = nullptr);
+
+  void setFreewheelMs(int ms);
+  // The source is at timecode plus elapsedFrames (MTC reports complete a
+  // quarter of a frame before the next boundary).
+  void feed(const Timecode& timecode, double elapsedFrames = 0.0);
+  // A parked position such as an MTC full-frame locate: moves the clock
+  // without firing the frame.
+  void locate(const Timecode& timecode);
+
+  State state() const;
+  Timecode position() const;
+
+ signals:
+  void frameReached(const Timecode& timecode);
+  void jumped(const Timecode& from, const Timecode& to);
+  void stateChanged(TimecodeChaseClock::State state);
+
+ private:
+  double predictedFrames(qint64 nowNs) const;
+  Timecode wrapped(qint64 frames) const;
+  void anchorAt(const Timecode& timecode, double elapsedFrames, qint64 nowNs);
+  void emitDueFrames(qint64 nowNs);
+  void handleFrameTimer();
+  void scheduleNextFrame(qint64 nowNs);
+  void setState(State state);
+
+  QElapsedTimer clock_;
+  QTimer* frameTimer_;
+  int freewheelMs_ = 1000;
+  State state_ = State::Stopped;
+  bool running_ = false;
+
+  // Last report: where the source was and when.
+  Timecode anchor_;
+  double anchorOffsetFrames_ = 0.0;
+  qint64 anchorNs_ = 0;
+  // Unwrapped frame count of the last frameReached, -1 before any.
+  qint64 lastEmittedFrames_ = -1;
+};
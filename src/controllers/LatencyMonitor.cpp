@@ -0,0 +1,97 @@
+#include "controllers/LatencyMonitor.h"
+
+#include <QStringList>
+
+namespace {
+
+constexpr qint64 kNsPerUs = 1000;
+// GOs that never reach air (a failed load on every screen) are dropped after
+// this long instead of being counted when the cue next plays.
+constexpr qint64 kPendingTimeoutNs = 10LL * 1000 * 1000 * 1000;
+
+double toMs(qint64 us) { return us / 1000.0; }
+
+}  // namespace
+
+LatencyMonitor::LatencyMonitor(QObject* parent) : QObject(parent) {}
+
+void LatencyMonitor::begin(const QString& cueId, const TriggerStamp& stamp) {
+  if (!stamp.isValid()) {
+    pending_.remove(cueId);
+    return;
+  }
+  if (cueId.isEmpty()) {
+    return;
+  }
+
+  const qint64 now = monotonicNowNs();
+  for (auto it = pending_.begin(); it != pending_.end();) {
+    if (now - it.value().ingressNs > kPendingTimeoutNs) {
+      it = pending_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  pending_.insert(cueId, stamp);
+}
+
+void LatencyMonitor::cancel(const QString& cueId) { pending_.remove(cueId); }
+
+void LatencyMonitor::complete(const QString& cueId) {
+  const auto it = pending_.constFind(cueId);
+  if (it == pending_.constEnd()) {
+    return;
+  }
+
+  const TriggerStamp stamp = it.value();
+  pending_.erase(it);
+  const qint64 latencyUs = (monotonicNowNs() - stamp.ingressNs) / kNsPerUs;
+  histograms_[static_cast<std::size_t>(stamp.source)].record(latencyUs);
+  emit sampleRecorded(stamp.source, toMs(latencyUs));
+}
+
+void LatencyMonitor::reset() {
+  pending_.clear();
+  for (LatencyHistogram& histogram : histograms_) {
+    histogram.clear();
+  }
+}
+
+QVector<LatencySummary> LatencyMonitor::summaries() const {
+  QVector<LatencySummary> summaries;
+  for (std::size_t i = 0; i < histograms_.size(); ++i) {
+    const LatencyHistogram& histogram = histograms_[i];
+    if (histogram.count() == 0) {
+      continue;
+    }
+
+    LatencySummary summary;
+    summary.source = static_cast<TriggerSource>(i);
+    summary.count = histogram.count();
+    summary.minMs = toMs(histogram.minUs());
+    summary.p50Ms = toMs(histogram.percentileUs(50.0));
+    summary.p95Ms = toMs(histogram.percentileUs(95.0));
+    summary.p99Ms = toMs(histogram.percentileUs(99.0));
+    summary.maxMs = toMs(histogram.maxUs());
+    summary.meanMs = histogram.meanUs() / 1000.0;
+    summaries.push_back(summary);
+  }
+  return summaries;
+}
+
+QString LatencyMonitor::toCsv() const {
+  QStringList lines;
+  lines.push_back("source,count,min_ms,p50_ms,p95_ms,p99_ms,max_ms,mean_ms");
+  for (const LatencySummary& summary : summaries()) {
+    lines.push_back(QString("%1,%2,%3,%4,%5,%6,%7,%8")
+                        .arg(triggerSourceToString(summary.source))
+                        .arg(summary.count)
+                        .arg(summary.minMs, 0, 'f', 3)
+                        .arg(summary.p50Ms, 0, 'f', 3)
+                        .arg(summary.p95Ms, 0, 'f', 3)
+                        .arg(summary.p99Ms, 0, 'f', 3)
+                        .arg(summary.maxMs, 0, 'f', 3)
+                        .arg(summary.meanMs, 0, 'f', 3));
+  }
+  return lines.join('\n') + '\n';
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+#include <array>
+
+#include "core/LatencyHistogram.h"
+#include "core/TriggerStamp.h"
+
+struct LatencySummary {
+  TriggerSource source = TriggerSource::Osc;
+  qint64 count = 0;
+  double minMs = 0.0;
+  double p50Ms = 0.0;
+  double p95Ms = 0.0;
+  double p99Ms = 0.0;
+  double maxMs = 0.0;
+  double meanMs = 0.0;
+};
+
+// Trigger-to-first-frame latency per trigger source. A stamped GO opens a
+// measurement for its cue; the first frame of that cue reaching any layer on
+// air closes it. A take of a preloaded standby counts as on air when the
+// players swap, a fresh load when mpv reports playback restarted.
+class LatencyMonitor : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit LatencyMonitor(QObject* parent = nullptr);
+
+  // A later GO of the same cue replaces its open measurement, or drops it
+  // when that GO is unstamped.
+  void begin(const QString& cueId, const TriggerStamp& stamp);
+  void cancel(const QString& cueId);
+  void complete(const QString& cueId);
+  void reset();
+
+  // Sources with at least one sample, in TriggerSource order.
+  QVector<LatencySummary> summaries() const;
+  QString toCsv() const;
+
+ signals:
+  void sampleRecorded(TriggerSource source, double latencyMs);
+
+ private:
+  QHash<QString, TriggerStamp> pending_;
+  std::array<LatencyHistogram, static_cast<std::size_t>(TriggerSource::Count)> histograms_;
+};
@@ -1,11 +1,19 @@
 #include "controllers/OutputRouter.h"
 
-#include <QSet>
+#include <QGuiApplication>
+#include <QHash>
 #include <QScreen>
+#include <QSet>
+#include <QTimer>
 
+#include <algorithm>
+#include <utility>
+
+#include "core/Trace.h"
 #include "display/DisplayManager.h"
 #include "output/OutputWindow.h"
 #include "output/PreviewWindow.h"
+#include "player/FilterValidator.h"
 
 namespace {
 
@@ -37,10 +45,35 @@ QVector<int> resolveTargetScreens(const Cue& cue, DisplayManager* displayManager
   return {cue.targetScreen};
 }
 
+constexpr int kGroupSkewMeasureTimeoutMs = 2000;
+
 }  // namespace
 
 OutputRouter::OutputRouter(DisplayManager* displayManager, QObject* parent)
-    : QObject(parent), displayManager_(displayManager) {}
+    : QObject(parent),
+      displayManager_(displayManager),
+      frameTimer_(new QTimer(this)),
+      groupTimeoutTimer_(new QTimer(this)),
+      groupReleaseTimer_(new QTimer(this)),
+      groupStartTimer_(new QTimer(this)) {
+  // One clock ticks every running transition, paced to the primary display's
+  // refresh so all outputs step their overlays in the same frame.
+  const QScreen* primary = QGuiApplication::primaryScreen();
+  const double refreshHz = primary != nullptr && primary->refreshRate() > 1.0 ? primary->refreshRate() : 60.0;
+  frameTimer_->setTimerType(Qt::PreciseTimer);
+  frameTimer_->setInterval(qMax(4, qRound(1000.0 / refreshHz)));
+  connect(frameTimer_, &QTimer::timeout, this, &OutputRouter::advanceTransitions);
+  transitionClock_.start();
+
+  groupTimeoutTimer_->setSingleShot(true);
+  connect(groupTimeoutTimer_, &QTimer::timeout, this, &OutputRouter::scheduleGroupRelease);
+  groupReleaseTimer_->setSingleShot(true);
+  groupReleaseTimer_->setTimerType(Qt::PreciseTimer);
+  connect(groupReleaseTimer_, &QTimer::timeout, this, &OutputRouter::releaseGroup);
+  groupStartTimer_->setSingleShot(true);
+  groupStartTimer_->setTimerType(Qt::PreciseTimer);
+  connect(groupStartTimer_, &QTimer::timeout, this, &OutputRouter::startHeldGroup);
+}
 
 OutputRouter::~OutputRouter() {
   for (auto it = windows_.begin(); it != windows_.end(); ++it) {
@@ -50,49 +83,363 @@ OutputRouter::~OutputRouter() {
 }
 
 bool OutputRouter::routeCue(const Cue& cue, TransitionStyle style, int durationMs) {
-  const Cue resolvedCue = applyFilterPreset(cue);
-  const QVector<int> targetScreens = resolveTargetScreens(resolvedCue, displayManager_);
+  const TraceScope trace("output", "routeCue", [&cue]() { return cue.id; });
+  const QVector<int> targetScreens = resolveTargetScreens(cue, displayManager_);
   if (targetScreens.isEmpty()) {
-    emit routingError(QString("No screens available for cue '%1'.").arg(resolvedCue.name));
+    emit routingError(QString("No screens available for cue '%1'.").arg(cue.name));
     return false;
   }
 
-  bool routedAny = false;
-  QSet<int> attempted;
+  if (targetScreens.size() > 1) {
+    return routeCueGroup({{cue, style, durationMs}});
+  }
 
-  for (int screenIndex : targetScreens) {
-    if (attempted.contains(screenIndex)) {
+  OutputWindow* window = ensureWindow(targetScreens.first());
+  if (window == nullptr) {
+    return false;
+  }
+
+  if (!startRoute(cue, {{targetScreens.first(), window}}, style, durationMs, transitionClock_.elapsed())) {
+    return false;
+  }
+
+  emit routingStatus(QString("Program: '%1' on %2 target(s) layer %3").arg(cue.name).arg(1).arg(cue.layer));
+  return true;
+}
+
+bool OutputRouter::routeCueGroup(const QVector<GroupGoEntry>& entries, int readyTimeoutMs) {
+  // Only one grouped GO arms at a time; a newer one sends the pending group
+  // out immediately rather than letting the two interleave.
+  // An earlier group's start skew is still measured, under its own id.
+  if (groupArming_) {
+    releaseGroup();
+  }
+
+  const TraceScope trace("output", "routeCueGroup");
+  QVector<GroupParticipant> participants;
+  for (const GroupGoEntry& entry : entries) {
+    const Cue& cue = entry.cue;
+    const QVector<int> targetScreens = resolveTargetScreens(cue, displayManager_);
+    if (targetScreens.isEmpty()) {
+      emit routingError(QString("No screens available for cue '%1'.").arg(cue.name));
       continue;
     }
-    attempted.insert(screenIndex);
 
-    OutputWindow* window = ensureWindow(screenIndex);
+    for (int screenIndex : targetScreens) {
+      // A later cue for the same screen/layer replaces an earlier one.
+      for (int i = participants.size() - 1; i >= 0; --i) {
+        if (participants.at(i).screenIndex == screenIndex && participants.at(i).cue.layer == cue.layer) {
+          participants.removeAt(i);
+        }
+      }
+
+      GroupParticipant participant;
+      participant.screenIndex = screenIndex;
+      participant.cue = cue;
+      participant.cue.targetScreen = screenIndex;
+      participant.style = entry.style;
+      participant.durationMs = entry.durationMs;
+      participants.push_back(participant);
+    }
+  }
+
+  groupParticipants_.clear();
+  for (GroupParticipant& participant : participants) {
+    OutputWindow* window = ensureWindow(participant.screenIndex);
     if (window == nullptr) {
       continue;
     }
+    if (!window->armCue(participant.cue)) {
+      emit routingError(QString("Failed to arm cue '%1' on screen %2 layer %3.")
+                            .arg(participant.cue.name)
+                            .arg(participant.screenIndex)
+                            .arg(participant.cue.layer));
+      continue;
+    }
+    participant.ready = window->isCueArmed(participant.cue);
+    groupParticipants_.push_back(participant);
+  }
+
+  if (groupParticipants_.isEmpty()) {
+    return false;
+  }
+
+  groupArming_ = true;
+  groupArmStartMs_ = transitionClock_.elapsed();
+  groupStats_ = GroupStartStats();
+  groupStats_.participants = groupParticipants_.size();
+
+  emit routingStatus(QString("Arming %1 participant(s) for grouped GO").arg(groupParticipants_.size()));
+
+  groupTimeoutTimer_->start(qMax(0, readyTimeoutMs));
+  checkGroupReady();
+  return true;
+}
+
+QVector<int> OutputRouter::targetScreens(const Cue& cue) const { return resolveTargetScreens(cue, displayManager_); }
 
-    Cue routedCue = resolvedCue;
+GroupStartStats OutputRouter::lastGroupStartStats() const { return lastGroupStats_; }
+
+bool OutputRouter::startRoute(const Cue& cue, const QVector<QPair<int, OutputWindow*>>& targets,
+                              TransitionStyle style, int durationMs, qint64 startMs) {
+  bool routedAny = false;
+  ActiveTransition active;
+  active.cue = cue;
+
+  for (const auto& [screenIndex, window] : targets) {
+    Cue routedCue = cue;
     routedCue.targetScreen = screenIndex;
-    const bool ok = window->playCueWithTransition(routedCue, style, durationMs);
+    const bool ok = window->beginTransition(routedCue, style, durationMs, startMs);
     if (!ok) {
-      emit routingError(
-          QString("Failed to play cue '%1' on screen %2 layer %3.").arg(resolvedCue.name).arg(screenIndex).arg(cue.layer));
+      emit routingError(QString("Failed to play cue '%1' on screen %2 layer %3.")
+                            .arg(cue.name)
+                            .arg(screenIndex)
+                            .arg(cue.layer));
       continue;
     }
     routedAny = true;
+    if (window->transitionActive()) {
+      active.pendingScreens.insert(screenIndex);
+    }
   }
 
   if (!routedAny) {
     return false;
   }
 
-  emit routingStatus(
-      QString("Program: '%1' on %2 target(s) layer %3").arg(resolvedCue.name).arg(targetScreens.size()).arg(cue.layer));
+  if (active.pendingScreens.isEmpty()) {
+    emit cueTransitionFinished(cue.id, true);
+    return true;
+  }
+
+  activeTransitions_.push_back(active);
+  if (!frameTimer_->isActive()) {
+    frameTimer_->start();
+  }
   return true;
 }
 
+void OutputRouter::handleCueArmed(int screenIndex, const QString& cueId, int layer) {
+  if (!groupArming_) {
+    return;
+  }
+
+  for (GroupParticipant& participant : groupParticipants_) {
+    if (participant.screenIndex == screenIndex && participant.cue.layer == layer && participant.cue.id == cueId) {
+      participant.ready = true;
+    }
+  }
+  checkGroupReady();
+}
+
+void OutputRouter::checkGroupReady() {
+  if (!groupArming_ || groupReleaseTimer_->isActive()) {
+    return;
+  }
+
+  for (const GroupParticipant& participant : groupParticipants_) {
+    if (!participant.ready) {
+      return;
+    }
+  }
+  scheduleGroupRelease();
+}
+
+void OutputRouter::scheduleGroupRelease() {
+  if (!groupArming_) {
+    return;
+  }
+
+  // Release on the next frame boundary rather than inside the callback that
+  // reported the last ready frame, so every take runs from one timer slot.
+  groupTimeoutTimer_->stop();
+  groupReleaseTimer_->start(frameTimer_->interval());
+}
+
+void OutputRouter::releaseGroup() {
+  if (!groupArming_) {
+    return;
+  }
+
+  groupArming_ = false;
+  groupTimeoutTimer_->stop();
+  groupReleaseTimer_->stop();
+  startHeldGroup();
+
+  const qint64 startMs = transitionClock_.elapsed();
+  // Works on a copy: startRoute emits signals, and a handler that routes or
+  // stops again must not change the participants under this loop.
+  const QVector<GroupParticipant> participants = std::exchange(groupParticipants_, {});
+
+  // Participants sharing a cue form one route so cueTransitionFinished still
+  // fires once per cue.
+  int readyBeforeRelease = 0;
+  QVector<QString> cueOrder;
+  QHash<QString, QVector<QPair<int, OutputWindow*>>> targetsByCue;
+  QHash<QString, int> firstByCue;
+  QSet<int> screens;
+  for (int i = 0; i < participants.size(); ++i) {
+    const GroupParticipant& participant = participants.at(i);
+    if (participant.ready) {
+      ++readyBeforeRelease;
+    }
+
+    OutputWindow* window = windows_.value(participant.screenIndex, nullptr);
+    if (window == nullptr) {
+      continue;
+    }
+    if (!targetsByCue.contains(participant.cue.id)) {
+      cueOrder.push_back(participant.cue.id);
+      firstByCue.insert(participant.cue.id, i);
+    }
+    targetsByCue[participant.cue.id].push_back({participant.screenIndex, window});
+    screens.insert(participant.screenIndex);
+  }
+
+  GroupMeasurement measurement;
+  measurement.id = nextGroupId_++;
+  measurement.participants = participants;
+  measurement.stats = groupStats_;
+  measurement.stats.armMs = startMs - groupArmStartMs_;
+  measurement.stats.readyBeforeRelease = readyBeforeRelease;
+  const quint64 groupId = measurement.id;
+  groupMeasurements_.push_back(std::move(measurement));
+  QTimer::singleShot(kGroupSkewMeasureTimeoutMs, this, [this, groupId]() { finishGroupMeasurement(groupId); });
+
+  // Each take swaps its armed standby on air still paused; every one of them
+  // is unpaused together at a single deadline a frame from now.
+  for (int screenIndex : std::as_const(screens)) {
+    windows_.value(screenIndex)->setHoldTakes(true);
+  }
+  for (const QString& cueId : std::as_const(cueOrder)) {
+    const GroupParticipant& first = participants.at(firstByCue.value(cueId));
+    const QVector<QPair<int, OutputWindow*>> targets = targetsByCue.value(cueId);
+    if (startRoute(first.cue, targets, first.style, first.durationMs, startMs)) {
+      emit routingStatus(QString("Program: '%1' on %2 target(s) layer %3")
+                             .arg(first.cue.name)
+                             .arg(targets.size())
+                             .arg(first.cue.layer));
+    }
+  }
+  for (int screenIndex : std::as_const(screens)) {
+    if (OutputWindow* window = windows_.value(screenIndex, nullptr)) {
+      window->setHoldTakes(false);
+    }
+  }
+  heldScreens_ = screens;
+  groupStartTimer_->start(static_cast<int>(qMax<qint64>(0, startMs + frameTimer_->interval() - transitionClock_.elapsed())));
+
+  if (readyBeforeRelease < participants.size()) {
+    emit routingError(QString("Grouped GO: %1 of %2 participant(s) not ready after %3 ms; started anyway.")
+                          .arg(participants.size() - readyBeforeRelease)
+                          .arg(participants.size())
+                          .arg(startMs - groupArmStartMs_));
+  }
+}
+
+void OutputRouter::startHeldGroup() {
+  groupStartTimer_->stop();
+  const QSet<int> screens = std::exchange(heldScreens_, {});
+  for (int screenIndex : screens) {
+    if (OutputWindow* window = windows_.value(screenIndex, nullptr)) {
+      window->startHeldTakes();
+    }
+  }
+}
+
+void OutputRouter::recordGroupAdvance(int screenIndex, const QString& cueId, int layer, double positionSec) {
+  if (groupMeasurements_.isEmpty() || positionSec <= 0.0) {
+    return;
+  }
+
+  const qint64 nowNs = transitionClock_.nsecsElapsed();
+  QVector<quint64> finished;
+  for (GroupMeasurement& measurement : groupMeasurements_) {
+    bool allAdvanced = true;
+    for (GroupParticipant& participant : measurement.participants) {
+      if (participant.firstAdvanceNs < 0 && participant.screenIndex == screenIndex &&
+          participant.cue.layer == layer && participant.cue.id == cueId) {
+        participant.firstAdvanceNs = nowNs;
+      }
+      allAdvanced = allAdvanced && participant.firstAdvanceNs >= 0;
+    }
+    if (allAdvanced) {
+      finished.push_back(measurement.id);
+    }
+  }
+
+  for (quint64 groupId : std::as_const(finished)) {
+    finishGroupMeasurement(groupId);
+  }
+}
+
+void OutputRouter::finishGroupMeasurement(quint64 groupId) {
+  int index = -1;
+  for (int i = 0; i < groupMeasurements_.size(); ++i) {
+    if (groupMeasurements_.at(i).id == groupId) {
+      index = i;
+      break;
+    }
+  }
+  if (index < 0) {
+    return;
+  }
+
+  const GroupMeasurement measurement = groupMeasurements_.takeAt(index);
+  qint64 earliestNs = -1;
+  qint64 latestNs = -1;
+  int advanced = 0;
+  for (const GroupParticipant& participant : measurement.participants) {
+    if (participant.firstAdvanceNs < 0) {
+      continue;
+    }
+    ++advanced;
+    earliestNs = earliestNs < 0 ? participant.firstAdvanceNs : qMin(earliestNs, participant.firstAdvanceNs);
+    latestNs = qMax(latestNs, participant.firstAdvanceNs);
+  }
+
+  lastGroupStats_ = measurement.stats;
+  lastGroupStats_.startSkewMs = advanced > 0 ? static_cast<double>(latestNs - earliestNs) / 1.0e6 : -1.0;
+
+  if (lastGroupStats_.startSkewMs >= 0.0) {
+    emit routingStatus(QString("Grouped GO: %1 participant(s), armed in %2 ms, start skew %3 ms")
+                           .arg(lastGroupStats_.participants)
+                           .arg(lastGroupStats_.armMs)
+                           .arg(lastGroupStats_.startSkewMs, 0, 'f', 1));
+  }
+  emit groupStartMeasured(lastGroupStats_);
+}
+
+void OutputRouter::dropGroupParticipants(int screenIndex, int layer) {
+  const auto matches = [screenIndex, layer](const GroupParticipant& participant) {
+    return (screenIndex < 0 || participant.screenIndex == screenIndex) && (layer < 0 || participant.cue.layer == layer);
+  };
+
+  // A measured group that loses every participant has nothing left to report.
+  for (int m = groupMeasurements_.size() - 1; m >= 0; --m) {
+    QVector<GroupParticipant>& measured = groupMeasurements_[m].participants;
+    measured.erase(std::remove_if(measured.begin(), measured.end(), matches), measured.end());
+    if (measured.isEmpty()) {
+      groupMeasurements_.removeAt(m);
+    }
+  }
+
+  const bool wasArming = groupArming_;
+  groupParticipants_.erase(std::remove_if(groupParticipants_.begin(), groupParticipants_.end(), matches),
+                           groupParticipants_.end());
+  if (!groupParticipants_.isEmpty()) {
+    if (wasArming) {
+      checkGroupReady();
+    }
+    return;
+  }
+
+  groupArming_ = false;
+  groupTimeoutTimer_->stop();
+  groupReleaseTimer_->stop();
+}
+
 bool OutputRouter::previewCue(const Cue& cue) {
-  const Cue resolvedCue = applyFilterPreset(cue);
   PreviewWindow* window = ensurePreviewWindow();
   if (window == nullptr) {
     emit routingError("Preview window is unavailable.");
@@ -102,22 +449,21 @@ bool OutputRouter::previewCue(const Cue& cue) {
   window->show();
   window->raise();
 
-  const bool ok = window->previewCue(resolvedCue);
+  const bool ok = window->previewCue(cue);
   if (!ok) {
-    emit routingError(QString("Failed to preview cue '%1'.").arg(resolvedCue.name));
+    emit routingError(QString("Failed to preview cue '%1'.").arg(cue.name));
     return false;
   }
 
-  previewCue_ = resolvedCue;
-  emit routingStatus(QString("Preview: '%1'").arg(resolvedCue.name));
+  previewCue_ = cue;
+  emit routingStatus(QString("Preview: '%1'").arg(cue.name));
   return true;
 }
 
 bool OutputRouter::preloadCue(const Cue& cue) {
-  const Cue resolvedCue = applyFilterPreset(cue);
-  const QVector<int> targetScreens = resolveTargetScreens(resolvedCue, displayManager_);
+  const QVector<int> targetScreens = resolveTargetScreens(cue, displayManager_);
   if (targetScreens.isEmpty()) {
-    emit routingError(QString("No screens available for preload cue '%1'.").arg(resolvedCue.name));
+    emit routingError(QString("No screens available for preload cue '%1'.").arg(cue.name));
     return false;
   }
 
@@ -134,13 +480,16 @@ bool OutputRouter::preloadCue(const Cue& cue) {
       continue;
     }
 
-    Cue routedCue = resolvedCue;
+    Cue routedCue = cue;
     routedCue.targetScreen = screenIndex;
     const bool ok = window->preloadCue(routedCue);
     if (!ok) {
-      emit routingError(QString("Failed to preload cue '%1' on screen %2.").arg(resolvedCue.name).arg(screenIndex));
+      emit routingError(QString("Failed to preload cue '%1' on screen %2.").arg(cue.name).arg(screenIndex));
       continue;
     }
+    const QPair<int, int> key(screenIndex, cue.layer);
+    plannedStandbys_.remove(key);
+    manualStandbys_.insert(key, cue.id);
     preloadedAny = true;
   }
 
@@ -148,7 +497,7 @@ bool OutputRouter::preloadCue(const Cue& cue) {
     return false;
   }
 
-  emit routingStatus(QString("Preloaded: '%1'").arg(resolvedCue.name));
+  emit routingStatus(QString("Preloaded: '%1'").arg(cue.name));
   return true;
 }
 
@@ -175,14 +524,134 @@ void OutputRouter::stopCue(const Cue& cue) {
   }
 }
 
+PreloadPlan OutputRouter::syncStandbys(QVector<PreloadCandidate> candidates, const PreloadBudget& budget) {
+  if (groupArming_) {
+    return lastPreloadPlan_;
+  }
+
+  QSet<QPair<int, int>> reserved;
+  for (auto it = manualStandbys_.begin(); it != manualStandbys_.end();) {
+    const OutputWindow* window = windows_.value(it.key().first);
+    if (window == nullptr || window->standbyCueId(it.key().second) != it.value()) {
+      it = manualStandbys_.erase(it);
+      continue;
+    }
+    reserved.insert(it.key());
+    ++it;
+  }
+
+  for (PreloadCandidate& candidate : candidates) {
+    candidate.screens = resolveTargetScreens(candidate.cue, displayManager_);
+  }
+  const PreloadPlan plan = PreloadPlanner::plan(candidates, budget, reserved);
+
+  // Evict first so the players freed go back to the pool for the new arms.
+  QMap<QPair<int, int>, QString> planned;
+  for (const PreloadSlot& slot : plan.slots) {
+    planned.insert({slot.screenIndex, slot.layer}, slot.cue.id);
+  }
+  for (auto it = plannedStandbys_.constBegin(); it != plannedStandbys_.constEnd(); ++it) {
+    OutputWindow* window = windows_.value(it.key().first);
+    if (window != nullptr && !planned.contains(it.key())) {
+      window->releaseStandby(it.key().second, it.value());
+    }
+  }
+
+  plannedStandbys_.clear();
+  for (const PreloadSlot& slot : plan.slots) {
+    // Planning runs on every selection change; a target screen that is not
+    // connected is skipped quietly rather than reported each time.
+    if (!windows_.contains(slot.screenIndex) &&
+        (displayManager_ == nullptr || displayManager_->screenAt(slot.screenIndex) == nullptr)) {
+      continue;
+    }
+    OutputWindow* window = ensureWindow(slot.screenIndex, false);
+    if (window != nullptr && window->armCue(slot.cue)) {
+      plannedStandbys_.insert({slot.screenIndex, slot.layer}, slot.cue.id);
+    }
+  }
+
+  lastPreloadPlan_ = plan;
+  return plan;
+}
+
+int OutputRouter::prewarmForCues(const QVector<Cue>& cues) {
+  // One player per referenced (screen, layer) pair, plus a standby for layers
+  // that carry preload cues.
+  QMap<int, QSet<int>> layersByScreen;
+  QMap<int, QSet<int>> preloadLayersByScreen;
+  for (const Cue& cue : cues) {
+    const QVector<int> targetScreens = resolveTargetScreens(cue, displayManager_);
+    for (int screenIndex : targetScreens) {
+      layersByScreen[screenIndex].insert(cue.layer);
+      if (cue.preload) {
+        preloadLayersByScreen[screenIndex].insert(cue.layer);
+      }
+    }
+  }
+
+  int created = 0;
+  int pairs = 0;
+  for (auto it = layersByScreen.constBegin(); it != layersByScreen.constEnd(); ++it) {
+    OutputWindow* window = ensureWindow(it.key(), false);
+    if (window == nullptr) {
+      continue;
+    }
+
+    pairs += it.value().size();
+    created += window->prewarmPlayers(it.value().size() + preloadLayersByScreen.value(it.key()).size());
+  }
+
+  if (created > 0) {
+    emit routingStatus(QString("Prewarmed %1 player(s) for %2 screen/layer pair(s); %3")
+                           .arg(created)
+                           .arg(pairs)
+                           .arg(describePlayerPools()));
+  }
+  return created;
+}
+
+PlayerPoolStats OutputRouter::playerPoolStats() const {
+  PlayerPoolStats total;
+  for (const OutputWindow* window : windows_) {
+    total += window->playerPoolStats();
+  }
+  return total;
+}
+
+QString OutputRouter::describePlayerPools() const {
+  const PlayerPoolStats stats = playerPoolStats();
+  const int created = stats.coldStarts + stats.prewarmed;
+  if (created == 0) {
+    return "no players created yet";
+  }
+
+  // Both ways of creating a player cost the same; only the cold ones land
+  // on a GO.
+  const double createMs = static_cast<double>(stats.totalColdStartNs + stats.totalPrewarmNs) / 1e6 / created;
+  QString text = QString("a cold player start takes %1 ms").arg(createMs, 0, 'f', 1);
+  if (stats.warmAcquires > 0) {
+    text += QString(", a warm acquire %1 ms")
+                .arg(static_cast<double>(stats.totalWarmAcquireNs) / 1e6 / stats.warmAcquires, 0, 'f', 3);
+  }
+  return text + QString(" (%1 cold, %2 warm so far)").arg(stats.coldStarts).arg(stats.warmAcquires);
+}
+
 void OutputRouter::stopLayer(int screenIndex, int layer) {
   if (!windows_.contains(screenIndex)) {
     return;
   }
+  dropGroupParticipants(screenIndex, layer);
+  dropTransitions(screenIndex, layer);
   windows_.value(screenIndex)->stopLayer(layer);
+  emit layerStopped(screenIndex, layer);
 }
 
 void OutputRouter::stopAll() {
+  dropGroupParticipants(-1, -1);
+  dropTransitions(-1, -1);
+  plannedStandbys_.clear();
+  manualStandbys_.clear();
   for (auto it = windows_.begin(); it != windows_.end(); ++it) {
     it.value()->stopAll();
   }
@@ -190,6 +659,7 @@ void OutputRouter::stopAll() {
   if (previewWindow_ != nullptr) {
     previewWindow_->stopAll();
   }
+  emit allStopped();
 }
 
 void OutputRouter::showOutputs() {
@@ -262,30 +732,107 @@ void OutputRouter::setFallbackSlatePath(const QString& path) {
   }
 }
 
-void OutputRouter::setFilterPresets(const QMap<QString, QString>& presets) { filterPresets_ = presets; }
+void OutputRouter::setFilterPresets(const QMap<QString, QString>& presets) {
+  filterPresets_ = presets;
+  for (auto it = windows_.begin(); it != windows_.end(); ++it) {
+    it.value()->setFilterPresets(presets);
+  }
+  if (previewWindow_ != nullptr) {
+    previewWindow_->setFilterPresets(presets);
+  }
+}
 
-Cue OutputRouter::applyFilterPreset(const Cue& cue) {
-  Cue resolvedCue = cue;
-  const QString presetId = cue.filterPresetId.trimmed();
-  if (presetId.isEmpty()) {
-    return resolvedCue;
+bool OutputRouter::validateFilterChain(const QString& chain, QString* error) {
+  if (chain.trimmed().isEmpty()) {
+    return true;
   }
+  if (filterValidator_ == nullptr) {
+    filterValidator_ = std::make_unique<FilterValidator>();
+  }
+  return filterValidator_->validate(chain.trimmed(), error);
+}
+
+void OutputRouter::setRenderBackend(RenderBackend backend) {
+  if (backend == renderBackend_) {
+    return;
+  }
+  renderBackend_ = backend;
+
+  for (auto it = windows_.begin(); it != windows_.end(); ++it) {
+    it.value()->setRenderBackend(backend);
+  }
+  emit routingStatus(QString("Render backend: %1").arg(renderBackendToString(backend)));
+}
 
-  const QString presetFilter = filterPresets_.value(presetId).trimmed();
-  if (presetFilter.isEmpty()) {
-    return resolvedCue;
+void OutputRouter::advanceTransitions() {
+  const qint64 nowMs = transitionClock_.elapsed();
+  for (auto it = windows_.begin(); it != windows_.end(); ++it) {
+    if (it.value()->transitionActive()) {
+      it.value()->advanceTransition(nowMs);
+    }
   }
 
-  const QString cueFilter = cue.videoFilter.trimmed();
-  resolvedCue.videoFilter = cueFilter.isEmpty() ? presetFilter : QString("%1,%2").arg(presetFilter, cueFilter);
-  return resolvedCue;
+  if (activeTransitions_.isEmpty()) {
+    frameTimer_->stop();
+  }
 }
 
-OutputWindow* OutputRouter::ensureWindow(int screenIndex) {
+void OutputRouter::handleTransitionFinished(int screenIndex, const QString& cueId, bool ok) {
+  for (int i = 0; i < activeTransitions_.size(); ++i) {
+    ActiveTransition& active = activeTransitions_[i];
+    if (active.cue.id != cueId || !active.pendingScreens.remove(screenIndex)) {
+      continue;
+    }
+
+    if (ok) {
+      ++active.playedScreens;
+    } else {
+      emit routingError(QString("Failed to play cue '%1' on screen %2 layer %3.")
+                            .arg(active.cue.name)
+                            .arg(screenIndex)
+                            .arg(active.cue.layer));
+    }
+    settleTransition(i);
+    return;
+  }
+}
+
+void OutputRouter::dropTransitions(int screenIndex, int layer) {
+  for (int i = activeTransitions_.size() - 1; i >= 0; --i) {
+    ActiveTransition& active = activeTransitions_[i];
+    if (layer >= 0 && active.cue.layer != layer) {
+      continue;
+    }
+
+    if (screenIndex >= 0) {
+      active.pendingScreens.remove(screenIndex);
+    } else {
+      active.pendingScreens.clear();
+    }
+    settleTransition(i);
+  }
+}
+
+void OutputRouter::settleTransition(int index) {
+  const ActiveTransition& active = activeTransitions_.at(index);
+  if (!active.pendingScreens.isEmpty()) {
+    return;
+  }
+
+  // Screens stopped mid-transition count as neither played nor failed.
+  const QString cueId = active.cue.id;
+  const bool played = active.playedScreens > 0;
+  activeTransitions_.removeAt(index);
+  emit cueTransitionFinished(cueId, played);
+}
+
+OutputWindow* OutputRouter::ensureWindow(int screenIndex, bool show) {
   if (windows_.contains(screenIndex)) {
     OutputWindow* existing = windows_.value(screenIndex);
-    QScreen* screen = displayManager_ != nullptr ? displayManager_->screenAt(screenIndex) : nullptr;
-    existing->showOnScreen(screen);
+    if (show) {
+      QScreen* screen = displayManager_ != nullptr ? displayManager_->screenAt(screenIndex) : nullptr;
+      existing->showOnScreen(screen);
+    }
     return existing;
   }
 
@@ -301,6 +848,8 @@ OutputWindow* OutputRouter::ensureWindow(int screenIndex) {
   }
 
   auto* window = new OutputWindow();
+  window->setRenderBackend(renderBackend_);
+  window->setFilterPresets(filterPresets_);
   if (!fallbackSlatePath_.isEmpty()) {
     window->setFallbackSlatePath(fallbackSlatePath_);
   }
@@ -313,8 +862,29 @@ OutputWindow* OutputRouter::ensureWindow(int screenIndex) {
   }
 
   connect(window, &OutputWindow::playbackError, this, &OutputRouter::routingError);
-
-  window->showOnScreen(screen);
+  connect(window, &OutputWindow::cuePositionChanged, this,
+          [this, screenIndex](const QString& cueId, int layer, double positionSec, double durationSec) {
+            recordGroupAdvance(screenIndex, cueId, layer, positionSec);
+            emit cuePositionChanged(cueId, screenIndex, layer, positionSec, durationSec);
+          });
+  connect(window, &OutputWindow::cueArmed, this,
+          [this, screenIndex](const QString& cueId, int layer) { handleCueArmed(screenIndex, cueId, layer); });
+  connect(window, &OutputWindow::cueMediaEnded, this, [this, screenIndex](const QString& cueId, int layer) {
+    emit cueMediaEnded(cueId, screenIndex, layer);
+  });
+  connect(window, &OutputWindow::cueOnAir, this,
+          [this, screenIndex](const QString& cueId, int layer) { emit cueOnAir(cueId, screenIndex, layer); });
+  connect(window, &OutputWindow::transitionFinished, this, [this, screenIndex](const QString& cueId, bool ok) {
+    handleTransitionFinished(screenIndex, cueId, ok);
+  });
+
+  if (show) {
+    window->showOnScreen(screen);
+  } else {
+    // Prewarm path: size the window for its screen without mapping it, so the
+    // pooled players bind to native windows that are already the right size.
+    window->setGeometry(screen->geometry());
+  }
   windows_.insert(screenIndex, window);
   return window;
 }
@@ -326,6 +896,7 @@ PreviewWindow* OutputRouter::ensurePreviewWindow() {
 
   previewWindow_ = new PreviewWindow();
   previewWindow_->setOverlayText(overlayText_);
+  previewWindow_->setFilterPresets(filterPresets_);
   connect(previewWindow_, &PreviewWindow::previewError, this, &OutputRouter::routingError);
   return previewWindow_;
 }
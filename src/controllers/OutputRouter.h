@@ -1,16 +1,42 @@
 #pragma once
 
+#include <QElapsedTimer>
 #include <QMap>
 #include <QObject>
+#include <QSet>
 #include <QString>
+#include <QVector>
 
+#include <memory>
+
+#include "controllers/PreloadPlanner.h"
 #include "core/Cue.h"
+#include "core/RenderBackend.h"
 #include "core/Transition.h"
 #include "output/OutputCalibration.h"
+#include "output/PlayerPool.h"
 
 class DisplayManager;
+class FilterValidator;
 class OutputWindow;
 class PreviewWindow;
+class QTimer;
+
+// One cue taking part in a grouped GO, with the transition it should use.
+struct GroupGoEntry {
+  Cue cue;
+  TransitionStyle style = TransitionStyle::Cut;
+  int durationMs = 0;
+};
+
+// Outcome of the most recent grouped GO. Start skew is the spread between the
+// first and last participant's first advancing frame after the release.
+struct GroupStartStats {
+  int participants = 0;
+  int readyBeforeRelease = 0;
+  qint64 armMs = 0;
+  double startSkewMs = -1.0;
+};
 
 class OutputRouter : public QObject {
   Q_OBJECT
@@ -19,12 +45,33 @@ class OutputRouter : public QObject {
   explicit OutputRouter(DisplayManager* displayManager, QObject* parent = nullptr);
   ~OutputRouter() override;
 
+  static constexpr int kDefaultReadyTimeoutMs = 500;
+
+  // Starts the cue on every target screen in the same frame and returns
+  // without waiting for the transition; cueTransitionFinished reports the end.
+  // Cues with more than one target screen go through routeCueGroup().
   bool routeCue(const Cue& cue, TransitionStyle style = TransitionStyle::Cut, int durationMs = 0);
+  // Loads every participant paused into its layer standby, waits for each to
+  // report a decoded first frame (or for the timeout), then takes them all on
+  // one deadline. Returns once arming has started.
+  bool routeCueGroup(const QVector<GroupGoEntry>& entries, int readyTimeoutMs = kDefaultReadyTimeoutMs);
+  GroupStartStats lastGroupStartStats() const;
+  // Screens cue plays on once its target set is resolved.
+  QVector<int> targetScreens(const Cue& cue) const;
   bool previewCue(const Cue& cue);
   bool preloadCue(const Cue& cue);
   bool takePreview(TransitionStyle style, int durationMs);
   Cue lastPreviewCue() const;
   void stopCue(const Cue& cue);
+  int prewarmForCues(const QVector<Cue>& cues);
+  // Measured player start costs summed over every output's pool.
+  PlayerPoolStats playerPoolStats() const;
+  QString describePlayerPools() const;
+  // Holds the planned upcoming cues paused in their layers' standbys and
+  // releases standbys this planned earlier that are no longer wanted.
+  // Manual preloads are kept until taken or replaced. Does nothing while a
+  // grouped GO is arming, since that uses the same standbys.
+  PreloadPlan syncStandbys(QVector<PreloadCandidate> candidates, const PreloadBudget& budget);
 
   void stopLayer(int screenIndex, int layer);
   void stopAll();
@@ -41,14 +88,61 @@ class OutputRouter : public QObject {
 
   void setFallbackSlatePath(const QString& path);
   void setFilterPresets(const QMap<QString, QString>& presets);
+  // Edit-time check of a preset or cue vf chain; verdicts are cached per chain.
+  bool validateFilterChain(const QString& chain, QString* error = nullptr);
+  void setRenderBackend(RenderBackend backend);
 
  signals:
   void routingError(const QString& message);
   void routingStatus(const QString& message);
+  void cuePositionChanged(const QString& cueId, int screenIndex, int layer, double positionSec, double durationSec);
+  void cueMediaEnded(const QString& cueId, int screenIndex, int layer);
+  void cueOnAir(const QString& cueId, int screenIndex, int layer);
+  void layerStopped(int screenIndex, int layer);
+  void allStopped();
+  void cueTransitionFinished(const QString& cueId, bool ok);
+  void groupStartMeasured(const GroupStartStats& stats);
 
  private:
-  Cue applyFilterPreset(const Cue& cue);
-  OutputWindow* ensureWindow(int screenIndex);
+  // One routed cue whose transition is still running on some of its screens.
+  struct ActiveTransition {
+    Cue cue;
+    QSet<int> pendingScreens;
+    int playedScreens = 0;
+  };
+
+  struct GroupParticipant {
+    int screenIndex = -1;
+    Cue cue;
+    TransitionStyle style = TransitionStyle::Cut;
+    int durationMs = 0;
+    bool ready = false;
+    qint64 firstAdvanceNs = -1;
+  };
+
+  // A released group whose start skew is still being measured. The id keeps
+  // a later group's participants out of an earlier group's numbers.
+  struct GroupMeasurement {
+    quint64 id = 0;
+    QVector<GroupParticipant> participants;
+    GroupStartStats stats;
+  };
+
+  bool startRoute(const Cue& cue, const QVector<QPair<int, OutputWindow*>>& targets, TransitionStyle style,
+                  int durationMs, qint64 startMs);
+  void handleCueArmed(int screenIndex, const QString& cueId, int layer);
+  void checkGroupReady();
+  void scheduleGroupRelease();
+  void releaseGroup();
+  void startHeldGroup();
+  void recordGroupAdvance(int screenIndex, const QString& cueId, int layer, double positionSec);
+  void finishGroupMeasurement(quint64 groupId);
+  void dropGroupParticipants(int screenIndex, int layer);
+  void advanceTransitions();
+  void handleTransitionFinished(int screenIndex, const QString& cueId, bool ok);
+  void dropTransitions(int screenIndex, int layer);
+  void settleTransition(int index);
+  OutputWindow* ensureWindow(int screenIndex, bool show = true);
   PreviewWindow* ensurePreviewWindow();
 
   DisplayManager* displayManager_;
@@ -57,6 +151,27 @@ class OutputRouter : public QObject {
   Cue previewCue_;
   QMap<int, OutputCalibration> calibrations_;
   QMap<QString, QString> filterPresets_;
+  std::unique_ptr<FilterValidator> filterValidator_;
   QString fallbackSlatePath_;
   QString overlayText_;
+  RenderBackend renderBackend_ = RenderBackend::NativeWindows;
+  QTimer* frameTimer_;
+  QElapsedTimer transitionClock_;
+  QVector<ActiveTransition> activeTransitions_;
+  QTimer* groupTimeoutTimer_;
+  QTimer* groupReleaseTimer_;
+  QTimer* groupStartTimer_;
+  QVector<GroupParticipant> groupParticipants_;
+  bool groupArming_ = false;
+  qint64 groupArmStartMs_ = 0;
+  GroupStartStats groupStats_;
+  QVector<GroupMeasurement> groupMeasurements_;
+  quint64 nextGroupId_ = 1;
+  // Screens whose released takes wait paused for groupStartTimer_.
+  QSet<int> heldScreens_;
+  GroupStartStats lastGroupStats_;
+  // (screen, layer) -> cue id held in that standby, by who put it there.
+  QMap<QPair<int, int>, QString> plannedStandbys_;
+  QMap<QPair<int, int>, QString> manualStandbys_;
+  PreloadPlan lastPreloadPlan_;
 };
@@ -1,16 +1,50 @@
 #include "controllers/PlaybackController.h"
 
-#include <QRegularExpression>
-#include <QTimer>
 #include <QtGlobal>
 
+#include <utility>
+
 #include "controllers/OutputRouter.h"
 #include "core/CueListModel.h"
+#include "core/Trace.h"
 
 PlaybackController::PlaybackController(CueListModel* cueModel, OutputRouter* outputRouter, QObject* parent)
-    : QObject(parent), cueModel_(cueModel), outputRouter_(outputRouter) {}
+    : QObject(parent),
+      cueModel_(cueModel),
+      outputRouter_(outputRouter),
+      scheduler_(new ShowScheduler(this)),
+      latency_(new LatencyMonitor(this)) {
+  if (outputRouter_ != nullptr) {
+    connect(outputRouter_, &OutputRouter::cuePositionChanged, this,
+            [this](const QString& cueId, int, int, double positionSec, double durationSec) {
+              handleCuePosition(cueId, positionSec, durationSec);
+            });
+    connect(outputRouter_, &OutputRouter::cueMediaEnded, this,
+            [this](const QString& cueId, int, int) { handleCueMediaEnded(cueId); });
+    connect(outputRouter_, &OutputRouter::cueOnAir, latency_,
+            [this](const QString& cueId, int, int) { latency_->complete(cueId); });
+  }
+
+  // The trigger table follows every edit that can move or change a timecode
+  // trigger, so a chased frame never pays for a rebuild.
+  if (cueModel_ != nullptr) {
+    const auto rebuild = [this]() { triggerTable_.rebuild(cueModel_->cues()); };
+    connect(cueModel_, &QAbstractItemModel::modelReset, this, rebuild);
+    connect(cueModel_, &QAbstractItemModel::rowsInserted, this, rebuild);
+    connect(cueModel_, &QAbstractItemModel::rowsRemoved, this, rebuild);
+    connect(cueModel_, &QAbstractItemModel::rowsMoved, this, rebuild);
+    connect(cueModel_, &QAbstractItemModel::dataChanged, this,
+            [rebuild](const QModelIndex& topLeft, const QModelIndex& bottomRight) {
+              if (topLeft.column() <= CueListModel::TimecodeColumn &&
+                  bottomRight.column() >= CueListModel::TimecodeColumn) {
+                rebuild();
+              }
+            });
+    rebuild();
+  }
+}
 
-bool PlaybackController::playCueAtRow(int row, TransitionStyle style, int durationMs) {
+bool PlaybackController::playCueAtRow(int row, TransitionStyle style, int durationMs, const TriggerStamp& stamp) {
   if (cueModel_ == nullptr || outputRouter_ == nullptr) {
     emit playbackError("Playback system is not initialized.");
     return false;
@@ -21,25 +55,31 @@ bool PlaybackController::playCueAtRow(int row, TransitionStyle style, int durati
     return false;
   }
 
+  // A copy: cueWentLive handlers may edit the list before the follow-ups
+  // below are scheduled.
   const Cue cue = cueModel_->cueAt(row);
   if (cue.filePath.isEmpty() && (!cue.isLiveInput || cue.liveInputUrl.trimmed().isEmpty())) {
     emit playbackError(QString("Cue '%1' has no media file.").arg(cue.name));
     return false;
   }
 
+  const TraceScope trace("playback", "playCueAtRow", [&cue]() { return cue.id; });
   const TransitionStyle effectiveStyle = cue.useTransitionOverride ? cue.transitionStyle : style;
   const int effectiveDuration = cue.useTransitionOverride ? cue.transitionDurationMs : durationMs;
 
+  // Opened before routing: a take of a preloaded standby is on air before
+  // routeCue returns.
+  latency_->begin(cue.id, stamp);
   const bool ok = outputRouter_->routeCue(cue, effectiveStyle, effectiveDuration);
   if (!ok) {
+    latency_->cancel(cue.id);
     emit playbackError(QString("Failed to route cue '%1'.").arg(cue.name));
     return false;
   }
 
   emit playbackStatus(QString("Live: '%1'").arg(cue.name));
   emit cueWentLive(cue);
-  scheduleFollowCue(cue, effectiveStyle, effectiveDuration);
-  scheduleAutoStop(cue);
+  scheduleCueActions(cue, row, effectiveStyle, effectiveDuration);
   return true;
 }
 
@@ -54,7 +94,7 @@ bool PlaybackController::previewCueAtRow(int row) {
     return false;
   }
 
-  const Cue cue = cueModel_->cueAt(row);
+  const Cue& cue = cueModel_->cueAt(row);
   if (cue.filePath.isEmpty() && (!cue.isLiveInput || cue.liveInputUrl.trimmed().isEmpty())) {
     emit playbackError(QString("Cue '%1' has no media file.").arg(cue.name));
     return false;
@@ -67,6 +107,7 @@ bool PlaybackController::previewCueAtRow(int row) {
   }
 
   emit playbackStatus(QString("Preview: '%1'").arg(cue.name));
+  emit cuePreviewed(cue);
   return true;
 }
 
@@ -81,7 +122,7 @@ bool PlaybackController::preloadCueAtRow(int row) {
     return false;
   }
 
-  const Cue cue = cueModel_->cueAt(row);
+  const Cue& cue = cueModel_->cueAt(row);
   if (cue.filePath.isEmpty() && (!cue.isLiveInput || cue.liveInputUrl.trimmed().isEmpty())) {
     emit playbackError(QString("Cue '%1' has no media file.").arg(cue.name));
     return false;
@@ -97,7 +138,7 @@ bool PlaybackController::preloadCueAtRow(int row) {
   return true;
 }
 
-bool PlaybackController::takePreviewCue(TransitionStyle style, int durationMs) {
+bool PlaybackController::takePreviewCue(TransitionStyle style, int durationMs, const TriggerStamp& stamp) {
   if (outputRouter_ == nullptr) {
     emit playbackError("Playback system is not initialized.");
     return false;
@@ -107,73 +148,142 @@ bool PlaybackController::takePreviewCue(TransitionStyle style, int durationMs) {
   const TransitionStyle effectiveStyle = previewCue.useTransitionOverride ? previewCue.transitionStyle : style;
   const int effectiveDuration = previewCue.useTransitionOverride ? previewCue.transitionDurationMs : durationMs;
 
+  latency_->begin(previewCue.id, stamp);
   const bool ok = outputRouter_->takePreview(effectiveStyle, effectiveDuration);
   if (!ok) {
+    latency_->cancel(previewCue.id);
     emit playbackError("Failed to take preview live.");
     return false;
   }
 
   emit playbackStatus(QString("Taken live: '%1'").arg(previewCue.name));
   emit cueWentLive(previewCue);
-  scheduleFollowCue(previewCue, effectiveStyle, effectiveDuration);
-  scheduleAutoStop(previewCue);
+  if (cueModel_ != nullptr) {
+    scheduleCueActions(previewCue, cueModel_->rowForCueId(previewCue.id), effectiveStyle, effectiveDuration);
+  }
   return true;
 }
 
-bool PlaybackController::playCueById(const QString& cueId, TransitionStyle style, int durationMs, bool previewOnly) {
+bool PlaybackController::playCueById(const QString& cueId, TransitionStyle style, int durationMs, bool previewOnly,
+                                     const TriggerStamp& stamp) {
   if (cueModel_ == nullptr) {
     return false;
   }
 
   const int row = cueModel_->rowForCueId(cueId);
   if (row < 0) {
-    emit playbackError(QString("Hotkey cue '%1' no longer exists.").arg(cueId));
+    emit playbackError(QString("Cue '%1' no longer exists.").arg(cueId));
     return false;
   }
 
-  return previewOnly ? previewCueAtRow(row) : playCueAtRow(row, style, durationMs);
+  return previewOnly ? previewCueAtRow(row) : playCueAtRow(row, style, durationMs, stamp);
 }
 
-bool PlaybackController::triggerByTimecode(const QString& timecode, TransitionStyle style, int durationMs) {
-  if (cueModel_ == nullptr || outputRouter_ == nullptr || timecode.isEmpty()) {
+bool PlaybackController::triggerByTimecode(const Timecode& timecode, TransitionStyle style, int durationMs,
+                                           const TriggerStamp& stamp) {
+  if (cueModel_ == nullptr || outputRouter_ == nullptr || !timecode.isValid()) {
     return false;
   }
 
-  const QString normalizedTimecode = normalizeTimecode(timecode);
-  if (normalizedTimecode.isEmpty()) {
+  // A cue fires once per matching timecode; holding on the same frame (or a
+  // repeated MTC frame) does not re-fire it. Cues that stop matching drop out
+  // of the map so they fire again next time round.
+  lastTimecode_ = timecode;
+  triggerTable_.match(timecode, &triggerMatches_);
+  if (triggerMatches_.isEmpty()) {
+    lastTimecodeByCueId_.clear();
     return false;
   }
+  const TraceScope trace("playback", "triggerByTimecode", [&timecode]() { return timecode.toString(); });
+  QHash<QString, Timecode> matchedTimecodes;
+
+  QVector<int> rows;
+  for (int row : std::as_const(triggerMatches_)) {
+    const Cue& cue = cueModel_->cueAt(row);
+    if (lastTimecodeByCueId_.value(cue.id) == timecode) {
+      matchedTimecodes.insert(cue.id, timecode);
+      continue;
+    }
+    rows.push_back(row);
+  }
+  lastTimecodeByCueId_ = matchedTimecodes;
 
-  bool triggered = false;
+  // Every cue landing on this frame goes out as one grouped GO so screens and
+  // layers start together instead of in list order.
+  const QVector<GroupGoEntry> routed = routeTogether(rows, style, durationMs, stamp);
+  for (const GroupGoEntry& entry : routed) {
+    lastTimecodeByCueId_.insert(entry.cue.id, timecode);
+    emit playbackStatus(QString("Timecode %1 -> '%2'").arg(timecode.toString()).arg(entry.cue.name));
+  }
+  return !routed.isEmpty();
+}
+
+bool PlaybackController::playCueRowsTogether(const QVector<int>& rows, TransitionStyle style, int durationMs,
+                                             const TriggerStamp& stamp) {
+  if (cueModel_ == nullptr || outputRouter_ == nullptr) {
+    emit playbackError("Playback system is not initialized.");
+    return false;
+  }
 
-  const QVector<Cue> cues = cueModel_->cues();
-  for (const Cue& cue : cues) {
-    if (cue.timecodeTrigger.isEmpty()) {
+  QVector<int> playable;
+  for (int row : rows) {
+    if (!cueModel_->isValidRow(row)) {
+      emit playbackError(QString("No cue at row %1.").arg(row + 1));
+      continue;
+    }
+    const Cue& cue = cueModel_->cueAt(row);
+    if (cue.filePath.isEmpty() && (!cue.isLiveInput || cue.liveInputUrl.trimmed().isEmpty())) {
+      emit playbackError(QString("Cue '%1' has no media file.").arg(cue.name));
       continue;
     }
+    if (!playable.contains(row)) {
+      playable.push_back(row);
+    }
+  }
+
+  const QVector<GroupGoEntry> routed = routeTogether(playable, style, durationMs, stamp);
+  for (const GroupGoEntry& entry : routed) {
+    emit playbackStatus(QString("Live: '%1'").arg(entry.cue.name));
+  }
+  return !routed.isEmpty();
+}
+
+QVector<GroupGoEntry> PlaybackController::routeTogether(const QVector<int>& rows, TransitionStyle style,
+                                                        int durationMs, const TriggerStamp& stamp) {
+  if (rows.isEmpty()) {
+    return {};
+  }
+
+  // Copies: cueWentLive handlers may edit the list before the follow-ups
+  // below are scheduled.
+  QVector<GroupGoEntry> entries;
+  entries.reserve(rows.size());
+  for (int row : rows) {
+    const Cue& cue = cueModel_->cueAt(row);
+    const TransitionStyle effectiveStyle = cue.useTransitionOverride ? cue.transitionStyle : style;
+    const int effectiveDuration = cue.useTransitionOverride ? cue.transitionDurationMs : durationMs;
+    entries.push_back({cue, effectiveStyle, effectiveDuration});
+  }
 
-    if (cueMatchesTimecode(cue.timecodeTrigger, normalizedTimecode)) {
-      const QString last = lastTimecodeByCueId_.value(cue.id);
-      if (last == normalizedTimecode) {
-        continue;
-      }
-
-      const TransitionStyle effectiveStyle = cue.useTransitionOverride ? cue.transitionStyle : style;
-      const int effectiveDuration = cue.useTransitionOverride ? cue.transitionDurationMs : durationMs;
-      if (outputRouter_->routeCue(cue, effectiveStyle, effectiveDuration)) {
-        lastTimecodeByCueId_.insert(cue.id, normalizedTimecode);
-        emit playbackStatus(QString("Timecode %1 -> '%2'").arg(normalizedTimecode).arg(cue.name));
-        emit cueWentLive(cue);
-        scheduleFollowCue(cue, effectiveStyle, effectiveDuration);
-        scheduleAutoStop(cue);
-        triggered = true;
-      }
-    } else {
-      lastTimecodeByCueId_.remove(cue.id);
+  for (const GroupGoEntry& entry : std::as_const(entries)) {
+    latency_->begin(entry.cue.id, stamp);
+  }
+  const GroupGoEntry& only = entries.first();
+  const bool routed = entries.size() == 1 ? outputRouter_->routeCue(only.cue, only.style, only.durationMs)
+                                          : outputRouter_->routeCueGroup(entries);
+  if (!routed) {
+    for (const GroupGoEntry& entry : std::as_const(entries)) {
+      latency_->cancel(entry.cue.id);
     }
+    return {};
   }
 
-  return triggered;
+  for (int i = 0; i < entries.size(); ++i) {
+    const GroupGoEntry& entry = entries.at(i);
+    emit cueWentLive(entry.cue);
+    scheduleCueActions(entry.cue, rows.at(i), entry.style, entry.durationMs);
+  }
+  return entries;
 }
 
 void PlaybackController::stopCueAtRow(int row) {
@@ -181,135 +291,170 @@ void PlaybackController::stopCueAtRow(int row) {
     return;
   }
 
-  const Cue cue = cueModel_->cueAt(row);
+  const Cue& cue = cueModel_->cueAt(row);
+  mediaEndAdvances_.remove(cue.id);
+  scheduler_->cancelForCue(cue.id);
   outputRouter_->stopCue(cue);
 }
 
+void PlaybackController::stopLayer(int screenIndex, int layer) {
+  if (cueModel_ == nullptr || outputRouter_ == nullptr) {
+    return;
+  }
+
+  // Cues reach a screen through their target set as well as targetScreen.
+  for (const Cue& cue : cueModel_->cues()) {
+    if (cue.layer == layer && outputRouter_->targetScreens(cue).contains(screenIndex)) {
+      mediaEndAdvances_.remove(cue.id);
+      scheduler_->cancelForCue(cue.id);
+    }
+  }
+  outputRouter_->stopLayer(screenIndex, layer);
+}
+
 void PlaybackController::stopAll() {
+  mediaEndAdvances_.clear();
+  scheduler_->cancelAll();
   if (outputRouter_ == nullptr) {
     return;
   }
   outputRouter_->stopAll();
 }
 
-QString PlaybackController::normalizeTimecode(const QString& rawTimecode) {
-  const QString trimmed = rawTimecode.trimmed();
-  if (trimmed.isEmpty()) {
-    return {};
-  }
-
-  QRegularExpression fullPattern(R"(^(\d{1,2}):(\d{1,2}):(\d{1,2})(?::(\d{1,2}))?$)");
-  QRegularExpressionMatch match = fullPattern.match(trimmed);
-  if (!match.hasMatch()) {
-    return {};
-  }
+const ShowScheduler* PlaybackController::scheduler() const { return scheduler_; }
 
-  const int hour = match.captured(1).toInt();
-  const int minute = match.captured(2).toInt();
-  const int second = match.captured(3).toInt();
-  const int frame = match.captured(4).isEmpty() ? 0 : match.captured(4).toInt();
+LatencyMonitor* PlaybackController::latencyMonitor() const { return latency_; }
 
-  return QString("%1:%2:%3:%4")
-      .arg(hour, 2, 10, QChar('0'))
-      .arg(minute, 2, 10, QChar('0'))
-      .arg(second, 2, 10, QChar('0'))
-      .arg(frame, 2, 10, QChar('0'));
+void PlaybackController::scheduleCueActions(const Cue& cue, int row, TransitionStyle style, int durationMs) {
+  // A re-GO replaces whatever the previous GO of this cue left pending.
+  mediaEndAdvances_.remove(cue.id);
+  scheduler_->cancelForCue(cue.id);
+  scheduleFollowCue(cue, row, style, durationMs);
+  scheduleAutoStop(cue);
 }
 
-bool PlaybackController::cueMatchesTimecode(const QString& cueTrigger, const QString& normalizedTimecode) {
-  const QString normalizedTrigger = cueTrigger.trimmed().toLower();
-  if (normalizedTrigger.isEmpty()) {
-    return false;
+void PlaybackController::scheduleFollowCue(const Cue& cue, int row, TransitionStyle style, int durationMs) {
+  if (cueModel_ == nullptr) {
+    return;
   }
 
-  if (!normalizedTrigger.contains('*')) {
-    return normalizeTimecode(normalizedTrigger) == normalizedTimecode;
+  const int nextRow = cueModel_->successorRow(row);
+  if (!cueModel_->isValidRow(nextRow)) {
+    return;
   }
 
-  const QStringList triggerParts = normalizedTrigger.split(':');
-  const QStringList incomingParts = normalizedTimecode.toLower().split(':');
-  if (triggerParts.size() != 4 || incomingParts.size() != 4) {
-    return false;
+  if (cue.autoFollow) {
+    scheduleAdvance(cue, ScheduledActionKind::Follow, nextRow, cue.followDelayMs, style, durationMs);
+  } else {
+    scheduleAdvance(cue, ScheduledActionKind::PlaylistAdvance, nextRow, cue.playlistAdvanceDelayMs, style,
+                    durationMs);
   }
+}
 
-  for (int i = 0; i < 4; ++i) {
-    if (triggerParts.at(i) == "*") {
-      continue;
-    }
+QVector<int> PlaybackController::upcomingRows(int liveRow, int selectedRow, int count) const {
+  QVector<int> rows;
+  if (cueModel_ == nullptr || count <= 0) {
+    return rows;
+  }
 
-    bool ok = false;
-    const int expectedValue = triggerParts.at(i).toInt(&ok);
-    if (!ok) {
-      return false;
+  const auto append = [&rows](int row) {
+    if (!rows.contains(row)) {
+      rows.push_back(row);
     }
+  };
 
-    const QString expected = QString("%1").arg(expectedValue, 2, 10, QChar('0'));
-    if (expected != incomingParts.at(i)) {
-      return false;
+  if (cueModel_->isValidRow(liveRow)) {
+    for (int row : cueModel_->lookaheadRows(liveRow, count)) {
+      append(row);
     }
   }
 
-  return true;
-}
-
-void PlaybackController::scheduleFollowCue(const Cue& cue, TransitionStyle style, int durationMs) {
-  if (cueModel_ == nullptr) {
-    return;
+  if (cueModel_->isValidRow(selectedRow)) {
+    append(selectedRow);
+    for (int row : cueModel_->lookaheadRows(selectedRow, count)) {
+      append(row);
+    }
   }
 
-  if (cue.autoFollow) {
-    const int followRow = cue.followCueRow >= 0 ? cue.followCueRow : cueModel_->rowForCueId(cue.id) + 1;
-    if (!cueModel_->isValidRow(followRow)) {
-      return;
+  // Only while timecode is running.
+  if (lastTimecode_.isValid()) {
+    QVector<int> triggered;
+    triggerTable_.upcoming(lastTimecode_, count, &triggered);
+    for (int row : std::as_const(triggered)) {
+      append(row);
     }
+  }
 
-    const int delayMs = qMax(0, cue.followDelayMs);
-    QTimer::singleShot(delayMs, this, [this, followRow, style, durationMs]() { playCueAtRow(followRow, style, durationMs); });
-    return;
+  if (cueModel_->isValidRow(selectedRow)) {
+    for (int row = selectedRow + 1; cueModel_->isValidRow(row) && rows.size() < count; ++row) {
+      append(row);
+    }
   }
 
-  schedulePlaylistAdvance(cue, style, durationMs);
+  rows.resize(qMin<int>(rows.size(), count));
+  return rows;
 }
 
-void PlaybackController::schedulePlaylistAdvance(const Cue& cue, TransitionStyle style, int durationMs) {
-  if (cueModel_ == nullptr || !cue.playlistAutoAdvance || cue.playlistId.trimmed().isEmpty()) {
+void PlaybackController::scheduleAdvance(const Cue& cue, ScheduledActionKind kind, int row, int delayMs,
+                                         TransitionStyle style, int durationMs) {
+  const Cue& target = cueModel_->cueAt(row);
+  if (cue.advanceTrigger == AdvanceTrigger::MediaEnd && !cue.loop) {
+    MediaEndAdvance advance;
+    advance.targetCueId = target.id;
+    advance.leadMs = qMax(0, cue.advanceLeadMs);
+    advance.style = style;
+    advance.durationMs = durationMs;
+    mediaEndAdvances_.insert(cue.id, advance);
     return;
   }
 
-  const QString playlistId = cue.playlistId.trimmed();
-  const QVector<Cue> cues = cueModel_->cues();
+  ScheduledAction action;
+  action.kind = kind;
+  action.cueId = cue.id;
+  action.targetCueId = target.id;
+  action.label = QString("%1 '%2' -> '%3'")
+                     .arg(kind == ScheduledActionKind::Follow ? "Follow" : "Playlist")
+                     .arg(cue.name, target.name);
+  const QString targetCueId = target.id;
+  scheduler_->schedule(action, delayMs,
+                       [this, targetCueId, style, durationMs]() { playScheduledTarget(targetCueId, style, durationMs); });
+}
+
+bool PlaybackController::playScheduledTarget(const QString& targetCueId, TransitionStyle style, int durationMs) {
+  // Resolved at fire time: rows may have moved since the action was queued.
+  const int row = cueModel_->rowForCueId(targetCueId);
+  if (row < 0) {
+    emit playbackError(QString("Scheduled cue '%1' no longer exists.").arg(targetCueId));
+    return false;
+  }
+  return playCueAtRow(row, style, durationMs);
+}
 
-  const int currentRow = cueModel_->rowForCueId(cue.id);
-  if (currentRow < 0) {
+void PlaybackController::handleCuePosition(const QString& cueId, double positionSec, double durationSec) {
+  const auto it = mediaEndAdvances_.constFind(cueId);
+  if (it == mediaEndAdvances_.constEnd() || it.value().leadMs <= 0 || durationSec <= 0.0) {
     return;
   }
 
-  int nextRow = -1;
-  for (int i = currentRow + 1; i < cues.size(); ++i) {
-    if (cues.at(i).playlistId.trimmed() == playlistId) {
-      nextRow = i;
-      break;
-    }
+  const double remainingMs = (durationSec - positionSec) * 1000.0;
+  if (remainingMs <= it.value().leadMs) {
+    fireMediaEndAdvance(cueId);
   }
+}
 
-  if (nextRow < 0 && cue.playlistLoop) {
-    for (int i = 0; i < cues.size(); ++i) {
-      if (i == currentRow) {
-        continue;
-      }
-      if (cues.at(i).playlistId.trimmed() == playlistId) {
-        nextRow = i;
-        break;
-      }
-    }
-  }
+void PlaybackController::handleCueMediaEnded(const QString& cueId) { fireMediaEndAdvance(cueId); }
 
-  if (!cueModel_->isValidRow(nextRow)) {
+void PlaybackController::fireMediaEndAdvance(const QString& cueId) {
+  // Multi-screen cues report from every output; the first report wins and the
+  // entry is consumed so the advance fires once per go.
+  const auto it = mediaEndAdvances_.constFind(cueId);
+  if (it == mediaEndAdvances_.constEnd()) {
     return;
   }
 
-  const int delayMs = qMax(0, cue.playlistAdvanceDelayMs);
-  QTimer::singleShot(delayMs, this, [this, nextRow, style, durationMs]() { playCueAtRow(nextRow, style, durationMs); });
+  const MediaEndAdvance advance = it.value();
+  mediaEndAdvances_.erase(it);
+  playScheduledTarget(advance.targetCueId, advance.style, advance.durationMs);
 }
 
 void PlaybackController::scheduleAutoStop(const Cue& cue) {
@@ -317,6 +462,10 @@ void PlaybackController::scheduleAutoStop(const Cue& cue) {
     return;
   }
 
-  const int delayMs = qMax(0, cue.autoStopMs);
-  QTimer::singleShot(delayMs, this, [this, cue]() { outputRouter_->stopCue(cue); });
+  ScheduledAction action;
+  action.kind = ScheduledActionKind::AutoStop;
+  action.cueId = cue.id;
+  action.label = QString("Auto-stop '%1'").arg(cue.name);
+  // Stops what this GO put up, even if the cue is edited meanwhile.
+  scheduler_->schedule(action, cue.autoStopMs, [this, cue]() { outputRouter_->stopCue(cue); });
 }
@@ -1,11 +1,17 @@
 #pragma once
 
-#include <QMap>
+#include <QHash>
 #include <QObject>
 #include <QString>
+#include <QVector>
 
+#include "controllers/LatencyMonitor.h"
+#include "controllers/ShowScheduler.h"
 #include "core/Cue.h"
+#include "core/Timecode.h"
+#include "core/TimecodeTriggerTable.h"
 #include "core/Transition.h"
+#include "core/TriggerStamp.h"
 
 class CueListModel;
 class OutputRouter;
@@ -16,29 +22,69 @@ class PlaybackController : public QObject {
  public:
   explicit PlaybackController(CueListModel* cueModel, OutputRouter* outputRouter, QObject* parent = nullptr);
 
-  bool playCueAtRow(int row, TransitionStyle style, int durationMs);
+  // A valid stamp measures the GO from its ingress to the cue's first frame
+  // on air.
+  bool playCueAtRow(int row, TransitionStyle style, int durationMs, const TriggerStamp& stamp = {});
   bool previewCueAtRow(int row);
   bool preloadCueAtRow(int row);
-  bool takePreviewCue(TransitionStyle style, int durationMs);
-  bool playCueById(const QString& cueId, TransitionStyle style, int durationMs, bool previewOnly);
-  bool triggerByTimecode(const QString& timecode, TransitionStyle style, int durationMs);
+  bool takePreviewCue(TransitionStyle style, int durationMs, const TriggerStamp& stamp = {});
+  bool playCueById(const QString& cueId, TransitionStyle style, int durationMs, bool previewOnly,
+                   const TriggerStamp& stamp = {});
+  bool triggerByTimecode(const Timecode& timecode, TransitionStyle style, int durationMs,
+                         const TriggerStamp& stamp = {});
+  // Sends the cues at rows out as one grouped GO, so they start on the same
+  // frame rather than one after another. Invalid rows are reported and skipped.
+  bool playCueRowsTogether(const QVector<int>& rows, TransitionStyle style, int durationMs,
+                           const TriggerStamp& stamp = {});
 
   void stopCueAtRow(int row);
+  // Stops one screen's layer, and the follows and auto-stops of cues aimed
+  // at it.
+  void stopLayer(int screenIndex, int layer);
   void stopAll();
 
+  // Rows most likely to go next, most likely first: the chain of automatic
+  // successors of the live cue, then the selection and its chain, the next
+  // exact timecode triggers, and the rows below the selection.
+  QVector<int> upcomingRows(int liveRow, int selectedRow, int count) const;
+
+  // Pending follows, playlist advances and auto-stops.
+  const ShowScheduler* scheduler() const;
+  LatencyMonitor* latencyMonitor() const;
+
  signals:
   void playbackError(const QString& message);
   void playbackStatus(const QString& message);
   void cueWentLive(const Cue& cue);
+  void cuePreviewed(const Cue& cue);
 
  private:
-  static QString normalizeTimecode(const QString& rawTimecode);
-  static bool cueMatchesTimecode(const QString& cueTrigger, const QString& normalizedTimecode);
-  void scheduleFollowCue(const Cue& cue, TransitionStyle style, int durationMs);
-  void schedulePlaylistAdvance(const Cue& cue, TransitionStyle style, int durationMs);
+  struct MediaEndAdvance {
+    QString targetCueId;
+    int leadMs = 0;
+    TransitionStyle style = TransitionStyle::Cut;
+    int durationMs = 0;
+  };
+
+  QVector<GroupGoEntry> routeTogether(const QVector<int>& rows, TransitionStyle style, int durationMs,
+                                      const TriggerStamp& stamp);
+  void scheduleCueActions(const Cue& cue, int row, TransitionStyle style, int durationMs);
+  void scheduleFollowCue(const Cue& cue, int row, TransitionStyle style, int durationMs);
+  void scheduleAdvance(const Cue& cue, ScheduledActionKind kind, int row, int delayMs, TransitionStyle style,
+                       int durationMs);
   void scheduleAutoStop(const Cue& cue);
+  bool playScheduledTarget(const QString& targetCueId, TransitionStyle style, int durationMs);
+  void handleCuePosition(const QString& cueId, double positionSec, double durationSec);
+  void handleCueMediaEnded(const QString& cueId);
+  void fireMediaEndAdvance(const QString& cueId);
 
   CueListModel* cueModel_;
   OutputRouter* outputRouter_;
-  QMap<QString, QString> lastTimecodeByCueId_;
+  ShowScheduler* scheduler_;
+  LatencyMonitor* latency_;
+  TimecodeTriggerTable triggerTable_;
+  QVector<int> triggerMatches_;
+  QHash<QString, Timecode> lastTimecodeByCueId_;
+  Timecode lastTimecode_;
+  QHash<QString, MediaEndAdvance> mediaEndAdvances_;
 };
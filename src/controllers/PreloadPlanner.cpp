@@ -0,0 +1,69 @@
+#include "controllers/PreloadPlanner.h"
+
+#include <utility>
+
+namespace {
+
+constexpr qint64 kFallbackWidth = 1920;
+constexpr qint64 kFallbackHeight = 1080;
+constexpr qint64 kBytesPerPixel = 4;
+// A paused player holds its first frame plus what the decoder has queued
+// behind it.
+constexpr qint64 kQueuedFrames = 4;
+
+}  // namespace
+
+qint64 PreloadPlanner::estimateBytes(const MediaInfo& info) {
+  const bool sized = info.width > 0 && info.height > 0;
+  const qint64 width = sized ? info.width : kFallbackWidth;
+  const qint64 height = sized ? info.height : kFallbackHeight;
+  return width * height * kBytesPerPixel * kQueuedFrames;
+}
+
+PreloadPlan PreloadPlanner::plan(const QVector<PreloadCandidate>& candidates, const PreloadBudget& budget,
+                                 const QSet<QPair<int, int>>& reserved) {
+  PreloadPlan plan;
+  QSet<QPair<int, int>> claimed = reserved;
+  int decoders = static_cast<int>(reserved.size());
+  qint64 bytes = 0;
+
+  for (const PreloadCandidate& candidate : candidates) {
+    QVector<QPair<int, int>> keys;
+    bool conflict = false;
+    for (int screenIndex : candidate.screens) {
+      const QPair<int, int> key(screenIndex, candidate.cue.layer);
+      if (claimed.contains(key)) {
+        conflict = true;
+        break;
+      }
+      if (!keys.contains(key)) {
+        keys.push_back(key);
+      }
+    }
+    if (conflict) {
+      ++plan.layerConflicts;
+      continue;
+    }
+
+    const qint64 cost = candidate.estimatedBytes * keys.size();
+    if (decoders + keys.size() > budget.maxDecoders || (budget.maxBytes > 0 && bytes + cost > budget.maxBytes)) {
+      ++plan.overBudget;
+      continue;
+    }
+
+    for (const QPair<int, int>& key : std::as_const(keys)) {
+      claimed.insert(key);
+      PreloadSlot slot;
+      slot.screenIndex = key.first;
+      slot.layer = key.second;
+      slot.cue = candidate.cue;
+      slot.cue.targetScreen = key.first;
+      plan.slots.push_back(slot);
+    }
+    decoders += keys.size();
+    bytes += cost;
+    plan.plannedBytes += cost;
+    ++plan.plannedCues;
+  }
+  return plan;
+}
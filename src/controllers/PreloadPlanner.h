@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QPair>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include "core/Cue.h"
+#include "core/MediaInfo.h"
+
+struct PreloadBudget {
+  int maxDecoders = 4;
+  qint64 maxBytes = 0;
+};
+
+// An upcoming cue, resolved to the screens it would play on.
+struct PreloadCandidate {
+  Cue cue;
+  QVector<int> screens;
+  qint64 estimatedBytes = 0;
+};
+
+// One standby the plan wants holding a cue.
+struct PreloadSlot {
+  int screenIndex = -1;
+  int layer = 0;
+  Cue cue;
+};
+
+struct PreloadPlan {
+  QVector<PreloadSlot> slots;
+  int plannedCues = 0;
+  qint64 plannedBytes = 0;
+  // Cues passed over because an earlier cue already holds their layer's
+  // standby, or because they would not fit the budget.
+  int layerConflicts = 0;
+  int overBudget = 0;
+};
+
+// Decides which upcoming cues to hold paused in off-air standbys. Every
+// (screen, layer) has one standby, so each layer holds the first upcoming
+// cue that targets it. Cues are taken in order and all-or-nothing across
+// their screens; one that would push the open standbys or their estimated
+// memory past the budget is skipped, and later, cheaper cues may still fit.
+class PreloadPlanner {
+ public:
+  // Rough resident cost of holding a cue paused: its decoded frame queue.
+  // Unprobed media is costed as 1080p.
+  static qint64 estimateBytes(const MediaInfo& info);
+
+  // reserved are (screen, layer) standbys held outside the plan, such as
+  // manual preloads: the plan leaves them alone and counts each as an open
+  // decoder.
+  static PreloadPlan plan(const QVector<PreloadCandidate>& candidates, const PreloadBudget& budget,
+                          const QSet<QPair<int, int>>& reserved = {});
+};
@@ -0,0 +1,137 @@
+#include "controllers/ShowScheduler.h"
+
+#include <QTimer>
+#include <QtGlobal>
+
+#include <utility>
+
+namespace {
+
+constexpr qint64 kNsPerMs = 1000000;
+// The timer has millisecond resolution; anything due within this much of
+// now fires in the current wakeup rather than after another one.
+constexpr qint64 kEarlyToleranceNs = kNsPerMs / 2;
+
+}  // namespace
+
+ShowScheduler::ShowScheduler(QObject* parent) : QObject(parent), timer_(new QTimer(this)) {
+  clock_.start();
+  timer_->setSingleShot(true);
+  timer_->setTimerType(Qt::PreciseTimer);
+  connect(timer_, &QTimer::timeout, this, &ShowScheduler::fireDue);
+}
+
+quint64 ShowScheduler::schedule(ScheduledAction action, int delayMs, std::function<void()> callback) {
+  const qint64 dueNs = clock_.nsecsElapsed() + qMax(0, delayMs) * kNsPerMs;
+  action.handle = nextHandle_++;
+  action.dueMs = dueNs / kNsPerMs;
+
+  Entry entry;
+  entry.action = std::move(action);
+  entry.callback = std::move(callback);
+  entry.slot = queue_.insert(dueNs, entry.action.handle);
+  const quint64 handle = entry.action.handle;
+  entries_.insert(handle, std::move(entry));
+
+  arm();
+  emit pendingChanged();
+  return handle;
+}
+
+bool ShowScheduler::cancel(quint64 handle) {
+  const auto it = entries_.find(handle);
+  if (it == entries_.end()) {
+    return false;
+  }
+
+  removeEntry(it);
+  arm();
+  emit pendingChanged();
+  return true;
+}
+
+int ShowScheduler::cancelForCue(const QString& cueId) {
+  int cancelled = 0;
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it.value().action.cueId == cueId) {
+      queue_.erase(it.value().slot);
+      it = entries_.erase(it);
+      ++cancelled;
+    } else {
+      ++it;
+    }
+  }
+
+  if (cancelled > 0) {
+    arm();
+    emit pendingChanged();
+  }
+  return cancelled;
+}
+
+void ShowScheduler::cancelAll() {
+  if (entries_.isEmpty()) {
+    return;
+  }
+
+  entries_.clear();
+  queue_.clear();
+  timer_->stop();
+  emit pendingChanged();
+}
+
+QVector<ScheduledAction> ShowScheduler::pending() const {
+  QVector<ScheduledAction> actions;
+  actions.reserve(queue_.size());
+  for (auto it = queue_.cbegin(); it != queue_.cend(); ++it) {
+    actions.push_back(entries_.value(it.value()).action);
+  }
+  return actions;
+}
+
+int ShowScheduler::pendingCount() const { return static_cast<int>(entries_.size()); }
+
+qint64 ShowScheduler::nowMs() const { return clock_.elapsed(); }
+
+double ShowScheduler::maxLatenessMs() const { return static_cast<double>(maxLatenessNs_) / kNsPerMs; }
+
+void ShowScheduler::removeEntry(QHash<quint64, Entry>::iterator it) {
+  queue_.erase(it.value().slot);
+  entries_.erase(it);
+}
+
+void ShowScheduler::fireDue() {
+  bool fired = false;
+  // Callbacks may schedule or cancel; every pass re-reads the queue head.
+  while (!queue_.isEmpty()) {
+    const qint64 now = clock_.nsecsElapsed();
+    const auto head = queue_.begin();
+    if (head.key() > now + kEarlyToleranceNs) {
+      break;
+    }
+
+    const auto it = entries_.find(head.value());
+    maxLatenessNs_ = qMax(maxLatenessNs_, now - head.key());
+    const std::function<void()> callback = std::move(it.value().callback);
+    removeEntry(it);
+    fired = true;
+    callback();
+  }
+
+  arm();
+  if (fired) {
+    emit pendingChanged();
+  }
+}
+
+void ShowScheduler::arm() {
+  if (queue_.isEmpty()) {
+    timer_->stop();
+    return;
+  }
+
+  // Round down: waking up to a millisecond early and re-arming for the rest
+  // beats waking up a millisecond late.
+  const qint64 waitNs = queue_.firstKey() - clock_.nsecsElapsed();
+  timer_->start(static_cast<int>(qMax<qint64>(0, waitNs / kNsPerMs)));
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMultiMap>
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+class QTimer;
+
+enum class ScheduledActionKind { Follow, PlaylistAdvance, AutoStop };
+
+struct ScheduledAction {
+  quint64 handle = 0;
+  ScheduledActionKind kind = ScheduledActionKind::Follow;
+  // The cue whose GO scheduled it; stopping or re-going that cue cancels it.
+  QString cueId;
+  // The cue it will play, by id so list edits cannot retarget it.
+  QString targetCueId;
+  QString label;
+  // Deadline on the scheduler's monotonic clock.
+  qint64 dueMs = 0;
+};
+
+// One deadline queue for every timed show action. Deadlines are absolute on
+// a monotonic clock and a single precise timer is armed for the earliest, so
+// a late wakeup does not push later actions back and thousands of pending
+// actions cost one timer. Actions are cancellable by handle, by owning cue
+// or all at once.
+class ShowScheduler : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit ShowScheduler(QObject* parent = nullptr);
+
+  quint64 schedule(ScheduledAction action, int delayMs, std::function<void()> callback);
+  bool cancel(quint64 handle);
+  int cancelForCue(const QString& cueId);
+  void cancelAll();
+
+  // Pending actions, earliest first.
+  QVector<ScheduledAction> pending() const;
+  int pendingCount() const;
+  qint64 nowMs() const;
+  // Worst gap between a deadline and its callback so far.
+  double maxLatenessMs() const;
+
+ signals:
+  void pendingChanged();
+
+ private:
+  struct Entry {
+    ScheduledAction action;
+    std::function<void()> callback;
+    QMultiMap<qint64, quint64>::iterator slot;
+  };
+
+  void removeEntry(QHash<quint64, Entry>::iterator it);
+  void fireDue();
+  void arm();
+
+  QElapsedTimer clock_;
+  QTimer* timer_;
+  quint64 nextHandle_ = 1;
+  QMultiMap<qint64, quint64> queue_;
+  QHash<quint64, Entry> entries_;
+  qint64 maxLatenessNs_ = 0;
+};
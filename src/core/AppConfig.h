@@ -3,6 +3,7 @@
 #include <QMap>
 #include <QString>
 
+#include "core/RenderBackend.h"
 #include "core/Transition.h"
 
 struct AppConfig {
@@ -28,4 +29,12 @@ struct AppConfig {
   int failoverPeerPort = 9101;
   int failoverListenPort = 9101;
   QString failoverSharedKey;
+  RenderBackend renderBackend = RenderBackend::NativeWindows;
+  int prefetchBudgetMb = 512;
+  int prefetchHeadMb = 32;
+  int timecodeFreewheelMs = 1000;
+  // Upcoming cues held paused in standby players; 0 turns it off.
+  int standbyLookahead = 4;
+  int standbyMaxDecoders = 4;
+  int standbyBudgetMb = 1024;
 };
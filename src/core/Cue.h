@@ -4,33 +4,53 @@
 
 #include "core/Transition.h"
 
+// When auto-follow and playlist advance fire: after their fixed delay, or when
+// the live media reaches its end (optionally a lead time before it).
+enum class AdvanceTrigger {
+  AfterDelay = 0,
+  MediaEnd = 1,
+};
+
+inline QString advanceTriggerToString(AdvanceTrigger trigger) {
+  return trigger == AdvanceTrigger::MediaEnd ? "media_end" : "after_delay";
+}
+
+inline AdvanceTrigger advanceTriggerFromString(const QString& value) {
+  return value.trimmed().toLower() == "media_end" ? AdvanceTrigger::MediaEnd : AdvanceTrigger::AfterDelay;
+}
+
+// Field order only: what the trigger, follow and playlist paths read on every
+// GO comes first and packs together; display and routing strings follow. The
+// compact per-row arrays those paths use live in CueGraph and CueIndex.
 struct Cue {
   QString id;
-  QString name;
-  QString filePath;
-  int targetScreen = 0;
-  QString targetSetId;
-  int layer = 0;
-  bool loop = false;
-  QString hotkey;
-  QString timecodeTrigger;
   int midiNote = -1;
   int dmxChannel = -1;
   int dmxValue = 255;
+  int followCueRow = -1;
+  int followDelayMs = 0;
+  int playlistAdvanceDelayMs = 0;
+  int advanceLeadMs = 0;
+  int autoStopMs = 0;
+  int targetScreen = 0;
+  int layer = 0;
+  int transitionDurationMs = 600;
+  TransitionStyle transitionStyle = TransitionStyle::Fade;
+  AdvanceTrigger advanceTrigger = AdvanceTrigger::AfterDelay;
+  bool autoFollow = false;
+  bool playlistAutoAdvance = false;
+  bool playlistLoop = false;
+  bool loop = false;
   bool preload = false;
   bool isLiveInput = false;
+  bool useTransitionOverride = false;
+  QString playlistId;
+  QString timecodeTrigger;
+  QString hotkey;
+  QString name;
+  QString filePath;
+  QString targetSetId;
   QString liveInputUrl;
   QString filterPresetId;
   QString videoFilter;
-  bool useTransitionOverride = false;
-  TransitionStyle transitionStyle = TransitionStyle::Fade;
-  int transitionDurationMs = 600;
-  bool autoFollow = false;
-  int followCueRow = -1;
-  int followDelayMs = 0;
-  QString playlistId;
-  bool playlistAutoAdvance = false;
-  bool playlistLoop = false;
-  int playlistAdvanceDelayMs = 0;
-  int autoStopMs = 0;
 };
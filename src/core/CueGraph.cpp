@@ -0,0 +1,153 @@
+#include "core/CueGraph.h"
+
+#include <algorithm>
+
+namespace {
+
+bool hasExplicitFollow(const Cue& cue) { return cue.autoFollow && cue.followCueRow >= 0; }
+
+bool sameEdges(const Cue& lhs, const Cue& rhs) {
+  return lhs.autoFollow == rhs.autoFollow && lhs.followCueRow == rhs.followCueRow &&
+         lhs.playlistId.trimmed() == rhs.playlistId.trimmed() &&
+         lhs.playlistAutoAdvance == rhs.playlistAutoAdvance && lhs.playlistLoop == rhs.playlistLoop;
+}
+
+}  // namespace
+
+void CueGraph::rebuild(const QVector<Cue>& cues) {
+  successor_.fill(-1, cues.size());
+  playlistRows_.clear();
+  explicitFollowers_.clear();
+
+  for (int row = 0; row < cues.size(); ++row) {
+    const Cue& cue = cues.at(row);
+    addToPlaylist(cue.playlistId.trimmed(), row);
+    if (hasExplicitFollow(cue)) {
+      explicitFollowers_.insert(cue.followCueRow, row);
+    }
+  }
+  for (int row = 0; row < cues.size(); ++row) {
+    refreshRow(cues, row);
+  }
+}
+
+void CueGraph::rowInserted(const QVector<Cue>& cues, int row) {
+  if (row != cues.size() - 1 || successor_.size() != row) {
+    rebuild(cues);
+    return;
+  }
+
+  // Appending renumbers nothing. Only edges that can now reach the new row
+  // change: its playlist, an implicit follow from the row above, and
+  // explicit follows that pointed past the end.
+  successor_.push_back(-1);
+  const Cue& cue = cues.at(row);
+  if (hasExplicitFollow(cue)) {
+    explicitFollowers_.insert(cue.followCueRow, row);
+  }
+
+  const QString playlistId = cue.playlistId.trimmed();
+  addToPlaylist(playlistId, row);
+  refreshPlaylist(cues, playlistId);
+  refreshRow(cues, row);
+  if (row > 0) {
+    refreshRow(cues, row - 1);
+  }
+  const auto [first, last] = explicitFollowers_.equal_range(row);
+  for (auto it = first; it != last; ++it) {
+    refreshRow(cues, it.value());
+  }
+}
+
+void CueGraph::rowRemoved(const QVector<Cue>& cues) { rebuild(cues); }
+
+void CueGraph::rowUpdated(const QVector<Cue>& cues, int row, const Cue& previous) {
+  if (row < 0 || row >= successor_.size() || sameEdges(cues.at(row), previous)) {
+    return;
+  }
+
+  const Cue& cue = cues.at(row);
+  if (hasExplicitFollow(previous)) {
+    explicitFollowers_.remove(previous.followCueRow, row);
+  }
+  if (hasExplicitFollow(cue)) {
+    explicitFollowers_.insert(cue.followCueRow, row);
+  }
+
+  const QString previousPlaylist = previous.playlistId.trimmed();
+  const QString playlistId = cue.playlistId.trimmed();
+  if (previousPlaylist != playlistId) {
+    removeFromPlaylist(previousPlaylist, row);
+    addToPlaylist(playlistId, row);
+    refreshPlaylist(cues, previousPlaylist);
+  }
+  refreshPlaylist(cues, playlistId);
+  refreshRow(cues, row);
+}
+
+int CueGraph::successor(int row) const { return row >= 0 && row < successor_.size() ? successor_.at(row) : -1; }
+
+QVector<int> CueGraph::lookahead(int row, int count) const {
+  QVector<int> rows;
+  for (int next = successor(row); next >= 0 && next != row && rows.size() < count; next = successor(next)) {
+    if (rows.contains(next)) {
+      break;
+    }
+    rows.push_back(next);
+  }
+  return rows;
+}
+
+void CueGraph::addToPlaylist(const QString& playlistId, int row) {
+  if (playlistId.isEmpty()) {
+    return;
+  }
+  QVector<int>& rows = playlistRows_[playlistId];
+  rows.insert(std::lower_bound(rows.begin(), rows.end(), row), row);
+}
+
+void CueGraph::removeFromPlaylist(const QString& playlistId, int row) {
+  const auto it = playlistRows_.find(playlistId);
+  if (it == playlistRows_.end()) {
+    return;
+  }
+  it.value().removeOne(row);
+  if (it.value().isEmpty()) {
+    playlistRows_.erase(it);
+  }
+}
+
+void CueGraph::refreshPlaylist(const QVector<Cue>& cues, const QString& playlistId) {
+  const auto it = playlistRows_.constFind(playlistId);
+  if (it == playlistRows_.constEnd()) {
+    return;
+  }
+  for (int row : it.value()) {
+    refreshRow(cues, row);
+  }
+}
+
+void CueGraph::refreshRow(const QVector<Cue>& cues, int row) {
+  const Cue& cue = cues.at(row);
+
+  int playlistNext = -1;
+  const auto it = playlistRows_.constFind(cue.playlistId.trimmed());
+  if (it != playlistRows_.constEnd()) {
+    const QVector<int>& rows = it.value();
+    const auto position = std::upper_bound(rows.cbegin(), rows.cend(), row);
+    if (position != rows.cend()) {
+      playlistNext = *position;
+    } else if (cue.playlistLoop && rows.first() != row) {
+      playlistNext = rows.first();
+    }
+  }
+
+  int next = -1;
+  if (cue.autoFollow) {
+    const int followRow = cue.followCueRow >= 0 ? cue.followCueRow : row + 1;
+    next = followRow < cues.size() ? followRow : -1;
+  } else if (cue.playlistAutoAdvance) {
+    next = playlistNext;
+  }
+  successor_[row] = next;
+}
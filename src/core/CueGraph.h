@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QHash>
+#include <QMultiHash>
+#include <QString>
+#include <QVector>
+
+#include "core/Cue.h"
+
+// Follow and playlist successor edges between cue rows. CueListModel keeps
+// it in step with every edit, so resolving the next cue is a lookup instead
+// of a scan. Edits that only touch one cue refresh that cue's playlist
+// neighbours; removals and non-append inserts renumber rows and rebuild.
+class CueGraph {
+ public:
+  void rebuild(const QVector<Cue>& cues);
+  // cues already contains the new row.
+  void rowInserted(const QVector<Cue>& cues, int row);
+  void rowRemoved(const QVector<Cue>& cues);
+  void rowUpdated(const QVector<Cue>& cues, int row, const Cue& previous);
+
+  // The row that auto-follows or playlist-advances from row, or -1.
+  int successor(int row) const;
+  // Up to count rows reached by chaining successors from row, without
+  // repeats; row itself is not included.
+  QVector<int> lookahead(int row, int count) const;
+
+ private:
+  void addToPlaylist(const QString& playlistId, int row);
+  void removeFromPlaylist(const QString& playlistId, int row);
+  void refreshPlaylist(const QVector<Cue>& cues, const QString& playlistId);
+  void refreshRow(const QVector<Cue>& cues, int row);
+
+  QVector<int> successor_;
+  // Rows per trimmed playlist id, ascending.
+  QHash<QString, QVector<int>> playlistRows_;
+  // Explicit follow target row -> rows that auto-follow into it.
+  QMultiHash<int, int> explicitFollowers_;
+};
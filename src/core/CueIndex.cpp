@@ -0,0 +1,148 @@
+#include "core/CueIndex.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+template <typename Key>
+void insertRow(QHash<Key, QVector<int>>* index, const Key& key, int row) {
+  QVector<int>& rows = (*index)[key];
+  rows.insert(std::lower_bound(rows.begin(), rows.end(), row), row);
+}
+
+template <typename Key>
+void removeRowFrom(QHash<Key, QVector<int>>* index, const Key& key, int row) {
+  const auto it = index->find(key);
+  if (it == index->end()) {
+    return;
+  }
+  it.value().removeOne(row);
+  if (it.value().isEmpty()) {
+    index->erase(it);
+  }
+}
+
+template <typename Key>
+int firstRow(const QHash<Key, QVector<int>>& index, const Key& key) {
+  const auto it = index.constFind(key);
+  return it != index.constEnd() ? it.value().first() : -1;
+}
+
+bool sameKeys(const Cue& lhs, const Cue& rhs) {
+  return lhs.id == rhs.id && lhs.midiNote == rhs.midiNote && lhs.dmxChannel == rhs.dmxChannel &&
+         lhs.dmxValue == rhs.dmxValue && lhs.hotkey.trimmed() == rhs.hotkey.trimmed();
+}
+
+}  // namespace
+
+void CueIndex::rebuild(const QVector<Cue>& cues) {
+  idRows_.clear();
+  noteRows_.clear();
+  dmxThresholds_.clear();
+  hotkeyRows_.clear();
+  for (int row = 0; row < cues.size(); ++row) {
+    addRow(cues.at(row), row);
+  }
+}
+
+void CueIndex::rowInserted(const QVector<Cue>& cues, int row) {
+  // Only an append leaves existing rows where they were.
+  if (row != cues.size() - 1) {
+    rebuild(cues);
+    return;
+  }
+  addRow(cues.at(row), row);
+}
+
+void CueIndex::rowRemoved(const QVector<Cue>& cues) { rebuild(cues); }
+
+void CueIndex::rowUpdated(const QVector<Cue>& cues, int row, const Cue& previous) {
+  if (row < 0 || row >= cues.size() || sameKeys(cues.at(row), previous)) {
+    return;
+  }
+  removeRow(previous, row);
+  addRow(cues.at(row), row);
+}
+
+int CueIndex::rowForId(const QString& cueId) const { return firstRow(idRows_, cueId); }
+
+int CueIndex::rowForMidiNote(int note) const { return firstRow(noteRows_, note); }
+
+int CueIndex::rowForDmx(int channel, int value) const {
+  const auto it = dmxThresholds_.constFind(channel);
+  if (it == dmxThresholds_.constEnd()) {
+    return -1;
+  }
+
+  // Every threshold up to value fires; the prefix minimum picks the lowest
+  // row among them.
+  const QVector<DmxThreshold>& thresholds = it.value();
+  const auto reached = std::upper_bound(thresholds.cbegin(), thresholds.cend(), value,
+                                        [](int level, const DmxThreshold& entry) { return level < entry.threshold; });
+  return reached == thresholds.cbegin() ? -1 : std::prev(reached)->lowestRow;
+}
+
+int CueIndex::rowForHotkey(const QString& hotkey) const { return firstRow(hotkeyRows_, hotkey); }
+
+void CueIndex::addRow(const Cue& cue, int row) {
+  if (!cue.id.isEmpty()) {
+    insertRow(&idRows_, cue.id, row);
+  }
+  if (cue.midiNote >= 0) {
+    insertRow(&noteRows_, cue.midiNote, row);
+  }
+  if (cue.dmxChannel >= 0) {
+    addDmx(cue.dmxChannel, cue.dmxValue, row);
+  }
+  const QString hotkey = cue.hotkey.trimmed();
+  if (!hotkey.isEmpty()) {
+    insertRow(&hotkeyRows_, hotkey, row);
+  }
+}
+
+void CueIndex::removeRow(const Cue& cue, int row) {
+  removeRowFrom(&idRows_, cue.id, row);
+  removeRowFrom(&noteRows_, cue.midiNote, row);
+  removeDmx(cue.dmxChannel, row);
+  removeRowFrom(&hotkeyRows_, cue.hotkey.trimmed(), row);
+}
+
+void CueIndex::addDmx(int channel, int threshold, int row) {
+  QVector<DmxThreshold>& thresholds = dmxThresholds_[channel];
+  const auto position = std::upper_bound(thresholds.begin(), thresholds.end(), threshold,
+                                         [](int level, const DmxThreshold& entry) { return level < entry.threshold; });
+  const int index = static_cast<int>(position - thresholds.begin());
+  thresholds.insert(index, {threshold, row, row});
+
+  refreshLowestRows(&thresholds, index);
+}
+
+void CueIndex::removeDmx(int channel, int row) {
+  const auto it = dmxThresholds_.find(channel);
+  if (it == dmxThresholds_.end()) {
+    return;
+  }
+
+  QVector<DmxThreshold>& thresholds = it.value();
+  const auto position = std::find_if(thresholds.begin(), thresholds.end(),
+                                     [row](const DmxThreshold& entry) { return entry.row == row; });
+  if (position == thresholds.end()) {
+    return;
+  }
+  const int index = static_cast<int>(position - thresholds.begin());
+  thresholds.removeAt(index);
+  if (thresholds.isEmpty()) {
+    dmxThresholds_.erase(it);
+    return;
+  }
+
+  refreshLowestRows(&thresholds, index);
+}
+
+void CueIndex::refreshLowestRows(QVector<DmxThreshold>* thresholds, int from) {
+  for (int i = from; i < thresholds->size(); ++i) {
+    DmxThreshold& entry = (*thresholds)[i];
+    entry.lowestRow = i > 0 ? qMin(thresholds->at(i - 1).lowestRow, entry.row) : entry.row;
+  }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include "core/Cue.h"
+
+// Secondary lookups over cue rows for the external trigger paths: id, MIDI
+// note, DMX channel and hotkey. Kept in step with CueListModel edits like
+// CueGraph; lookups are hash probes and a binary search, and never
+// allocate. Where several cues share a key the lowest row wins, as the list
+// scans they replace did.
+class CueIndex {
+ public:
+  void rebuild(const QVector<Cue>& cues);
+  // cues already contains the new row.
+  void rowInserted(const QVector<Cue>& cues, int row);
+  void rowRemoved(const QVector<Cue>& cues);
+  void rowUpdated(const QVector<Cue>& cues, int row, const Cue& previous);
+
+  int rowForId(const QString& cueId) const;
+  int rowForMidiNote(int note) const;
+  // Lowest row on channel whose threshold value reaches.
+  int rowForDmx(int channel, int value) const;
+  // hotkey as stored on the cue, trimmed.
+  int rowForHotkey(const QString& hotkey) const;
+
+ private:
+  struct DmxThreshold {
+    int threshold = 0;
+    int row = -1;
+    // Lowest row among this and every lower threshold on the channel.
+    int lowestRow = -1;
+  };
+
+  void addRow(const Cue& cue, int row);
+  void removeRow(const Cue& cue, int row);
+  void addDmx(int channel, int threshold, int row);
+  void removeDmx(int channel, int row);
+  static void refreshLowestRows(QVector<DmxThreshold>* thresholds, int from);
+
+  QHash<QString, QVector<int>> idRows_;
+  QHash<int, QVector<int>> noteRows_;
+  // Per channel, ascending by threshold.
+  QHash<int, QVector<DmxThreshold>> dmxThresholds_;
+  QHash<QString, QVector<int>> hotkeyRows_;
+};
@@ -1,6 +1,46 @@
 #include "core/CueListModel.h"
 
 #include <QFileInfo>
+#include <QStringList>
+
+namespace {
+
+QString formatLength(double seconds) {
+  const int totalSeconds = qRound(seconds);
+  const int hours = totalSeconds / 3600;
+  const int minutes = (totalSeconds / 60) % 60;
+  const int secs = totalSeconds % 60;
+  if (hours > 0) {
+    return QString("%1:%2:%3").arg(hours).arg(minutes, 2, 10, QChar('0')).arg(secs, 2, 10, QChar('0'));
+  }
+  return QString("%1:%2").arg(minutes).arg(secs, 2, 10, QChar('0'));
+}
+
+QString describeMedia(const MediaInfo& info) {
+  if (!info.error.isEmpty()) {
+    return QString("Probe failed: %1").arg(info.error);
+  }
+
+  QStringList parts;
+  if (!info.videoCodec.isEmpty()) {
+    parts.push_back(info.videoCodec);
+  }
+  if (info.width > 0 && info.height > 0) {
+    parts.push_back(QString("%1x%2").arg(info.width).arg(info.height));
+  }
+  if (info.frameRate > 0.0) {
+    parts.push_back(QString("%1 fps").arg(info.frameRate, 0, 'f', 3));
+  }
+  if (info.hasAlpha) {
+    parts.push_back("alpha");
+  }
+  if (info.intraOnly) {
+    parts.push_back("intra-only");
+  }
+  return parts.join(", ");
+}
+
+}  // namespace
 
 CueListModel::CueListModel(QObject* parent) : QAbstractTableModel(parent) {}
 
@@ -8,7 +48,7 @@ int CueListModel::rowCount(const QModelIndex& parent) const {
   if (parent.isValid()) {
     return 0;
   }
-  return cues_.size();
+  return store_.size();
 }
 
 int CueListModel::columnCount(const QModelIndex& parent) const {
@@ -23,7 +63,7 @@ QVariant CueListModel::data(const QModelIndex& index, int role) const {
     return {};
   }
 
-  const Cue& cue = cues_.at(index.row());
+  const Cue& cue = store_.at(index.row());
 
   if (role == Qt::DisplayRole) {
     switch (index.column()) {
@@ -34,6 +74,16 @@ QVariant CueListModel::data(const QModelIndex& index, int role) const {
           return QString("[Live] %1").arg(cue.liveInputUrl);
         }
         return QFileInfo(cue.filePath).fileName();
+      case LengthColumn: {
+        const auto it = media_.constFind(cue.filePath);
+        if (cue.isLiveInput || it == media_.constEnd()) {
+          return {};
+        }
+        if (it.value().missing) {
+          return "Missing";
+        }
+        return it.value().durationSec > 0.0 ? formatLength(it.value().durationSec) : QString("-");
+      }
       case ScreenColumn:
         return cue.targetScreen;
       case LayerColumn:
@@ -58,6 +108,11 @@ QVariant CueListModel::data(const QModelIndex& index, int role) const {
     return cue.filePath;
   }
 
+  if (role == Qt::ToolTipRole && index.column() == LengthColumn) {
+    const auto it = media_.constFind(cue.filePath);
+    return it != media_.constEnd() ? describeMedia(it.value()) : QVariant();
+  }
+
   return {};
 }
 
@@ -71,6 +126,8 @@ QVariant CueListModel::headerData(int section, Qt::Orientation orientation, int
       return "Cue";
     case FileColumn:
       return "File";
+    case LengthColumn:
+      return "Length";
     case ScreenColumn:
       return "Screen";
     case LayerColumn:
@@ -96,8 +153,11 @@ Qt::ItemFlags CueListModel::flags(const QModelIndex& index) const {
 }
 
 void CueListModel::addCue(const Cue& cue) {
-  beginInsertRows(QModelIndex(), cues_.size(), cues_.size());
-  cues_.push_back(cue);
+  const int row = store_.size();
+  beginInsertRows(QModelIndex(), row, row);
+  store_.append(cue);
+  graph_.rowInserted(store_.cues(), row);
+  index_.rowInserted(store_.cues(), row);
   endInsertRows();
 }
 
@@ -106,7 +166,9 @@ void CueListModel::removeCue(int row) {
     return;
   }
   beginRemoveRows(QModelIndex(), row, row);
-  cues_.removeAt(row);
+  store_.removeAt(row);
+  graph_.rowRemoved(store_.cues());
+  index_.rowRemoved(store_.cues());
   endRemoveRows();
 }
 
@@ -115,7 +177,10 @@ void CueListModel::updateCue(int row, const Cue& cue) {
     return;
   }
 
-  cues_[row] = cue;
+  const Cue previous = store_.at(row);
+  store_.replace(row, cue);
+  graph_.rowUpdated(store_.cues(), row, previous);
+  index_.rowUpdated(store_.cues(), row, previous);
   const QModelIndex left = index(row, 0);
   const QModelIndex right = index(row, ColumnCount - 1);
   emit dataChanged(left, right);
@@ -123,32 +188,46 @@ void CueListModel::updateCue(int row, const Cue& cue) {
 
 void CueListModel::setCues(const QVector<Cue>& cues) {
   beginResetModel();
-  cues_ = cues;
+  store_.assign(cues);
+  graph_.rebuild(store_.cues());
+  index_.rebuild(store_.cues());
   endResetModel();
 }
 
-Cue CueListModel::cueAt(int row) const {
-  if (!isValidRow(row)) {
-    return {};
-  }
-  return cues_.at(row);
-}
+const Cue& CueListModel::cueAt(int row) const { return store_.at(row); }
 
-QVector<Cue> CueListModel::cues() const { return cues_; }
+const QVector<Cue>& CueListModel::cues() const { return store_.cues(); }
 
 bool CueListModel::isValidRow(int row) const {
-  return row >= 0 && row < cues_.size();
+  return store_.isValidRow(row);
 }
 
-int CueListModel::rowForCueId(const QString& cueId) const {
-  if (cueId.isEmpty()) {
-    return -1;
+int CueListModel::rowForCueId(const QString& cueId) const { return index_.rowForId(cueId); }
+
+int CueListModel::rowForMidiNote(int note) const { return index_.rowForMidiNote(note); }
+
+int CueListModel::rowForDmx(int channel, int value) const { return index_.rowForDmx(channel, value); }
+
+int CueListModel::rowForHotkey(const QString& hotkey) const { return index_.rowForHotkey(hotkey); }
+
+int CueListModel::successorRow(int row) const { return graph_.successor(row); }
+
+QVector<int> CueListModel::lookaheadRows(int row, int count) const { return graph_.lookahead(row, count); }
+
+void CueListModel::setMediaInfo(const MediaInfo& info) {
+  const auto existing = media_.constFind(info.path);
+  if (existing != media_.constEnd() && existing.value() == info) {
+    return;
   }
 
-  for (int i = 0; i < cues_.size(); ++i) {
-    if (cues_.at(i).id == cueId) {
-      return i;
+  media_.insert(info.path, info);
+  const QVector<Cue>& cues = store_.cues();
+  for (int row = 0; row < cues.size(); ++row) {
+    if (cues.at(row).filePath == info.path) {
+      const QModelIndex cell = index(row, LengthColumn);
+      emit dataChanged(cell, cell);
     }
   }
-  return -1;
 }
+
+MediaInfo CueListModel::mediaInfo(const QString& path) const { return media_.value(path); }
@@ -1,9 +1,14 @@
 #pragma once
 
 #include <QAbstractTableModel>
+#include <QHash>
 #include <QVector>
 
 #include "core/Cue.h"
+#include "core/CueGraph.h"
+#include "core/CueIndex.h"
+#include "core/CueStore.h"
+#include "core/MediaInfo.h"
 
 class CueListModel : public QAbstractTableModel {
   Q_OBJECT
@@ -12,6 +17,7 @@ class CueListModel : public QAbstractTableModel {
   enum Column {
     NameColumn = 0,
     FileColumn,
+    LengthColumn,
     ScreenColumn,
     LayerColumn,
     LoopColumn,
@@ -34,11 +40,27 @@ class CueListModel : public QAbstractTableModel {
   void updateCue(int row, const Cue& cue);
   void setCues(const QVector<Cue>& cues);
 
-  Cue cueAt(int row) const;
-  QVector<Cue> cues() const;
+  // References stay valid until the next edit to the list.
+  const Cue& cueAt(int row) const;
+  const QVector<Cue>& cues() const;
   bool isValidRow(int row) const;
   int rowForCueId(const QString& cueId) const;
+  // Trigger lookups; the lowest matching row, or -1.
+  int rowForMidiNote(int note) const;
+  int rowForDmx(int channel, int value) const;
+  int rowForHotkey(const QString& hotkey) const;
+
+  // Follow/playlist edges, kept current on every edit.
+  int successorRow(int row) const;
+  QVector<int> lookaheadRows(int row, int count) const;
+
+  // Probe results keyed by media path; rows showing that file are refreshed.
+  void setMediaInfo(const MediaInfo& info);
+  MediaInfo mediaInfo(const QString& path) const;
 
  private:
-  QVector<Cue> cues_;
+  CueStore store_;
+  CueGraph graph_;
+  CueIndex index_;
+  QHash<QString, MediaInfo> media_;
 };
@@ -0,0 +1,95 @@
+#include "core/CueStore.h"
+
+#include <utility>
+
+namespace {
+
+const Cue kEmptyCue;
+
+}  // namespace
+
+int CueStore::size() const { return static_cast<int>(cues_.size()); }
+
+bool CueStore::isValidRow(int row) const { return row >= 0 && row < cues_.size(); }
+
+const Cue& CueStore::at(int row) const { return isValidRow(row) ? cues_.at(row) : kEmptyCue; }
+
+const QVector<Cue>& CueStore::cues() const { return cues_; }
+
+void CueStore::append(Cue cue) {
+  intern(&cue);
+  cues_.push_back(std::move(cue));
+}
+
+void CueStore::replace(int row, Cue cue) {
+  if (!isValidRow(row)) {
+    return;
+  }
+  intern(&cue);
+  release(cues_.at(row));
+  cues_[row] = std::move(cue);
+}
+
+void CueStore::removeAt(int row) {
+  if (isValidRow(row)) {
+    release(cues_.at(row));
+    cues_.removeAt(row);
+  }
+}
+
+void CueStore::assign(QVector<Cue> cues) {
+  strings_.clear();
+  cues_ = std::move(cues);
+  for (Cue& cue : cues_) {
+    intern(&cue);
+  }
+  cues_.squeeze();
+}
+
+int CueStore::internedCount() const { return static_cast<int>(strings_.size()); }
+
+void CueStore::intern(Cue* cue) {
+  // Names, ids, hotkeys and timecode triggers are nearly always unique to
+  // their cue; interning them would only grow the table.
+  intern(&cue->playlistId);
+  intern(&cue->filePath);
+  intern(&cue->targetSetId);
+  intern(&cue->liveInputUrl);
+  intern(&cue->filterPresetId);
+  intern(&cue->videoFilter);
+}
+
+void CueStore::intern(QString* value) {
+  if (value->isEmpty()) {
+    return;
+  }
+  const auto it = strings_.find(*value);
+  if (it != strings_.end()) {
+    *value = it.key();
+    ++it.value();
+    return;
+  }
+  // Trim spare capacity left by whatever built the string before it becomes
+  // the copy every later cue shares.
+  value->squeeze();
+  strings_.insert(*value, 1);
+}
+
+void CueStore::release(const Cue& cue) {
+  release(cue.playlistId);
+  release(cue.filePath);
+  release(cue.targetSetId);
+  release(cue.liveInputUrl);
+  release(cue.filterPresetId);
+  release(cue.videoFilter);
+}
+
+void CueStore::release(const QString& value) {
+  if (value.isEmpty()) {
+    return;
+  }
+  const auto it = strings_.find(value);
+  if (it != strings_.end() && --it.value() <= 0) {
+    strings_.erase(it);
+  }
+}
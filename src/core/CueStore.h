@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include "core/Cue.h"
+
+// The cue rows behind CueListModel. Strings that repeat across a show (media
+// paths, playlist ids, target sets, filter presets and chains, live input
+// URLs) are interned on the way in, so every cue carrying the same value
+// shares one buffer. Each interned value counts the cue fields holding it
+// and is dropped once the last one is edited or removed. Rows are handed out by const reference; callers copy a
+// Cue only when they mean to edit it or keep it past the next list change.
+class CueStore {
+ public:
+  int size() const;
+  bool isValidRow(int row) const;
+  // An empty cue for rows out of range.
+  const Cue& at(int row) const;
+  const QVector<Cue>& cues() const;
+
+  void append(Cue cue);
+  void replace(int row, Cue cue);
+  void removeAt(int row);
+  void assign(QVector<Cue> cues);
+
+  int internedCount() const;
+
+ private:
+  void intern(Cue* cue);
+  void intern(QString* value);
+  void release(const Cue& cue);
+  void release(const QString& value);
+
+  QVector<Cue> cues_;
+  // Interned value -> cue fields holding it.
+  QHash<QString, int> strings_;
+};
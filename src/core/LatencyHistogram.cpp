@@ -0,0 +1,65 @@
+#include "core/LatencyHistogram.h"
+
+#include <bit>
+#include <cmath>
+
+void LatencyHistogram::record(qint64 us) {
+  us = qMax<qint64>(0, us);
+  ++buckets_[bucketFor(us)];
+  minUs_ = count_ == 0 ? us : qMin(minUs_, us);
+  maxUs_ = qMax(maxUs_, us);
+  sumUs_ += us;
+  ++count_;
+}
+
+void LatencyHistogram::clear() { *this = LatencyHistogram(); }
+
+qint64 LatencyHistogram::count() const { return count_; }
+
+qint64 LatencyHistogram::minUs() const { return minUs_; }
+
+qint64 LatencyHistogram::maxUs() const { return maxUs_; }
+
+double LatencyHistogram::meanUs() const { return count_ > 0 ? static_cast<double>(sumUs_) / count_ : 0.0; }
+
+qint64 LatencyHistogram::percentileUs(double percentile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+
+  const double clamped = qBound(0.0, percentile, 100.0);
+  const qint64 rank = qMax<qint64>(1, static_cast<qint64>(std::ceil(clamped / 100.0 * count_)));
+  qint64 seen = 0;
+  for (int i = 0; i < kBucketCount; ++i) {
+    seen += buckets_[i];
+    if (seen >= rank) {
+      return qMin(bucketUpperUs(i), maxUs_);
+    }
+  }
+  return maxUs_;
+}
+
+int LatencyHistogram::bucketFor(qint64 us) {
+  if (us < kSubBuckets) {
+    return static_cast<int>(us);
+  }
+
+  int exponent = static_cast<int>(std::bit_width(static_cast<quint64>(us))) - 1;
+  if (exponent > kMaxExponent) {
+    exponent = kMaxExponent;
+    us = (qint64(1) << (kMaxExponent + 1)) - 1;
+  }
+  const int sub = static_cast<int>(us >> (exponent - kSubBits)) - kSubBuckets;
+  return kSubBuckets + (exponent - kSubBits) * kSubBuckets + sub;
+}
+
+qint64 LatencyHistogram::bucketUpperUs(int index) {
+  if (index < kSubBuckets) {
+    return index;
+  }
+
+  const int shift = (index - kSubBuckets) / kSubBuckets;
+  const int sub = (index - kSubBuckets) % kSubBuckets;
+  const qint64 lower = static_cast<qint64>(kSubBuckets + sub) << shift;
+  return lower + (qint64(1) << shift) - 1;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <array>
+
+// Latencies in microseconds, bucketed log-linearly: exact below 16 us, then
+// 16 buckets per power of two up to about 35 minutes. A reported percentile
+// is the upper edge of its bucket, so it never understates and is within
+// 1/16 of the true value. Fixed size; recording never allocates.
+class LatencyHistogram {
+ public:
+  void record(qint64 us);
+  void clear();
+
+  qint64 count() const;
+  qint64 minUs() const;
+  qint64 maxUs() const;
+  double meanUs() const;
+  // percentile in 0..100; 0 when empty.
+  qint64 percentileUs(double percentile) const;
+
+ private:
+  static constexpr int kSubBits = 4;
+  static constexpr int kSubBuckets = 1 << kSubBits;
+  static constexpr int kMaxExponent = 30;
+  static constexpr int kBucketCount = kSubBuckets + (kMaxExponent - kSubBits + 1) * kSubBuckets;
+
+  static int bucketFor(qint64 us);
+  static qint64 bucketUpperUs(int index);
+
+  std::array<qint64, kBucketCount> buckets_{};
+  qint64 count_ = 0;
+  qint64 sumUs_ = 0;
+  qint64 minUs_ = 0;
+  qint64 maxUs_ = 0;
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <QString>
+
+// What the media library knows about one file. An entry is only trusted while
+// the file's size and modification time still match the ones it was probed at.
+struct MediaInfo {
+  QString path;
+  qint64 sizeBytes = 0;
+  qint64 modifiedMs = 0;
+  bool missing = false;
+  bool probed = false;
+  QString error;
+  double durationSec = 0.0;
+  QString videoCodec;
+  int width = 0;
+  int height = 0;
+  double frameRate = 0.0;
+  bool hasAlpha = false;
+  // Every frame is a keyframe (ProRes, DNxHD, HAP, ...), so seeks and loop
+  // points land without decoding a GOP first.
+  bool intraOnly = false;
+
+  bool matches(qint64 size, qint64 modified) const { return sizeBytes == size && modifiedMs == modified; }
+  bool operator==(const MediaInfo& other) const = default;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <QString>
+
+// How an output window puts layers on screen.
+enum class RenderBackend {
+  // One native child window per layer, each bound to mpv as its wid.
+  NativeWindows = 0,
+  // One compositor widget per output that pulls every layer through the libmpv
+  // software render API and blends them with per-layer opacity.
+  SoftwareCompositor = 1,
+};
+
+inline QString renderBackendToString(RenderBackend backend) {
+  switch (backend) {
+    case RenderBackend::SoftwareCompositor:
+      return "software_compositor";
+    case RenderBackend::NativeWindows:
+    default:
+      return "native_windows";
+  }
+}
+
+inline RenderBackend renderBackendFromString(const QString& value) {
+  if (value.trimmed().toLower() == "software_compositor") {
+    return RenderBackend::SoftwareCompositor;
+  }
+  return RenderBackend::NativeWindows;
+}
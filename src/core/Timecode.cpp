@@ -0,0 +1,189 @@
+#include "core/Timecode.h"
+
+namespace {
+
+constexpr int kFieldCount = 4;
+
+int* fieldAt(TimecodeParts* parts, int index) {
+  switch (index) {
+    case 0:
+      return &parts->hour;
+    case 1:
+      return &parts->minute;
+    case 2:
+      return &parts->second;
+    default:
+      return &parts->frame;
+  }
+}
+
+// Parses one or two ASCII digits; "*" yields -1 when wildcards are allowed.
+bool parseField(QStringView text, bool allowWildcard, int* value) {
+  if (allowWildcard && text == QStringView(u"*")) {
+    *value = -1;
+    return true;
+  }
+  if (text.isEmpty() || text.size() > 2) {
+    return false;
+  }
+
+  int result = 0;
+  for (const QChar ch : text) {
+    if (ch < u'0' || ch > u'9') {
+      return false;
+    }
+    result = result * 10 + (ch.unicode() - u'0');
+  }
+  *value = result;
+  return true;
+}
+
+bool isSeparator(QChar ch, int field) {
+  // Drop-frame is conventionally written with ';' (or '.') before the frames.
+  return ch == u':' || (field == 2 && (ch == u';' || ch == u'.'));
+}
+
+bool validRate(int fps, bool dropFrame) {
+  if (fps <= 0 || fps > Timecode::kMaxFps) {
+    return false;
+  }
+  return !dropFrame || fps == 30 || fps == 60;
+}
+
+int droppedPerMinute(int fps) { return fps / 15; }
+
+qint32 framesInDay(int fps, bool dropFrame) {
+  if (!dropFrame) {
+    return fps * 86400;
+  }
+  const qint32 perTenMinutes = fps * 600 - 9 * droppedPerMinute(fps);
+  return perTenMinutes * 144;
+}
+
+}  // namespace
+
+bool parseTimecodeParts(QStringView text, bool allowWildcard, TimecodeParts* parts, bool* dropFrame) {
+  const QStringView trimmed = text.trimmed();
+  if (trimmed.isEmpty()) {
+    return false;
+  }
+
+  TimecodeParts parsed;
+  bool hasWildcard = false;
+  bool drop = false;
+  int field = 0;
+  qsizetype start = 0;
+  for (qsizetype i = 0; i <= trimmed.size(); ++i) {
+    if (i < trimmed.size() && !isSeparator(trimmed.at(i), field)) {
+      continue;
+    }
+    if (field >= kFieldCount || !parseField(trimmed.mid(start, i - start), allowWildcard, fieldAt(&parsed, field))) {
+      return false;
+    }
+    if (field == 2 && i < trimmed.size()) {
+      drop = trimmed.at(i) != u':';
+    }
+    hasWildcard = hasWildcard || *fieldAt(&parsed, field) < 0;
+    ++field;
+    start = i + 1;
+  }
+
+  // Exact timecodes may omit frames; wildcard triggers always spell out all
+  // four fields.
+  if (field < 3 || (hasWildcard && field != kFieldCount)) {
+    return false;
+  }
+  *parts = parsed;
+  if (dropFrame != nullptr) {
+    *dropFrame = drop;
+  }
+  return true;
+}
+
+Timecode Timecode::fromFrames(qint32 frames, int fps, bool dropFrame) {
+  if (!validRate(fps, dropFrame) || frames < 0 || frames >= framesInDay(fps, dropFrame)) {
+    return {};
+  }
+  return Timecode(frames, fps, dropFrame);
+}
+
+Timecode Timecode::fromParts(const TimecodeParts& parts, int fps, bool dropFrame) {
+  if (!validRate(fps, dropFrame) || parts.hour < 0 || parts.hour > 23 || parts.minute < 0 || parts.minute > 59 ||
+      parts.second < 0 || parts.second > 59 || parts.frame < 0 || parts.frame >= fps) {
+    return {};
+  }
+
+  const qint32 totalMinutes = parts.hour * 60 + parts.minute;
+  qint32 frames = (totalMinutes * 60 + parts.second) * fps + parts.frame;
+  if (dropFrame) {
+    const int dropped = droppedPerMinute(fps);
+    // Those frame numbers do not exist in a drop-frame count.
+    if (parts.second == 0 && parts.minute % 10 != 0 && parts.frame < dropped) {
+      return {};
+    }
+    frames -= dropped * (totalMinutes - totalMinutes / 10);
+  }
+  return Timecode(frames, fps, dropFrame);
+}
+
+bool Timecode::parse(QStringView text, Timecode* timecode, int fps) {
+  TimecodeParts parts;
+  bool dropFrame = false;
+  if (!parseTimecodeParts(text, false, &parts, &dropFrame)) {
+    return false;
+  }
+
+  const Timecode parsed = fromParts(parts, fps, dropFrame);
+  if (!parsed.isValid()) {
+    return false;
+  }
+  *timecode = parsed;
+  return true;
+}
+
+qint32 Timecode::framesPerDay() const { return framesInDay(fps_, dropFrame_); }
+
+double Timecode::framesPerSecond() const { return dropFrame_ ? fps_ * 1000.0 / 1001.0 : fps_; }
+
+TimecodeParts Timecode::parts() const {
+  TimecodeParts parts;
+  if (!isValid()) {
+    return parts;
+  }
+
+  // Drop-frame: add back the skipped frame numbers, then split as if the
+  // count never dropped any.
+  qint32 frames = frames_;
+  if (dropFrame_) {
+    const int dropped = droppedPerMinute(fps_);
+    const qint32 perMinute = fps_ * 60 - dropped;
+    const qint32 perTenMinutes = fps_ * 600 - 9 * dropped;
+    const qint32 tens = frames / perTenMinutes;
+    const qint32 remainder = frames % perTenMinutes;
+    frames += 9 * dropped * tens;
+    if (remainder > dropped) {
+      frames += dropped * ((remainder - dropped) / perMinute);
+    }
+  }
+
+  parts.frame = frames % fps_;
+  const qint32 totalSeconds = frames / fps_;
+  parts.second = totalSeconds % 60;
+  parts.minute = (totalSeconds / 60) % 60;
+  parts.hour = totalSeconds / 3600;
+  return parts;
+}
+
+QString Timecode::toString() const {
+  if (!isValid()) {
+    return {};
+  }
+
+  const TimecodeParts fields = parts();
+  return QString("%1:%2:%3%4%5")
+      .arg(fields.hour, 2, 10, QChar('0'))
+      .arg(fields.minute, 2, 10, QChar('0'))
+      .arg(fields.second, 2, 10, QChar('0'))
+      .arg(dropFrame_ ? QChar(';') : QChar(':'))
+      .arg(fields.frame, 2, 10, QChar('0'));
+}
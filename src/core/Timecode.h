@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QString>
+#include <QStringView>
+#include <QtGlobal>
+
+// HH:MM:SS:FF split into fields. In a trigger, a field of -1 is a wildcard.
+struct TimecodeParts {
+  int hour = 0;
+  int minute = 0;
+  int second = 0;
+  int frame = 0;
+};
+
+// Splits "H:M:S" or "H:M:S:F" (one or two digits per field) without
+// allocating. A ';' or '.' before the frame field marks drop-frame. With
+// allowWildcard, any field may be "*" but then all four must be present.
+bool parseTimecodeParts(QStringView text, bool allowWildcard, TimecodeParts* parts, bool* dropFrame = nullptr);
+
+// SMPTE timecode packed as frames since midnight plus the nominal frame rate.
+// Drop-frame (29.97 and 59.94 counted at 30 and 60) skips the first two or
+// four frame numbers of every minute that is not a multiple of ten. Plain
+// value type: copying, comparing and field conversion never allocate.
+class Timecode {
+ public:
+  static constexpr int kDefaultFps = 30;
+  static constexpr int kMaxFps = 120;
+
+  constexpr Timecode() = default;
+
+  // Invalid when out of range for the rate, or drop-frame on a rate other
+  // than 30 or 60.
+  static Timecode fromFrames(qint32 frames, int fps = kDefaultFps, bool dropFrame = false);
+  static Timecode fromParts(const TimecodeParts& parts, int fps = kDefaultFps, bool dropFrame = false);
+  // The separator before the frame field decides drop-frame; fields must be
+  // in range for fps.
+  static bool parse(QStringView text, Timecode* timecode, int fps = kDefaultFps);
+
+  bool isValid() const { return frames_ >= 0; }
+  qint32 frames() const { return frames_; }
+  int fps() const { return fps_; }
+  bool dropFrame() const { return dropFrame_; }
+  // Frames in 24 hours at this rate; positions wrap here.
+  qint32 framesPerDay() const;
+  // Real frames per second: drop-frame runs 1000/1001 slower than nominal.
+  double framesPerSecond() const;
+  TimecodeParts parts() const;
+  QString toString() const;
+
+  friend bool operator==(const Timecode& lhs, const Timecode& rhs) = default;
+
+ private:
+  constexpr Timecode(qint32 frames, int fps, bool dropFrame)
+      : frames_(frames), fps_(static_cast<quint8>(fps)), dropFrame_(dropFrame) {}
+
+  qint32 frames_ = -1;
+  quint8 fps_ = kDefaultFps;
+  bool dropFrame_ = false;
+};
@@ -0,0 +1,114 @@
+#include "core/TimecodeTriggerTable.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+constexpr int kFieldCount = 4;
+constexpr int kExactMask = (1 << kFieldCount) - 1;
+// Above every field's range, frames at up to kMaxFps included.
+constexpr int kFieldRadix = 128;
+static_assert(kFieldRadix > Timecode::kMaxFps, "Frame numbers would spill into seconds");
+
+int fieldValue(const TimecodeParts& parts, int index) {
+  switch (index) {
+    case 0:
+      return parts.hour;
+    case 1:
+      return parts.minute;
+    case 2:
+      return parts.second;
+    default:
+      return parts.frame;
+  }
+}
+
+}  // namespace
+
+bool TimecodeTriggerTable::parseTrigger(const QString& text, TimecodeParts* parts) {
+  return parseTimecodeParts(text, true, parts);
+}
+
+void TimecodeTriggerTable::rebuild(const QVector<Cue>& cues) {
+  clear();
+
+  QHash<int, int> bucketByMask;
+  for (int row = 0; row < cues.size(); ++row) {
+    const QString& text = cues.at(row).timecodeTrigger;
+    TimecodeParts trigger;
+    if (text.isEmpty() || !parseTrigger(text, &trigger)) {
+      continue;
+    }
+
+    const int mask = maskOf(trigger);
+    auto it = bucketByMask.constFind(mask);
+    if (it == bucketByMask.constEnd()) {
+      it = bucketByMask.insert(mask, buckets_.size());
+      buckets_.push_back({mask, {}});
+    }
+    const qint64 key = pack(trigger, mask);
+    buckets_[it.value()].rows.insert(key, row);
+    if (mask == kExactMask) {
+      exactOrder_.push_back({key, row});
+    }
+    ++triggerCount_;
+  }
+  std::sort(exactOrder_.begin(), exactOrder_.end());
+}
+
+void TimecodeTriggerTable::clear() {
+  buckets_.clear();
+  exactOrder_.clear();
+  triggerCount_ = 0;
+}
+
+void TimecodeTriggerTable::match(const Timecode& timecode, QVector<int>* rows) const {
+  rows->clear();
+  if (!timecode.isValid()) {
+    return;
+  }
+
+  const TimecodeParts parts = timecode.parts();
+  for (const Bucket& bucket : buckets_) {
+    const auto [first, last] = bucket.rows.equal_range(pack(parts, bucket.mask));
+    for (auto it = first; it != last; ++it) {
+      rows->push_back(it.value());
+    }
+  }
+  std::sort(rows->begin(), rows->end());
+}
+
+void TimecodeTriggerTable::upcoming(const Timecode& timecode, int count, QVector<int>* rows) const {
+  if (!timecode.isValid() || count <= 0) {
+    return;
+  }
+
+  const QPair<qint64, int> after{pack(timecode.parts(), kExactMask), std::numeric_limits<int>::max()};
+  auto it = std::upper_bound(exactOrder_.cbegin(), exactOrder_.cend(), after);
+  for (int added = 0; it != exactOrder_.cend() && added < count; ++it, ++added) {
+    rows->push_back(it->second);
+  }
+}
+
+int TimecodeTriggerTable::triggerCount() const { return triggerCount_; }
+
+int TimecodeTriggerTable::maskOf(const TimecodeParts& trigger) {
+  int mask = 0;
+  for (int i = 0; i < kFieldCount; ++i) {
+    if (fieldValue(trigger, i) >= 0) {
+      mask |= 1 << i;
+    }
+  }
+  return mask;
+}
+
+qint64 TimecodeTriggerTable::pack(const TimecodeParts& parts, int mask) {
+  // One kFieldRadix digit per field, wildcard fields zeroed, so every bucket
+  // key is unique within its mask.
+  qint64 key = 0;
+  for (int i = 0; i < kFieldCount; ++i) {
+    key = key * kFieldRadix + ((mask & (1 << i)) != 0 ? fieldValue(parts, i) : 0);
+  }
+  return key;
+}
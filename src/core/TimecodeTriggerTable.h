@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+#include "core/Cue.h"
+#include "core/Timecode.h"
+
+// Cue timecode triggers compiled once per cue list change. Triggers are
+// bucketed by which fields they pin down; exact triggers are the bucket with
+// all four fields set. A tick hashes the incoming timecode once per bucket
+// in use, so its cost is the number of matches plus at most 16 lookups,
+// independent of the number of cues.
+class TimecodeTriggerTable {
+ public:
+  // An exact timecode, or exactly four fields where any may be "*". Trigger
+  // fields are compared as written, whatever the incoming frame rate.
+  static bool parseTrigger(const QString& text, TimecodeParts* parts);
+
+  void rebuild(const QVector<Cue>& cues);
+  void clear();
+  // Replaces rows with the rows whose trigger matches, ascending. Reuses the
+  // caller's buffer so a tick without matches does not allocate.
+  void match(const Timecode& timecode, QVector<int>* rows) const;
+  // Appends the rows of up to count exact triggers that come after
+  // timecode, soonest first. Wildcard triggers repeat and are left out.
+  void upcoming(const Timecode& timecode, int count, QVector<int>* rows) const;
+  int triggerCount() const;
+
+ private:
+  struct Bucket {
+    int mask = 0;
+    QMultiHash<qint64, int> rows;
+  };
+
+  static int maskOf(const TimecodeParts& trigger);
+  static qint64 pack(const TimecodeParts& parts, int mask);
+
+  QVector<Bucket> buckets_;
+  // Exact triggers as (packed key, row), ascending; packed keys sort in
+  // timecode order.
+  QVector<QPair<qint64, int>> exactOrder_;
+  int triggerCount_ = 0;
+};
@@ -0,0 +1,270 @@
+#include "core/Trace.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+
+#include <memory>
+#include <vector>
+
+#include "core/TriggerStamp.h"
+
+namespace {
+
+constexpr int kEventsPerThread = Trace::kEventsPerThread;
+constexpr int kDetailBytes = 48;
+
+struct TraceEvent {
+  const char* category = nullptr;
+  const char* name = nullptr;
+  qint64 startNs = 0;
+  // -1 marks an instant event.
+  qint64 durationNs = -1;
+  char detail[kDetailBytes] = {};
+};
+
+// Written only by its own thread. size is published with release after the
+// event it counts, so a reader that sees the session never sees a torn event.
+// A thread resets its buffer itself on its first event of a new session.
+// Once the thread exits the buffer is handed to the next new thread, unless
+// it still holds events of the running session.
+struct ThreadBuffer {
+  ThreadBuffer(int threadId, const QString& name)
+      : events(std::make_unique<TraceEvent[]>(kEventsPerThread)), tid(threadId), threadName(name) {}
+
+  std::unique_ptr<TraceEvent[]> events;
+  std::atomic<int> size{0};
+  std::atomic<quint64> session{0};
+  std::atomic<qint64> dropped{0};
+  int tid = 0;
+  QString threadName;
+  // Guarded by the registry mutex.
+  bool inUse = true;
+};
+
+// Buffers live for the process; the mutex only guards registration, release
+// and export walking the list, never an append.
+struct TraceRegistry {
+  QMutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  std::atomic<quint64> session{0};
+  std::atomic<qint64> sessionStartNs{0};
+};
+
+TraceRegistry& registry() {
+  static TraceRegistry instance;
+  return instance;
+}
+
+QString currentThreadName(int tid) {
+  const QThread* thread = QThread::currentThread();
+  if (!thread->objectName().isEmpty()) {
+    return thread->objectName();
+  }
+  if (QCoreApplication::instance() != nullptr && thread == QCoreApplication::instance()->thread()) {
+    return "GUI";
+  }
+  return QString("thread %1").arg(tid);
+}
+
+ThreadBuffer* acquireBuffer() {
+  TraceRegistry& traces = registry();
+  QMutexLocker locker(&traces.mutex);
+  const quint64 session = traces.session.load(std::memory_order_acquire);
+  for (const std::unique_ptr<ThreadBuffer>& buffer : traces.buffers) {
+    if (!buffer->inUse && buffer->session.load(std::memory_order_relaxed) != session) {
+      buffer->inUse = true;
+      buffer->threadName = currentThreadName(buffer->tid);
+      return buffer.get();
+    }
+  }
+
+  const int tid = static_cast<int>(traces.buffers.size()) + 1;
+  traces.buffers.push_back(std::make_unique<ThreadBuffer>(tid, currentThreadName(tid)));
+  return traces.buffers.back().get();
+}
+
+// Returns the thread's buffer to the registry when the thread exits.
+struct LocalBuffer {
+  ~LocalBuffer() {
+    if (buffer != nullptr) {
+      QMutexLocker locker(&registry().mutex);
+      buffer->inUse = false;
+    }
+  }
+
+  ThreadBuffer* buffer = nullptr;
+};
+
+ThreadBuffer* localBuffer() {
+  thread_local LocalBuffer local;
+  if (local.buffer == nullptr) {
+    local.buffer = acquireBuffer();
+  }
+  return local.buffer;
+}
+
+void append(const char* category, const char* name, qint64 startNs, qint64 durationNs, const QString& detail) {
+  TraceRegistry& traces = registry();
+  const quint64 session = traces.session.load(std::memory_order_acquire);
+  // Spans already open when the session started would land before its origin.
+  if (startNs < traces.sessionStartNs.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  ThreadBuffer* buffer = localBuffer();
+  if (buffer->session.load(std::memory_order_relaxed) != session) {
+    buffer->size.store(0, std::memory_order_relaxed);
+    buffer->dropped.store(0, std::memory_order_relaxed);
+    buffer->session.store(session, std::memory_order_release);
+  }
+
+  const int index = buffer->size.load(std::memory_order_relaxed);
+  if (index >= kEventsPerThread) {
+    buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  TraceEvent& event = buffer->events[index];
+  event.category = category;
+  event.name = name;
+  event.startNs = startNs;
+  event.durationNs = durationNs;
+  if (detail.isEmpty()) {
+    event.detail[0] = '\0';
+  } else {
+    const QByteArray utf8 = detail.toUtf8();
+    const int keep = qMin<int>(utf8.size(), kDetailBytes - 1);
+    qstrncpy(event.detail, utf8.constData() + utf8.size() - keep, keep + 1);
+  }
+  buffer->size.store(index + 1, std::memory_order_release);
+}
+
+}  // namespace
+
+void Trace::start() {
+  TraceRegistry& traces = registry();
+  traces.sessionStartNs.store(monotonicNowNs(), std::memory_order_relaxed);
+  traces.session.fetch_add(1, std::memory_order_acq_rel);
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Trace::stop() { enabled_.store(false, std::memory_order_relaxed); }
+
+void Trace::complete(const char* category, const char* name, qint64 startNs, qint64 endNs, const QString& detail) {
+  if (!isEnabled() || startNs < 0) {
+    return;
+  }
+  append(category, name, startNs, qMax<qint64>(0, endNs - startNs), detail);
+}
+
+void Trace::instant(const char* category, const char* name, const QString& detail) {
+  if (!isEnabled()) {
+    return;
+  }
+  append(category, name, monotonicNowNs(), -1, detail);
+}
+
+QByteArray Trace::toChromeJson(TraceStats* stats) {
+  TraceRegistry& traces = registry();
+  const quint64 session = traces.session.load(std::memory_order_acquire);
+  const qint64 originNs = traces.sessionStartNs.load(std::memory_order_relaxed);
+  const qint64 pid = QCoreApplication::applicationPid();
+  const QString processName =
+      QCoreApplication::applicationName().isEmpty() ? "VideoPlayerForMe" : QCoreApplication::applicationName();
+
+  QJsonArray events;
+  events.push_back(QJsonObject{{"name", "process_name"},
+                               {"ph", "M"},
+                               {"pid", pid},
+                               {"tid", 0},
+                               {"args", QJsonObject{{"name", processName}}}});
+
+  TraceStats totals;
+  QMutexLocker locker(&traces.mutex);
+  totals.buffers = static_cast<int>(traces.buffers.size());
+  for (const std::unique_ptr<ThreadBuffer>& buffer : traces.buffers) {
+    if (session == 0 || buffer->session.load(std::memory_order_acquire) != session) {
+      continue;
+    }
+
+    const int size = buffer->size.load(std::memory_order_acquire);
+    totals.dropped += buffer->dropped.load(std::memory_order_relaxed);
+    if (size == 0) {
+      continue;
+    }
+
+    ++totals.threads;
+    totals.events += size;
+    events.push_back(QJsonObject{{"name", "thread_name"},
+                                 {"ph", "M"},
+                                 {"pid", pid},
+                                 {"tid", buffer->tid},
+                                 {"args", QJsonObject{{"name", buffer->threadName}}}});
+
+    for (int i = 0; i < size; ++i) {
+      const TraceEvent& event = buffer->events[i];
+      QJsonObject object;
+      object.insert("name", QString::fromUtf8(event.name));
+      object.insert("cat", QString::fromUtf8(event.category));
+      object.insert("pid", pid);
+      object.insert("tid", buffer->tid);
+      object.insert("ts", (event.startNs - originNs) / 1000.0);
+      if (event.durationNs >= 0) {
+        object.insert("ph", "X");
+        object.insert("dur", event.durationNs / 1000.0);
+      } else {
+        object.insert("ph", "i");
+        object.insert("s", "t");
+      }
+      if (event.detail[0] != '\0') {
+        object.insert("args", QJsonObject{{"detail", QString::fromUtf8(event.detail)}});
+      }
+      events.push_back(object);
+    }
+  }
+
+  if (stats != nullptr) {
+    *stats = totals;
+  }
+
+  QJsonObject root;
+  root.insert("traceEvents", events);
+  root.insert("displayTimeUnit", "ms");
+  return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+bool Trace::writeChromeJson(const QString& filePath, TraceStats* stats, QString* errorMessage) {
+  QFile file(filePath);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    if (errorMessage != nullptr) {
+      *errorMessage = QString("Failed to open trace file for writing: %1").arg(file.errorString());
+    }
+    return false;
+  }
+
+  const QByteArray payload = toChromeJson(stats);
+  const qint64 written = file.write(payload);
+  if (written != payload.size() || !file.flush()) {
+    if (errorMessage != nullptr) {
+      *errorMessage = QString("Failed to write trace file: %1").arg(file.errorString());
+    }
+    return false;
+  }
+
+  return true;
+}
+
+TraceScope::TraceScope(const char* category, const char* name)
+    : category_(category), name_(name), startNs_(Trace::isEnabled() ? monotonicNowNs() : -1) {}
+
+TraceScope::~TraceScope() {
+  if (startNs_ >= 0) {
+    Trace::complete(category_, name_, startNs_, monotonicNowNs(), detail_);
+  }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+struct TraceStats {
+  int events = 0;
+  qint64 dropped = 0;
+  int threads = 0;
+  // Thread buffers allocated so far, in use or waiting for a new thread.
+  int buffers = 0;
+};
+
+// Opt-in span tracing of the GO pipeline, exported as Chrome trace JSON that
+// opens in ui.perfetto.dev or chrome://tracing. Every thread appends to its
+// own fixed-size buffer without taking a lock; a full buffer drops further
+// events and counts them. While disabled a span costs one relaxed load.
+// Category and name must be string literals: only the pointers are kept.
+class Trace {
+ public:
+  // Per thread and session; later events are dropped.
+  static constexpr int kEventsPerThread = 1 << 14;
+
+  // Starts a new session, discarding the previous one's events.
+  static void start();
+  static void stop();
+  static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  // A span from startNs to endNs on monotonicNowNs(). A detail longer than
+  // 47 UTF-8 bytes keeps its end, where a path has its file name.
+  static void complete(const char* category, const char* name, qint64 startNs, qint64 endNs,
+                       const QString& detail = {});
+  static void instant(const char* category, const char* name, const QString& detail = {});
+
+  // Call after stop(); a thread still inside a span may otherwise add to it.
+  static QByteArray toChromeJson(TraceStats* stats = nullptr);
+  static bool writeChromeJson(const QString& filePath, TraceStats* stats, QString* errorMessage);
+
+ private:
+  inline static std::atomic<bool> enabled_{false};
+};
+
+// Records the enclosing scope as one complete span. The detail is made only
+// while tracing is on, so formatting it costs nothing otherwise.
+class TraceScope {
+ public:
+  TraceScope(const char* category, const char* name);
+  template <typename MakeDetail>
+    requires std::is_invocable_r_v<QString, MakeDetail>
+  TraceScope(const char* category, const char* name, MakeDetail&& makeDetail) : TraceScope(category, name) {
+    if (startNs_ >= 0) {
+      detail_ = std::forward<MakeDetail>(makeDetail)();
+    }
+  }
+  ~TraceScope();
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  const char* category_;
+  const char* name_;
+  QString detail_;
+  qint64 startNs_ = -1;
+};
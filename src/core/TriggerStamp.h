@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QString>
+
+#include <chrono>
+
+// Where a GO came from. Count is the number of sources, not a source.
+enum class TriggerSource {
+  Osc = 0,
+  Midi,
+  Dmx,
+  Hotkey,
+  Timecode,
+  Count,
+};
+
+inline QString triggerSourceToString(TriggerSource source) {
+  switch (source) {
+    case TriggerSource::Osc:
+      return "osc";
+    case TriggerSource::Midi:
+      return "midi";
+    case TriggerSource::Dmx:
+      return "dmx";
+    case TriggerSource::Hotkey:
+      return "hotkey";
+    case TriggerSource::Timecode:
+      return "timecode";
+    case TriggerSource::Count:
+      break;
+  }
+  return "unknown";
+}
+
+// Monotonic nanoseconds on a clock shared by every thread, so a stamp taken
+// on an input thread can be compared with one taken on the GUI thread.
+inline qint64 monotonicNowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// When and through which input a trigger entered the process, taken as close
+// to the socket or callback as the input allows. GOs without a stamp (follows,
+// playlist advances, the mouse) are not measured.
+struct TriggerStamp {
+  TriggerSource source = TriggerSource::Osc;
+  qint64 ingressNs = -1;
+
+  bool isValid() const { return ingressNs >= 0; }
+  static TriggerStamp now(TriggerSource source) { return {source, monotonicNowNs()}; }
+};
@@ -0,0 +1,331 @@
+#include "media/MediaLibrary.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QThread>
+#include <QThreadPool>
+#include <QTimer>
+
+extern "C" {
+#include <mpv/client.h>
+}
+
+namespace {
+
+constexpr int kIndexVersion = 1;
+constexpr int kProbeTimeoutMs = 5000;
+constexpr int kSaveDelayMs = 2000;
+constexpr int kMaxProbeThreads = 4;
+
+bool isLikelyUrl(const QString& path) { return path.contains("://"); }
+
+QString propertyString(mpv_handle* mpv, const char* name) {
+  char* value = mpv_get_property_string(mpv, name);
+  if (value == nullptr) {
+    return {};
+  }
+  const QString result = QString::fromUtf8(value);
+  mpv_free(value);
+  return result;
+}
+
+double propertyDouble(mpv_handle* mpv, const char* name) {
+  double value = 0.0;
+  return mpv_get_property(mpv, name, MPV_FORMAT_DOUBLE, &value) >= 0 ? value : 0.0;
+}
+
+int propertyInt(mpv_handle* mpv, const char* name) {
+  int64_t value = 0;
+  return mpv_get_property(mpv, name, MPV_FORMAT_INT64, &value) >= 0 ? static_cast<int>(value) : 0;
+}
+
+bool isIntraOnlyCodec(const QString& codec) {
+  static const QSet<QString> kIntraCodecs = {"prores", "dnxhd", "hap",     "mjpeg",    "png",  "qtrle", "cfhd",
+                                             "v210",   "dxv",   "rawvideo", "jpeg2000", "ffv1", "utvideo"};
+  return kIntraCodecs.contains(codec.toLower());
+}
+
+bool isAlphaPixelFormat(const QString& format) {
+  static const QStringList kAlphaPrefixes = {"yuva", "rgba", "bgra", "argb", "abgr", "gbrap", "ya"};
+  for (const QString& prefix : kAlphaPrefixes) {
+    if (format.startsWith(prefix)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Opens the file paused in a throwaway headless mpv and waits for the first
+// decoded frame so the video parameters are populated.
+void probeWithMpv(MediaInfo* info) {
+  mpv_handle* mpv = mpv_create();
+  if (mpv == nullptr) {
+    info->error = "libmpv unavailable";
+    return;
+  }
+
+  mpv_set_option_string(mpv, "vo", "null");
+  mpv_set_option_string(mpv, "ao", "null");
+  mpv_set_option_string(mpv, "aid", "no");
+  mpv_set_option_string(mpv, "sid", "no");
+  mpv_set_option_string(mpv, "hwdec", "no");
+  mpv_set_option_string(mpv, "pause", "yes");
+  mpv_set_option_string(mpv, "idle", "yes");
+  mpv_set_option_string(mpv, "terminal", "no");
+  mpv_set_option_string(mpv, "load-scripts", "no");
+  mpv_set_option_string(mpv, "ytdl", "no");
+  if (mpv_initialize(mpv) < 0) {
+    mpv_terminate_destroy(mpv);
+    info->error = "libmpv initialize failed";
+    return;
+  }
+
+  const QByteArray encodedPath = info->path.toUtf8();
+  const char* loadArgs[] = {"loadfile", encodedPath.constData(), nullptr};
+  if (mpv_command(mpv, loadArgs) < 0) {
+    mpv_terminate_destroy(mpv);
+    info->error = "loadfile failed";
+    return;
+  }
+
+  bool loaded = false;
+  bool restarted = false;
+  QElapsedTimer timer;
+  timer.start();
+  while (!restarted && timer.elapsed() < kProbeTimeoutMs) {
+    const double remainingSec = (kProbeTimeoutMs - timer.elapsed()) / 1000.0;
+    const mpv_event* event = mpv_wait_event(mpv, remainingSec);
+    if (event->event_id == MPV_EVENT_NONE) {
+      break;
+    }
+    if (event->event_id == MPV_EVENT_FILE_LOADED) {
+      loaded = true;
+    } else if (event->event_id == MPV_EVENT_PLAYBACK_RESTART) {
+      restarted = true;
+    } else if (event->event_id == MPV_EVENT_END_FILE) {
+      const auto* endFile = static_cast<const mpv_event_end_file*>(event->data);
+      if (endFile != nullptr && endFile->reason == MPV_END_FILE_REASON_ERROR) {
+        info->error = QString::fromUtf8(mpv_error_string(endFile->error));
+      }
+      break;
+    }
+  }
+
+  if (!loaded) {
+    if (info->error.isEmpty()) {
+      info->error = "probe timed out";
+    }
+    mpv_terminate_destroy(mpv);
+    return;
+  }
+
+  info->probed = true;
+  info->durationSec = propertyDouble(mpv, "duration");
+  info->videoCodec = propertyString(mpv, "current-tracks/video/codec");
+  info->width = propertyInt(mpv, "current-tracks/video/demux-w");
+  info->height = propertyInt(mpv, "current-tracks/video/demux-h");
+  info->frameRate = propertyDouble(mpv, "current-tracks/video/demux-fps");
+  info->hasAlpha = isAlphaPixelFormat(propertyString(mpv, "video-params/pixelformat"));
+  info->intraOnly = isIntraOnlyCodec(info->videoCodec);
+  mpv_terminate_destroy(mpv);
+}
+
+// Runs on a pool thread. The cached entry is a copy taken on the GUI thread.
+MediaInfo statAndProbe(const QString& path, const MediaInfo& cached, bool* reused) {
+  *reused = false;
+  MediaInfo info;
+  info.path = path;
+
+  const QFileInfo fileInfo(path);
+  if (!fileInfo.exists()) {
+    info.missing = true;
+    return info;
+  }
+
+  info.sizeBytes = fileInfo.size();
+  info.modifiedMs = fileInfo.lastModified().toMSecsSinceEpoch();
+  if (cached.probed && cached.matches(info.sizeBytes, info.modifiedMs)) {
+    *reused = true;
+    MediaInfo current = cached;
+    current.missing = false;
+    return current;
+  }
+
+  probeWithMpv(&info);
+  return info;
+}
+
+QJsonObject infoToJson(const MediaInfo& info) {
+  QJsonObject object;
+  object.insert("path", info.path);
+  object.insert("sizeBytes", info.sizeBytes);
+  object.insert("modifiedMs", info.modifiedMs);
+  object.insert("error", info.error);
+  object.insert("durationSec", info.durationSec);
+  object.insert("videoCodec", info.videoCodec);
+  object.insert("width", info.width);
+  object.insert("height", info.height);
+  object.insert("frameRate", info.frameRate);
+  object.insert("hasAlpha", info.hasAlpha);
+  object.insert("intraOnly", info.intraOnly);
+  return object;
+}
+
+MediaInfo infoFromJson(const QJsonObject& object) {
+  MediaInfo info;
+  info.path = object.value("path").toString();
+  info.sizeBytes = object.value("sizeBytes").toInteger();
+  info.modifiedMs = object.value("modifiedMs").toInteger();
+  info.probed = true;
+  info.error = object.value("error").toString();
+  info.durationSec = object.value("durationSec").toDouble(0.0);
+  info.videoCodec = object.value("videoCodec").toString();
+  info.width = object.value("width").toInt(0);
+  info.height = object.value("height").toInt(0);
+  info.frameRate = object.value("frameRate").toDouble(0.0);
+  info.hasAlpha = object.value("hasAlpha").toBool(false);
+  info.intraOnly = object.value("intraOnly").toBool(false);
+  return info;
+}
+
+}  // namespace
+
+MediaLibrary::MediaLibrary(const QString& indexPath, QObject* parent)
+    : QObject(parent), indexPath_(indexPath), pool_(new QThreadPool(this)), saveTimer_(new QTimer(this)) {
+  // Probing competes with playback for decode time, so keep the pool small.
+  pool_->setMaxThreadCount(qBound(1, QThread::idealThreadCount() / 2, kMaxProbeThreads));
+
+  saveTimer_->setSingleShot(true);
+  saveTimer_->setInterval(kSaveDelayMs);
+  connect(saveTimer_, &QTimer::timeout, this, [this]() { saveIndex(); });
+
+  loadIndex();
+}
+
+MediaLibrary::~MediaLibrary() {
+  pool_->clear();
+  pool_->waitForDone();
+  if (saveTimer_->isActive()) {
+    saveIndex();
+  }
+}
+
+void MediaLibrary::scan(const QStringList& paths) {
+  for (const QString& path : paths) {
+    if (path.trimmed().isEmpty() || isLikelyUrl(path) || pending_.contains(path)) {
+      continue;
+    }
+
+    pending_.insert(path);
+    const MediaInfo cached = index_.value(path);
+    pool_->start([this, path, cached]() {
+      bool reused = false;
+      const MediaInfo info = statAndProbe(path, cached, &reused);
+      QMetaObject::invokeMethod(this, [this, info, reused]() { handleResult(info, reused); }, Qt::QueuedConnection);
+    });
+  }
+}
+
+MediaInfo MediaLibrary::info(const QString& path) const { return index_.value(path); }
+
+bool MediaLibrary::isKnown(const QString& path) const { return index_.contains(path); }
+
+bool MediaLibrary::isMissing(const QString& path) const {
+  const auto it = index_.constFind(path);
+  return it != index_.constEnd() && it.value().missing;
+}
+
+int MediaLibrary::pendingCount() const { return pending_.size(); }
+
+bool MediaLibrary::saveIndex(QString* errorMessage) const {
+  if (indexPath_.isEmpty()) {
+    return false;
+  }
+
+  QJsonArray entries;
+  for (auto it = index_.constBegin(); it != index_.constEnd(); ++it) {
+    // Missing files are re-checked on every scan anyway.
+    if (it.value().probed) {
+      entries.push_back(infoToJson(it.value()));
+    }
+  }
+
+  QJsonObject root;
+  root.insert("version", kIndexVersion);
+  root.insert("entries", entries);
+
+  QDir().mkpath(QFileInfo(indexPath_).absolutePath());
+  QSaveFile file(indexPath_);
+  if (!file.open(QIODevice::WriteOnly)) {
+    if (errorMessage != nullptr) {
+      *errorMessage = QString("Failed to write media index: %1").arg(file.errorString());
+    }
+    return false;
+  }
+
+  file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+  if (!file.commit()) {
+    if (errorMessage != nullptr) {
+      *errorMessage = QString("Failed to write media index: %1").arg(file.errorString());
+    }
+    return false;
+  }
+  return true;
+}
+
+void MediaLibrary::loadIndex() {
+  QFile file(indexPath_);
+  if (indexPath_.isEmpty() || !file.open(QIODevice::ReadOnly)) {
+    return;
+  }
+
+  const QJsonDocument document = QJsonDocument::fromJson(file.readAll());
+  const QJsonObject root = document.object();
+  if (root.value("version").toInt() != kIndexVersion) {
+    return;
+  }
+
+  const QJsonArray entries = root.value("entries").toArray();
+  index_.reserve(entries.size());
+  for (const QJsonValue& value : entries) {
+    const MediaInfo info = infoFromJson(value.toObject());
+    if (!info.path.isEmpty()) {
+      index_.insert(info.path, info);
+    }
+  }
+}
+
+void MediaLibrary::handleResult(const MediaInfo& info, bool reused) {
+  pending_.remove(info.path);
+  index_.insert(info.path, info);
+
+  if (info.missing) {
+    ++batchMissing_;
+  } else if (reused) {
+    ++batchReused_;
+  } else {
+    ++batchProbed_;
+    scheduleSave();
+  }
+  emit mediaUpdated(info.path, info);
+
+  if (pending_.isEmpty()) {
+    emit scanFinished(batchProbed_, batchReused_, batchMissing_);
+    batchProbed_ = 0;
+    batchReused_ = 0;
+    batchMissing_ = 0;
+  }
+}
+
+void MediaLibrary::scheduleSave() {
+  if (!saveTimer_->isActive()) {
+    saveTimer_->start();
+  }
+}
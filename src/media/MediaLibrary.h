@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include "core/MediaInfo.h"
+
+class QThreadPool;
+class QTimer;
+
+// Background media probe with a persistent index. Files are stat'ed and, when
+// their size or mtime changed since the last probe, opened by a headless
+// libmpv on a worker pool. The GUI thread only ever reads the in-memory index,
+// which is written back to disk shortly after results arrive.
+class MediaLibrary : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit MediaLibrary(const QString& indexPath, QObject* parent = nullptr);
+  ~MediaLibrary() override;
+
+  // Queues local files for a stat and, if needed, a probe. URLs and paths
+  // already in flight are skipped.
+  void scan(const QStringList& paths);
+  MediaInfo info(const QString& path) const;
+  bool isKnown(const QString& path) const;
+  bool isMissing(const QString& path) const;
+  int pendingCount() const;
+  bool saveIndex(QString* errorMessage = nullptr) const;
+
+ signals:
+  void mediaUpdated(const QString& path, const MediaInfo& info);
+  // Reported once the queue drains: files probed by mpv, files whose index
+  // entry was still valid, and files not found on disk.
+  void scanFinished(int probed, int reused, int missing);
+
+ private:
+  void loadIndex();
+  void handleResult(const MediaInfo& info, bool reused);
+  void scheduleSave();
+
+  QString indexPath_;
+  QThreadPool* pool_;
+  QTimer* saveTimer_;
+  QHash<QString, MediaInfo> index_;
+  QSet<QString> pending_;
+  int batchProbed_ = 0;
+  int batchReused_ = 0;
+  int batchMissing_ = 0;
+};
@@ -0,0 +1,335 @@
+#include "media/MediaPrefetcher.h"
+
+#include <QFile>
+#include <QPair>
+#include <QThread>
+#include <QtEndian>
+#include <QtGlobal>
+
+#include <climits>
+#include <iterator>
+
+#if defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr qint64 kDefaultBudgetBytes = 512LL * 1024 * 1024;
+constexpr qint64 kDefaultHeadBytes = 32LL * 1024 * 1024;
+// Containers without a front-loaded index (MKV cues, MXF footers, moov at the
+// end of an unoptimized MP4) keep it near the tail.
+constexpr qint64 kTailBytes = 4LL * 1024 * 1024;
+constexpr qint64 kMaxIndexBytes = 64LL * 1024 * 1024;
+constexpr int kMaxTopLevelAtoms = 64;
+// The kernel evicts cold pages eventually; after this long a file is warmed
+// again rather than trusted.
+constexpr qint64 kRewarmAfterMs = 5 * 60 * 1000;
+constexpr qint64 kReadChunkBytes = 1024 * 1024;
+
+bool isLikelyUrl(const QString& path) { return path.contains("://"); }
+
+bool isIsoBmffAtom(const QByteArray& type) {
+  static const QList<QByteArray> kTopLevel = {"ftyp", "moov", "mdat", "free", "wide", "skip", "pnot"};
+  return kTopLevel.contains(type);
+}
+
+qint64 adviseRange(QFile& file, qint64 offset, qint64 length) {
+  if (length <= 0) {
+    return 0;
+  }
+
+#if defined(Q_OS_LINUX)
+  const int fd = file.handle();
+  posix_fadvise(fd, offset, length, POSIX_FADV_WILLNEED);
+  // readahead() fills the cache before returning on most filesystems, which
+  // keeps one file's I/O from interleaving with the next on a spinning disk.
+  if (readahead(fd, offset, static_cast<size_t>(length)) == 0) {
+    return length;
+  }
+#elif defined(Q_OS_MACOS)
+  radvisory advice;
+  advice.ra_offset = offset;
+  advice.ra_count = static_cast<int>(qMin<qint64>(length, INT_MAX));
+  if (fcntl(file.handle(), F_RDADVISE, &advice) != -1) {
+    return length;
+  }
+#endif
+
+  // No advisory call available (or it was refused): reading the range is
+  // what pulls it into the cache.
+  if (!file.seek(offset)) {
+    return 0;
+  }
+  qint64 readTotal = 0;
+  QByteArray chunk(static_cast<int>(kReadChunkBytes), Qt::Uninitialized);
+  while (readTotal < length) {
+    const qint64 wanted = qMin(kReadChunkBytes, length - readTotal);
+    const qint64 got = file.read(chunk.data(), wanted);
+    if (got <= 0) {
+      break;
+    }
+    readTotal += got;
+  }
+  return readTotal;
+}
+
+// Runs on the I/O thread.
+bool probeFile(const QString& path, PrefetchLayout* layout) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered)) {
+    return false;
+  }
+  *layout = MediaPrefetcher::readLayout(file);
+  return true;
+}
+
+// Runs on the I/O thread.
+qint64 warmFile(const QString& path, const QVector<QPair<qint64, qint64>>& ranges, bool* ok) {
+  *ok = false;
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered)) {
+    return 0;
+  }
+
+  qint64 warmed = 0;
+  for (const auto& [offset, length] : ranges) {
+    warmed += adviseRange(file, offset, length);
+  }
+  *ok = true;
+  return warmed;
+}
+
+qint64 totalBytes(const QVector<QPair<qint64, qint64>>& ranges) {
+  qint64 total = 0;
+  for (const auto& range : ranges) {
+    total += range.second;
+  }
+  return total;
+}
+
+}  // namespace
+
+MediaPrefetcher::MediaPrefetcher(QObject* parent)
+    : QObject(parent),
+      ioThread_(new QThread(this)),
+      ioContext_(new QObject()),
+      headBytes_(kDefaultHeadBytes) {
+  stats_.budgetBytes = kDefaultBudgetBytes;
+  clock_.start();
+
+  ioThread_->setObjectName("MediaPrefetchIO");
+  ioContext_->moveToThread(ioThread_);
+  connect(ioThread_, &QThread::finished, ioContext_, &QObject::deleteLater);
+  ioThread_->start(QThread::LowPriority);
+}
+
+MediaPrefetcher::~MediaPrefetcher() {
+  ioThread_->quit();
+  ioThread_->wait();
+}
+
+void MediaPrefetcher::setBudgetBytes(qint64 bytes) {
+  stats_.budgetBytes = qMax<qint64>(0, bytes);
+  publishStats();
+  dispatchNext();
+}
+
+void MediaPrefetcher::setHeadBytes(qint64 bytes) { headBytes_ = qMax<qint64>(0, bytes); }
+
+void MediaPrefetcher::prefetch(const QStringList& paths) {
+  QStringList wanted;
+  for (const QString& path : paths) {
+    if (!path.trimmed().isEmpty() && !isLikelyUrl(path) && !wanted.contains(path)) {
+      wanted.push_back(path);
+    }
+  }
+  if (wanted == wanted_) {
+    return;
+  }
+
+  wanted_ = wanted;
+  for (auto it = layouts_.begin(); it != layouts_.end();) {
+    it = wanted_.contains(it.key()) ? std::next(it) : layouts_.erase(it);
+  }
+  publishStats();
+  dispatchNext();
+}
+
+void MediaPrefetcher::recordGo(const QString& path) {
+  if (path.trimmed().isEmpty() || isLikelyUrl(path)) {
+    return;
+  }
+
+  if (isWarm(path)) {
+    ++stats_.hits;
+  } else {
+    ++stats_.misses;
+  }
+  publishStats();
+}
+
+PrefetchStats MediaPrefetcher::stats() const { return stats_; }
+
+PrefetchLayout MediaPrefetcher::readLayout(QFile& file) {
+  PrefetchLayout layout;
+  layout.sizeBytes = file.size();
+  qint64 offset = 0;
+  for (int i = 0; i < kMaxTopLevelAtoms && offset + 8 <= layout.sizeBytes; ++i) {
+    if (!file.seek(offset)) {
+      break;
+    }
+    const QByteArray header = file.read(16);
+    if (header.size() < 8) {
+      break;
+    }
+
+    const QByteArray type = header.mid(4, 4);
+    if (!isIsoBmffAtom(type) && i == 0) {
+      break;
+    }
+
+    quint64 atomSize = qFromBigEndian<quint32>(header.constData());
+    if (atomSize == 1 && header.size() >= 16) {
+      atomSize = qFromBigEndian<quint64>(header.constData() + 8);
+    } else if (atomSize == 0) {
+      atomSize = static_cast<quint64>(layout.sizeBytes - offset);
+    }
+    if (atomSize < 8) {
+      break;
+    }
+
+    if (type == "moov") {
+      layout.moovOffset = offset;
+      layout.moovBytes = static_cast<qint64>(atomSize);
+      break;
+    }
+    offset += static_cast<qint64>(atomSize);
+  }
+  return layout;
+}
+
+QVector<QPair<qint64, qint64>> MediaPrefetcher::warmRanges(const PrefetchLayout& layout, qint64 headBytes) {
+  QVector<QPair<qint64, qint64>> ranges;
+  const qint64 head = qMin(headBytes, layout.sizeBytes);
+  if (head > 0) {
+    ranges.push_back({0, head});
+  }
+
+  if (layout.moovOffset >= 0) {
+    const qint64 moovEnd = qMin(layout.moovOffset + qMin(layout.moovBytes, kMaxIndexBytes), layout.sizeBytes);
+    const qint64 start = qMax(layout.moovOffset, head);
+    if (moovEnd > start) {
+      ranges.push_back({start, moovEnd - start});
+    }
+  } else if (layout.sizeBytes > head) {
+    const qint64 start = qMax(head, layout.sizeBytes - kTailBytes);
+    ranges.push_back({start, layout.sizeBytes - start});
+  }
+  return ranges;
+}
+
+bool MediaPrefetcher::isWarm(const QString& path) const {
+  const auto it = warm_.constFind(path);
+  return it != warm_.constEnd() && clock_.elapsed() - it.value().warmedAtMs < kRewarmAfterMs;
+}
+
+void MediaPrefetcher::dispatchNext() {
+  if (!inFlight_.isEmpty()) {
+    return;
+  }
+
+  // Walk in priority order; once the next cold file would overrun the budget,
+  // everything less likely than it waits.
+  qint64 spent = 0;
+  for (const QString& path : wanted_) {
+    if (isWarm(path)) {
+      spent += warm_.value(path).bytes;
+      continue;
+    }
+
+    inFlight_ = path;
+    const auto layout = layouts_.constFind(path);
+    if (layout == layouts_.constEnd()) {
+      // The index may lie past the head window; its cost is known only once
+      // the atoms have been read.
+      QMetaObject::invokeMethod(
+          ioContext_,
+          [this, path]() {
+            PrefetchLayout probed;
+            const bool ok = probeFile(path, &probed);
+            QMetaObject::invokeMethod(this, [this, path, probed, ok]() { handleProbed(path, probed, ok); },
+                                      Qt::QueuedConnection);
+          },
+          Qt::QueuedConnection);
+      return;
+    }
+
+    const QVector<QPair<qint64, qint64>> ranges = warmRanges(layout.value(), headBytes_);
+    if (spent + totalBytes(ranges) > stats_.budgetBytes) {
+      inFlight_.clear();
+      return;
+    }
+
+    QMetaObject::invokeMethod(
+        ioContext_,
+        [this, path, ranges]() {
+          bool ok = false;
+          const qint64 bytes = warmFile(path, ranges, &ok);
+          QMetaObject::invokeMethod(this, [this, path, bytes, ok]() { handleWarmed(path, bytes, ok); },
+                                    Qt::QueuedConnection);
+        },
+        Qt::QueuedConnection);
+    return;
+  }
+}
+
+void MediaPrefetcher::handleProbed(const QString& path, const PrefetchLayout& layout, bool ok) {
+  inFlight_.clear();
+  if (ok) {
+    layouts_.insert(path, layout);
+  } else {
+    // Unreadable files are dropped from this round instead of retried forever.
+    wanted_.removeAll(path);
+  }
+  dispatchNext();
+}
+
+void MediaPrefetcher::handleWarmed(const QString& path, qint64 bytes, bool ok) {
+  inFlight_.clear();
+
+  const qint64 now = clock_.elapsed();
+  for (auto it = warm_.begin(); it != warm_.end();) {
+    if (now - it.value().warmedAtMs >= kRewarmAfterMs) {
+      // The file may have been replaced since; read its atoms again too.
+      layouts_.remove(it.key());
+      it = warm_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  if (ok) {
+    warm_.insert(path, {bytes, now});
+    stats_.totalReadAheadBytes += bytes;
+  } else {
+    // Unreadable files are dropped from this round instead of retried forever.
+    wanted_.removeAll(path);
+  }
+
+  publishStats();
+  dispatchNext();
+}
+
+void MediaPrefetcher::publishStats() {
+  stats_.warmFiles = 0;
+  stats_.warmBytes = 0;
+  for (const QString& path : wanted_) {
+    if (isWarm(path)) {
+      ++stats_.warmFiles;
+      stats_.warmBytes += warm_.value(path).bytes;
+    }
+  }
+  emit statsChanged(stats_);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class QFile;
+class QThread;
+
+struct PrefetchStats {
+  int hits = 0;
+  int misses = 0;
+  int warmFiles = 0;
+  qint64 warmBytes = 0;
+  qint64 budgetBytes = 0;
+  qint64 totalReadAheadBytes = 0;
+};
+
+// Where a file keeps its index: the moov atom of an MP4/MOV, or -1 for
+// containers the prefetcher does not parse.
+struct PrefetchLayout {
+  qint64 sizeBytes = 0;
+  qint64 moovOffset = -1;
+  qint64 moovBytes = 0;
+};
+
+// Pulls the head and the index atoms of the likely next cues into the OS page
+// cache on a dedicated I/O thread, so a GO does not wait on a cold disk or
+// NAS. Files are warmed one at a time, most likely first, until the memory
+// budget is spent. Each file's atoms are read first, so an index past the
+// head window is charged to the budget too. A GO on a warmed file counts as
+// a hit.
+class MediaPrefetcher : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit MediaPrefetcher(QObject* parent = nullptr);
+  ~MediaPrefetcher() override;
+
+  void setBudgetBytes(qint64 bytes);
+  void setHeadBytes(qint64 bytes);
+  // Replaces the wanted list; paths are ordered most likely first.
+  void prefetch(const QStringList& paths);
+  void recordGo(const QString& path);
+  PrefetchStats stats() const;
+
+  // Walks the top-level atoms of an ISO BMFF file for its moov.
+  static PrefetchLayout readLayout(QFile& file);
+  // What warming a file reads, as (offset, length): the head window, then
+  // whatever of the index lies beyond it.
+  static QVector<QPair<qint64, qint64>> warmRanges(const PrefetchLayout& layout, qint64 headBytes);
+
+ signals:
+  void statsChanged(const PrefetchStats& stats);
+
+ private:
+  struct WarmEntry {
+    qint64 bytes = 0;
+    qint64 warmedAtMs = 0;
+  };
+
+  bool isWarm(const QString& path) const;
+  void dispatchNext();
+  void handleProbed(const QString& path, const PrefetchLayout& layout, bool ok);
+  void handleWarmed(const QString& path, qint64 bytes, bool ok);
+  void publishStats();
+
+  QThread* ioThread_;
+  QObject* ioContext_;
+  QElapsedTimer clock_;
+  qint64 headBytes_;
+  QStringList wanted_;
+  QHash<QString, WarmEntry> warm_;
+  QHash<QString, PrefetchLayout> layouts_;
+  QString inFlight_;
+  PrefetchStats stats_;
+};
@@ -0,0 +1,128 @@
+#include "output/CompositorSurface.h"
+
+#include <QPaintEvent>
+#include <QPainter>
+#include <QResizeEvent>
+
+#include "player/MpvPlayer.h"
+
+CompositorSurface::CompositorSurface(QWidget* parent) : QWidget(parent) {
+  setAttribute(Qt::WA_OpaquePaintEvent);
+  setAttribute(Qt::WA_TransparentForMouseEvents);
+}
+
+void CompositorSurface::setLayerPlayer(int layer, MpvPlayer* player) {
+  CompositedLayer& entry = layers_[layer];
+  if (entry.player == player) {
+    return;
+  }
+
+  if (entry.player != nullptr) {
+    disconnect(entry.player, nullptr, this, nullptr);
+  }
+  entry.player = player;
+  if (player == nullptr) {
+    update();
+    return;
+  }
+
+  connect(player, &MpvPlayer::frameAvailable, this, [this, player]() { renderLayer(player, false); });
+
+  // A player taken from standby already holds its first frame and mpv will not
+  // announce it again, so pull it explicitly.
+  renderLayer(player, true);
+}
+
+void CompositorSurface::removePlayer(MpvPlayer* player) {
+  if (player == nullptr) {
+    return;
+  }
+
+  disconnect(player, nullptr, this, nullptr);
+  for (auto it = layers_.begin(); it != layers_.end(); ++it) {
+    if (it.value().player == player) {
+      it.value().player = nullptr;
+    }
+  }
+  update();
+}
+
+void CompositorSurface::setLayerOpacity(int layer, double opacity) {
+  layers_[layer].opacity = qBound(0.0, opacity, 1.0);
+  update();
+}
+
+double CompositorSurface::layerOpacity(int layer) const {
+  const auto it = layers_.constFind(layer);
+  return it != layers_.constEnd() ? it.value().opacity : 1.0;
+}
+
+void CompositorSurface::beginCrossfade(int layer) {
+  CompositedLayer& entry = layers_[layer];
+  // Shares the buffer; the outgoing player detaches it if it renders again.
+  entry.outgoing = entry.player != nullptr ? entry.player->softwareFrame() : QImage();
+  entry.opacity = 0.0;
+  update();
+}
+
+void CompositorSurface::endCrossfade(int layer) {
+  const auto it = layers_.find(layer);
+  if (it == layers_.end()) {
+    return;
+  }
+  it.value().outgoing = QImage();
+  it.value().opacity = 1.0;
+  update();
+}
+
+void CompositorSurface::setWarpTransform(const QTransform& transform) {
+  if (transform == warp_) {
+    return;
+  }
+  warp_ = transform;
+  update();
+}
+
+void CompositorSurface::paintEvent(QPaintEvent* event) {
+  QPainter painter(this);
+  painter.fillRect(event->rect(), Qt::black);
+
+  // Keystone/corner pin is applied here, per paint, so calibration changes
+  // never touch the mpv filter chain.
+  if (!warp_.isIdentity()) {
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    painter.setTransform(warp_);
+  }
+
+  for (auto it = layers_.constBegin(); it != layers_.constEnd(); ++it) {
+    const CompositedLayer& entry = it.value();
+    if (!entry.outgoing.isNull()) {
+      painter.setOpacity(1.0);
+      painter.drawImage(rect(), entry.outgoing);
+    }
+
+    const MpvPlayer* player = entry.player;
+    if (player == nullptr || entry.opacity <= 0.0 || player->softwareFrame().isNull()) {
+      continue;
+    }
+    painter.setOpacity(entry.opacity);
+    painter.drawImage(rect(), player->softwareFrame());
+  }
+}
+
+void CompositorSurface::resizeEvent(QResizeEvent* event) {
+  QWidget::resizeEvent(event);
+  for (auto it = layers_.constBegin(); it != layers_.constEnd(); ++it) {
+    renderLayer(it.value().player, true);
+  }
+}
+
+void CompositorSurface::renderLayer(MpvPlayer* player, bool force) {
+  if (player == nullptr) {
+    return;
+  }
+
+  if (player->renderSoftwareFrame(size(), force)) {
+    update();
+  }
+}
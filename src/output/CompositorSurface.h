@@ -0,0 +1,47 @@
+#pragma once
+
+#include <QImage>
+#include <QMap>
+#include <QPointer>
+#include <QTransform>
+#include <QWidget>
+
+class MpvPlayer;
+
+// Single render surface for an output window. Every on-air layer renders
+// through its mpv software render context into a premultiplied ARGB frame,
+// and one paint pass blends them bottom-to-top by layer index with per-layer
+// opacity, so transparent media and fading layers show the ones below.
+class CompositorSurface : public QWidget {
+  Q_OBJECT
+
+ public:
+  explicit CompositorSurface(QWidget* parent = nullptr);
+
+  void setLayerPlayer(int layer, MpvPlayer* player);
+  void removePlayer(MpvPlayer* player);
+  void setLayerOpacity(int layer, double opacity);
+  double layerOpacity(int layer) const;
+  // Keeps the layer's current picture underneath and makes the layer
+  // transparent, so its next player fades in over it as the opacity rises;
+  // endCrossfade drops the held picture and restores full opacity.
+  void beginCrossfade(int layer);
+  void endCrossfade(int layer);
+  void setWarpTransform(const QTransform& transform);
+
+ protected:
+  void paintEvent(QPaintEvent* event) override;
+  void resizeEvent(QResizeEvent* event) override;
+
+ private:
+  struct CompositedLayer {
+    QPointer<MpvPlayer> player;
+    double opacity = 1.0;
+    QImage outgoing;
+  };
+
+  void renderLayer(MpvPlayer* player, bool force);
+
+  QMap<int, CompositedLayer> layers_;
+  QTransform warp_;
+};
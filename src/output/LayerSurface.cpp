@@ -4,140 +4,274 @@
 #include <QPaintEvent>
 #include <QPainter>
 #include <QResizeEvent>
+#include <QTimer>
 
+#include <utility>
+
+#include "core/Trace.h"
+#include "output/CompositorSurface.h"
+#include "output/WarpGeometry.h"
 #include "player/IPlayer.h"
 #include "player/MpvPlayer.h"
 
 namespace {
 
-QString perspectiveFilterFromCalibration(const QSize& size, const OutputCalibration& calibration) {
-  if (size.width() <= 0 || size.height() <= 0) {
-    return {};
-  }
+// Calibration nudges and resizes arrive far faster than a display refreshes;
+// the warp is recomputed at most once per frame.
+constexpr int kWarpCoalesceMs = 16;
 
-  if (calibration.keystoneHorizontal == 0 && calibration.keystoneVertical == 0) {
-    return {};
+QString sourcePathForCue(const Cue& cue) {
+  if (cue.isLiveInput && !cue.liveInputUrl.trimmed().isEmpty()) {
+    return cue.liveInputUrl.trimmed();
   }
-
-  const double width = static_cast<double>(size.width());
-  const double height = static_cast<double>(size.height());
-
-  const double hNorm = static_cast<double>(calibration.keystoneHorizontal) / 100.0;
-  const double vNorm = static_cast<double>(calibration.keystoneVertical) / 100.0;
-
-  const double topInset = hNorm > 0.0 ? width * hNorm * 0.45 : 0.0;
-  const double bottomInset = hNorm < 0.0 ? width * -hNorm * 0.45 : 0.0;
-  const double leftInset = vNorm > 0.0 ? height * vNorm * 0.45 : 0.0;
-  const double rightInset = vNorm < 0.0 ? height * -vNorm * 0.45 : 0.0;
-
-  const double x0 = topInset;
-  const double y0 = leftInset;
-  const double x1 = width - topInset;
-  const double y1 = rightInset;
-  const double x2 = bottomInset;
-  const double y2 = height - leftInset;
-  const double x3 = width - bottomInset;
-  const double y3 = height - rightInset;
-
-  return QString(
-             "lavfi=[perspective=x0=%1:y0=%2:x1=%3:y1=%4:x2=%5:y2=%6:x3=%7:y3=%8]")
-      .arg(x0, 0, 'f', 2)
-      .arg(y0, 0, 'f', 2)
-      .arg(x1, 0, 'f', 2)
-      .arg(y1, 0, 'f', 2)
-      .arg(x2, 0, 'f', 2)
-      .arg(y2, 0, 'f', 2)
-      .arg(x3, 0, 'f', 2)
-      .arg(y3, 0, 'f', 2);
+  return cue.filePath;
 }
 
 }  // namespace
 
-LayerSurface::LayerSurface(QWidget* parent) : QWidget(parent) {
+LayerSurface::LayerSurface(QWidget* parent)
+    : QWidget(parent), pool_(new PlayerPool(this, backend_, this)), warpTimer_(new QTimer(this)) {
   setAttribute(Qt::WA_NoSystemBackground, false);
   setStyleSheet("background: black;");
+
+  warpTimer_->setSingleShot(true);
+  connect(warpTimer_, &QTimer::timeout, this, &LayerSurface::applyWarp);
 }
 
 bool LayerSurface::playCue(const Cue& cue) {
+  const TraceScope trace("output", "playCue", [&cue]() { return cue.id; });
+  const QString sourcePath = sourcePathForCue(cue);
+
+  auto slotIt = layers_.find(cue.layer);
+  if (slotIt != layers_.end() && takeStandby(slotIt.value(), cue, sourcePath)) {
+    return true;
+  }
+
   IPlayer* player = ensurePlayerForLayer(cue.layer);
   if (player == nullptr) {
     return false;
   }
 
-  cueFilters_.insert(cue.layer, cue.videoFilter.trimmed());
-  applyFilterToPlayer(player, cue.layer);
-
-  QString sourcePath = cue.filePath;
-  if (cue.isLiveInput && !cue.liveInputUrl.trimmed().isEmpty()) {
-    sourcePath = cue.liveInputUrl.trimmed();
-  }
+  LayerSlot& slot = layers_[cue.layer];
+  slot.liveCueId.clear();
+  slot.liveFilter = cue.videoFilter.trimmed();
+  slot.livePresetId = cue.filterPresetId.trimmed();
+  applyFilterToPlayer(player, slot.livePresetId, slot.liveFilter);
 
   if (!player->load(sourcePath, cue.loop, false)) {
     emit playbackError(QString("Failed to load cue '%1'.").arg(cue.name));
     return false;
   }
 
+  slot.liveCueId = cue.id;
+
   player->play();
   return true;
 }
 
 bool LayerSurface::preloadCue(const Cue& cue) {
-  IPlayer* player = ensurePlayerForLayer(cue.layer);
+  IPlayer* player = ensureStandbyForLayer(cue.layer);
   if (player == nullptr) {
     return false;
   }
 
-  cueFilters_.insert(cue.layer, cue.videoFilter.trimmed());
-  applyFilterToPlayer(player, cue.layer);
-
-  QString sourcePath = cue.filePath;
-  if (cue.isLiveInput && !cue.liveInputUrl.trimmed().isEmpty()) {
-    sourcePath = cue.liveInputUrl.trimmed();
-  }
+  LayerSlot& slot = layers_[cue.layer];
+  slot.standbyCueId.clear();
+  slot.standbySource.clear();
+  slot.standbyReady = false;
+  slot.standbyFilter = cue.videoFilter.trimmed();
+  slot.standbyPresetId = cue.filterPresetId.trimmed();
+  applyFilterToPlayer(player, slot.standbyPresetId, slot.standbyFilter);
 
+  const QString sourcePath = sourcePathForCue(cue);
   if (!player->load(sourcePath, cue.loop, true)) {
     emit playbackError(QString("Failed to preload cue '%1'.").arg(cue.name));
     return false;
   }
 
+  slot.standbyCueId = cue.id;
+  slot.standbySource = sourcePath;
+  slot.standbyLoop = cue.loop;
+  return true;
+}
+
+bool LayerSurface::armCue(const Cue& cue) {
+  // A standby already holding this cue is left alone so a grouped GO after a
+  // manual preload does not throw the decoded first frame away.
+  const auto it = layers_.constFind(cue.layer);
+  if (it != layers_.constEnd() && standbyHolds(it.value(), cue, sourcePathForCue(cue))) {
+    return true;
+  }
+  return preloadCue(cue);
+}
+
+bool LayerSurface::isCueArmed(const Cue& cue) const {
+  const auto it = layers_.constFind(cue.layer);
+  return it != layers_.constEnd() && it.value().standbyReady && standbyHolds(it.value(), cue, sourcePathForCue(cue));
+}
+
+QString LayerSurface::standbyCueId(int layer) const {
+  const auto it = layers_.constFind(layer);
+  return it != layers_.constEnd() ? it.value().standbyCueId : QString();
+}
+
+bool LayerSurface::releaseStandby(int layer, const QString& cueId) {
+  auto it = layers_.find(layer);
+  if (it == layers_.end() || cueId.isEmpty() || it.value().standbyCueId != cueId) {
+    return false;
+  }
+
+  LayerSlot& slot = it.value();
+  releasePlayer(slot.standby);
+  slot.standby = nullptr;
+  slot.standbyFilter.clear();
+  slot.standbyPresetId.clear();
+  slot.standbyCueId.clear();
+  slot.standbySource.clear();
+  slot.standbyLoop = false;
+  slot.standbyReady = false;
+
+  if (slot.live == nullptr) {
+    layers_.erase(it);
+  }
   return true;
 }
 
 void LayerSurface::stopLayer(int layer) {
-  if (!layers_.contains(layer)) {
+  auto it = layers_.find(layer);
+  if (it == layers_.end()) {
     return;
   }
-  cueFilters_.remove(layer);
-  layers_.value(layer)->stop();
+
+  // Stopped layers hand their players back to the pool; a pending preload in
+  // the standby survives the stop so the next take is still instant.
+  LayerSlot& slot = it.value();
+  releasePlayer(slot.live);
+  slot.live = nullptr;
+  slot.liveCueId.clear();
+  slot.liveFilter.clear();
+  slot.livePresetId.clear();
+  if (slot.standbyCueId.isEmpty()) {
+    releasePlayer(slot.standby);
+    slot.standby = nullptr;
+    slot.standbyFilter.clear();
+    slot.standbyPresetId.clear();
+  }
+
+  if (slot.live == nullptr && slot.standby == nullptr) {
+    layers_.erase(it);
+  }
 }
 
 void LayerSurface::stopAll() {
-  cueFilters_.clear();
   for (auto it = layers_.begin(); it != layers_.end(); ++it) {
-    it.value()->stop();
+    releasePlayer(it.value().live);
+    releasePlayer(it.value().standby);
   }
+  layers_.clear();
 }
 
 void LayerSurface::setCalibration(const OutputCalibration& calibration) {
   calibration_ = calibration;
+  scheduleWarpUpdate();
+}
+
+OutputCalibration LayerSurface::calibration() const { return calibration_; }
+
+int LayerSurface::prewarmPlayers(int count) { return pool_->prewarm(count); }
+
+PlayerPoolStats LayerSurface::playerPoolStats() const { return pool_->stats(); }
+
+void LayerSurface::setRenderBackend(RenderBackend backend) {
+  if (backend == backend_) {
+    return;
+  }
+
+  // Players are bound to one output path at creation, so switching drops
+  // everything on this surface and starts over with a fresh pool.
+  stopAll();
+  delete pool_;
+  backend_ = backend;
+  pool_ = new PlayerPool(this, backend_, this);
+
+  if (backend_ == RenderBackend::SoftwareCompositor) {
+    compositor_ = new CompositorSurface(this);
+    compositor_->setGeometry(rect());
+    compositor_->show();
+  } else {
+    delete compositor_;
+    compositor_ = nullptr;
+  }
 
+  warp_.reset();
+  scheduleWarpUpdate();
+}
+
+RenderBackend LayerSurface::renderBackend() const { return backend_; }
+
+void LayerSurface::setFilterPresets(const QMap<QString, QString>& presets) {
+  if (presets == filterPresets_) {
+    return;
+  }
+
+  // Only players whose preset text actually changed see vf commands; the
+  // calibration and cue segments are left in place by the filter graph.
+  filterPresets_ = presets;
   for (auto it = layers_.begin(); it != layers_.end(); ++it) {
-    applyFilterToPlayer(it.value(), it.key());
+    applyFiltersToSlot(it.value());
   }
 }
 
-OutputCalibration LayerSurface::calibration() const { return calibration_; }
+bool LayerSurface::beginCrossfade(int layer) {
+  if (compositor_ == nullptr) {
+    return false;
+  }
+  compositor_->beginCrossfade(layer);
+  return true;
+}
+
+void LayerSurface::setLayerOpacity(int layer, double opacity) {
+  if (compositor_ != nullptr) {
+    compositor_->setLayerOpacity(layer, opacity);
+  }
+}
+
+void LayerSurface::endCrossfade(int layer) {
+  if (compositor_ != nullptr) {
+    compositor_->endCrossfade(layer);
+  }
+}
+
+void LayerSurface::setHoldTakes(bool hold) { holdTakes_ = hold; }
+
+void LayerSurface::startHeldTakes() {
+  // A layer stopped or retaken since has handed that player on; only players
+  // still live where they were taken are started.
+  const QVector<QPair<int, IPlayer*>> held = std::exchange(heldTakes_, {});
+  for (const auto& [layer, player] : held) {
+    const auto it = layers_.constFind(layer);
+    if (it != layers_.constEnd() && it.value().live == player) {
+      player->play();
+    }
+  }
+}
 
 void LayerSurface::resizeEvent(QResizeEvent* event) {
   QWidget::resizeEvent(event);
 
   for (auto it = layers_.begin(); it != layers_.end(); ++it) {
-    QWidget* view = it.value()->view();
-    if (view != nullptr) {
-      view->setGeometry(rect());
+    for (IPlayer* player : {it.value().live, it.value().standby}) {
+      if (player != nullptr && player->view() != nullptr) {
+        player->view()->setGeometry(rect());
+      }
     }
-    applyFilterToPlayer(it.value(), it.key());
   }
+  pool_->setViewGeometry(rect());
+
+  if (compositor_ != nullptr) {
+    compositor_->setGeometry(rect());
+  }
+  scheduleWarpUpdate();
 }
 
 void LayerSurface::paintEvent(QPaintEvent* event) {
@@ -146,56 +280,196 @@ void LayerSurface::paintEvent(QPaintEvent* event) {
 }
 
 IPlayer* LayerSurface::ensurePlayerForLayer(int layer) {
-  if (layers_.contains(layer)) {
-    IPlayer* existing = layers_.value(layer);
-    QWidget* view = existing->view();
-    if (view != nullptr) {
-      view->raise();
+  LayerSlot& slot = layers_[layer];
+  if (slot.live == nullptr) {
+    slot.live = acquirePlayer(layer);
+    if (slot.live == nullptr) {
+      return nullptr;
     }
-    return existing;
   }
 
-  auto* player = new MpvPlayer(this);
-  QWidget* view = player->view();
-  if (view == nullptr) {
-    player->deleteLater();
-    return nullptr;
+  putOnAir(layer, slot.live);
+  return slot.live;
+}
+
+IPlayer* LayerSurface::ensureStandbyForLayer(int layer) {
+  LayerSlot& slot = layers_[layer];
+  if (slot.standby == nullptr) {
+    slot.standby = acquirePlayer(layer);
   }
+  return slot.standby;
+}
 
-  view->setParent(this);
-  view->setGeometry(rect());
-  view->show();
-  view->raise();
+IPlayer* LayerSurface::acquirePlayer(int layer) {
+  IPlayer* player = pool_->acquire();
+  if (player == nullptr) {
+    emit playbackError(QString("Layer %1: no player available.").arg(layer));
+    return nullptr;
+  }
 
+  if (player->view() != nullptr) {
+    player->view()->setGeometry(rect());
+  }
   connect(player, &IPlayer::playbackError, this, [this, layer](const QString& message) {
     qWarning() << "Layer" << layer << "error:" << message;
     emit playbackError(QString("Layer %1: %2").arg(layer).arg(message));
   });
 
-  layers_.insert(layer, player);
-  applyFilterToPlayer(player, layer);
+  // Players swap between live and standby, so only report state for whichever
+  // one is currently on air for this layer.
+  connect(player, &IPlayer::positionChanged, this, [this, player, layer](double positionSec) {
+    const auto it = layers_.constFind(layer);
+    if (it != layers_.constEnd() && it.value().live == player && !it.value().liveCueId.isEmpty()) {
+      emit cuePositionChanged(it.value().liveCueId, layer, positionSec, player->duration());
+    }
+  });
+  connect(player, &IPlayer::firstFrameReady, this, [this, player, layer]() {
+    auto it = layers_.find(layer);
+    if (it == layers_.end()) {
+      return;
+    }
+    LayerSlot& slot = it.value();
+    if (slot.standby == player && !slot.standbyCueId.isEmpty()) {
+      slot.standbyReady = true;
+      Trace::instant("mpv", "standbyFirstFrame", slot.standbyCueId);
+      emit cueArmed(slot.standbyCueId, layer);
+    } else if (slot.live == player && !slot.liveCueId.isEmpty()) {
+      Trace::instant("mpv", "firstFrame", slot.liveCueId);
+      emit cueOnAir(slot.liveCueId, layer);
+    }
+  });
+  connect(player, &IPlayer::endOfFile, this, [this, player, layer]() {
+    const auto it = layers_.constFind(layer);
+    if (it != layers_.constEnd() && it.value().live == player && !it.value().liveCueId.isEmpty()) {
+      emit cueMediaEnded(it.value().liveCueId, layer);
+    }
+  });
+
+  applyFilterToPlayer(player, QString(), QString());
+  player->setWarp(warp_);
   return player;
 }
 
-QString LayerSurface::buildKeystoneFilter() const { return perspectiveFilterFromCalibration(size(), calibration_); }
+void LayerSurface::releasePlayer(IPlayer* player) {
+  if (player == nullptr) {
+    return;
+  }
+  disconnect(player, nullptr, this, nullptr);
+  takeOffAir(player);
+  pool_->release(player);
+}
 
-QString LayerSurface::buildMergedFilterForLayer(int layer) const {
-  const QString keystoneFilter = buildKeystoneFilter();
-  const QString cueFilter = cueFilters_.value(layer).trimmed();
+bool LayerSurface::standbyHolds(const LayerSlot& slot, const Cue& cue, const QString& sourcePath) {
+  return slot.standby != nullptr && !slot.standbyCueId.isEmpty() && slot.standbyCueId == cue.id &&
+         slot.standbySource == sourcePath && slot.standbyLoop == cue.loop;
+}
 
-  if (keystoneFilter.isEmpty()) {
-    return cueFilter;
+bool LayerSurface::takeStandby(LayerSlot& slot, const Cue& cue, const QString& sourcePath) {
+  if (!standbyHolds(slot, cue, sourcePath)) {
+    return false;
   }
-  if (cueFilter.isEmpty()) {
-    return keystoneFilter;
+
+  // The cue may have been edited since the preload; unchanged segments cost
+  // nothing here, so the take never rebuilds the graph it was armed with.
+  slot.standbyFilter = cue.videoFilter.trimmed();
+  slot.standbyPresetId = cue.filterPresetId.trimmed();
+  applyFilterToPlayer(slot.standby, slot.standbyPresetId, slot.standbyFilter);
+
+  const bool firstFrameReady = slot.standbyReady;
+  IPlayer* previousLive = slot.live;
+  slot.live = slot.standby;
+  slot.liveCueId = slot.standbyCueId;
+  slot.liveFilter = slot.standbyFilter;
+  slot.livePresetId = slot.standbyPresetId;
+  slot.standby = previousLive;
+  slot.standbyFilter.clear();
+  slot.standbyPresetId.clear();
+  slot.standbyCueId.clear();
+  slot.standbySource.clear();
+  slot.standbyLoop = false;
+  slot.standbyReady = false;
+
+  putOnAir(cue.layer, slot.live);
+  if (holdTakes_) {
+    heldTakes_.push_back({cue.layer, slot.live});
+  } else {
+    slot.live->play();
+  }
+  Trace::instant("output", "standbyTaken", slot.liveCueId);
+  // With the first frame decoded the swap is when the picture changes;
+  // otherwise firstFrameReady reports it once the frame lands.
+  if (firstFrameReady) {
+    emit cueOnAir(slot.liveCueId, cue.layer);
+  }
+
+  if (previousLive != nullptr) {
+    previousLive->stop();
+    takeOffAir(previousLive);
+  }
+  return true;
+}
+
+void LayerSurface::putOnAir(int layer, IPlayer* player) {
+  const TraceScope trace("output", "putOnAir");
+  if (compositor_ != nullptr) {
+    compositor_->setLayerPlayer(layer, qobject_cast<MpvPlayer*>(player));
+    return;
   }
 
-  return QString("%1,%2").arg(keystoneFilter, cueFilter);
+  QWidget* view = player->view();
+  if (view != nullptr) {
+    view->show();
+    view->raise();
+  }
 }
 
-void LayerSurface::applyFilterToPlayer(IPlayer* player, int layer) {
+void LayerSurface::takeOffAir(IPlayer* player) {
+  if (compositor_ != nullptr) {
+    compositor_->removePlayer(qobject_cast<MpvPlayer*>(player));
+    return;
+  }
+
+  if (player->view() != nullptr) {
+    player->view()->hide();
+  }
+}
+
+void LayerSurface::scheduleWarpUpdate() {
+  if (!warpTimer_->isActive()) {
+    warpTimer_->start(kWarpCoalesceMs);
+  }
+}
+
+void LayerSurface::applyWarp() {
+  if (compositor_ != nullptr) {
+    compositor_->setWarpTransform(warpTransform(QSizeF(size()), calibration_));
+    return;
+  }
+
+  // Native windows warp in mpv's output stage; the vf chain and the live
+  // video are never touched, so nudges apply live here too.
+  warp_ = unitWarpTransform(QSizeF(size()), calibration_);
+  for (auto it = layers_.begin(); it != layers_.end(); ++it) {
+    for (IPlayer* player : {it.value().live, it.value().standby}) {
+      if (player != nullptr) {
+        player->setWarp(warp_);
+      }
+    }
+  }
+}
+
+void LayerSurface::applyFilterToPlayer(IPlayer* player, const QString& presetId, const QString& cueFilter) {
   if (player == nullptr) {
     return;
   }
-  player->setVideoFilter(buildMergedFilterForLayer(layer));
+
+  const TraceScope trace("output", "applyFilters");
+  player->setFilterSegment(FilterSegment::Preset,
+                           presetId.isEmpty() ? QString() : filterPresets_.value(presetId).trimmed());
+  player->setFilterSegment(FilterSegment::Cue, cueFilter);
+}
+
+void LayerSurface::applyFiltersToSlot(LayerSlot& slot) {
+  applyFilterToPlayer(slot.live, slot.livePresetId, slot.liveFilter);
+  applyFilterToPlayer(slot.standby, slot.standbyPresetId, slot.standbyFilter);
 }
@@ -1,12 +1,19 @@
 #pragma once
 
 #include <QMap>
+#include <QPair>
+#include <QTransform>
+#include <QVector>
 #include <QWidget>
 
 #include "core/Cue.h"
+#include "core/RenderBackend.h"
 #include "output/OutputCalibration.h"
+#include "output/PlayerPool.h"
 
+class CompositorSurface;
 class IPlayer;
+class QTimer;
 
 class LayerSurface : public QWidget {
   Q_OBJECT
@@ -16,25 +23,83 @@ class LayerSurface : public QWidget {
 
   bool playCue(const Cue& cue);
   bool preloadCue(const Cue& cue);
+  bool armCue(const Cue& cue);
+  bool isCueArmed(const Cue& cue) const;
+  // The cue held paused in layer's standby, or empty.
+  QString standbyCueId(int layer) const;
+  // Hands layer's standby back to the pool if it still holds cueId.
+  bool releaseStandby(int layer, const QString& cueId);
   void stopLayer(int layer);
   void stopAll();
   void setCalibration(const OutputCalibration& calibration);
   OutputCalibration calibration() const;
+  int prewarmPlayers(int count);
+  PlayerPoolStats playerPoolStats() const;
+  void setRenderBackend(RenderBackend backend);
+  RenderBackend renderBackend() const;
+  void setFilterPresets(const QMap<QString, QString>& presets);
+  // Compositor backend only: fades layer's next cue in over its current
+  // picture. beginCrossfade returns false where layers cannot blend.
+  bool beginCrossfade(int layer);
+  void setLayerOpacity(int layer, double opacity);
+  void endCrossfade(int layer);
+  // While held, a take puts its standby on air still paused, and
+  // startHeldTakes() unpauses all of them in one pass.
+  void setHoldTakes(bool hold);
+  void startHeldTakes();
 
  signals:
   void playbackError(const QString& message);
+  void cuePositionChanged(const QString& cueId, int layer, double positionSec, double durationSec);
+  void cueMediaEnded(const QString& cueId, int layer);
+  void cueArmed(const QString& cueId, int layer);
+  // The live player on layer is showing cueId's first frame.
+  void cueOnAir(const QString& cueId, int layer);
 
-  protected:
+ protected:
   void resizeEvent(QResizeEvent* event) override;
   void paintEvent(QPaintEvent* event) override;
 
  private:
+  // Each layer keeps an on-air player and an off-air standby player. Preloads
+  // land in the standby so the live picture is never touched, and a take of
+  // the preloaded cue swaps the two views instead of reloading the media.
+  struct LayerSlot {
+    IPlayer* live = nullptr;
+    IPlayer* standby = nullptr;
+    QString liveCueId;
+    QString liveFilter;
+    QString livePresetId;
+    QString standbyFilter;
+    QString standbyPresetId;
+    QString standbyCueId;
+    QString standbySource;
+    bool standbyLoop = false;
+    bool standbyReady = false;
+  };
+
   IPlayer* ensurePlayerForLayer(int layer);
-  QString buildKeystoneFilter() const;
-  QString buildMergedFilterForLayer(int layer) const;
-  void applyFilterToPlayer(IPlayer* player, int layer);
+  IPlayer* ensureStandbyForLayer(int layer);
+  IPlayer* acquirePlayer(int layer);
+  void releasePlayer(IPlayer* player);
+  static bool standbyHolds(const LayerSlot& slot, const Cue& cue, const QString& sourcePath);
+  bool takeStandby(LayerSlot& slot, const Cue& cue, const QString& sourcePath);
+  void putOnAir(int layer, IPlayer* player);
+  void takeOffAir(IPlayer* player);
+  void scheduleWarpUpdate();
+  void applyWarp();
+  void applyFilterToPlayer(IPlayer* player, const QString& presetId, const QString& cueFilter);
+  void applyFiltersToSlot(LayerSlot& slot);
 
-  QMap<int, IPlayer*> layers_;
-  QMap<int, QString> cueFilters_;
+  RenderBackend backend_ = RenderBackend::NativeWindows;
+  PlayerPool* pool_;
+  CompositorSurface* compositor_ = nullptr;
+  QMap<int, LayerSlot> layers_;
   OutputCalibration calibration_;
+  QTimer* warpTimer_;
+  // Native windows only; identity with the compositor, which paints the warp.
+  QTransform warp_;
+  QMap<QString, QString> filterPresets_;
+  bool holdTakes_ = false;
+  QVector<QPair<int, IPlayer*>> heldTakes_;
 };
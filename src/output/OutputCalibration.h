@@ -9,4 +9,14 @@ struct OutputCalibration {
   int maskTopPx = 0;
   int maskRightPx = 0;
   int maskBottomPx = 0;
+  // Corner pin: per-corner pixel offsets of where the frame corner lands.
+  bool cornerPinEnabled = false;
+  int cornerTopLeftX = 0;
+  int cornerTopLeftY = 0;
+  int cornerTopRightX = 0;
+  int cornerTopRightY = 0;
+  int cornerBottomLeftX = 0;
+  int cornerBottomLeftY = 0;
+  int cornerBottomRightX = 0;
+  int cornerBottomRightY = 0;
 };
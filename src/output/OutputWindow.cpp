@@ -1,15 +1,14 @@
 #include "output/OutputWindow.h"
 
-#include <QEventLoop>
 #include <QFileInfo>
 #include <QGraphicsOpacityEffect>
 #include <QLabel>
-#include <QPropertyAnimation>
 #include <QScreen>
-#include <QTimer>
 #include <QVBoxLayout>
 #include <QWindow>
 
+#include "core/Trace.h"
+#include "core/TriggerStamp.h"
 #include "output/EdgeBlendOverlay.h"
 #include "output/LayerSurface.h"
 
@@ -55,9 +54,14 @@ OutputWindow::OutputWindow(QWidget* parent)
     showSlate(message);
     emit playbackError(message);
   });
+  connect(surface_, &LayerSurface::cuePositionChanged, this, &OutputWindow::cuePositionChanged);
+  connect(surface_, &LayerSurface::cueMediaEnded, this, &OutputWindow::cueMediaEnded);
+  connect(surface_, &LayerSurface::cueArmed, this, &OutputWindow::cueArmed);
+  connect(surface_, &LayerSurface::cueOnAir, this, &OutputWindow::cueOnAir);
 }
 
 void OutputWindow::showOnScreen(QScreen* screen) {
+  const TraceScope trace("output", "showOnScreen");
   if (screen != nullptr) {
     winId();
     if (windowHandle() != nullptr) {
@@ -80,48 +84,146 @@ bool OutputWindow::playCue(const Cue& cue) {
   return ok;
 }
 
-bool OutputWindow::playCueWithTransition(const Cue& cue, TransitionStyle style, int durationMs) {
+bool OutputWindow::beginTransition(const Cue& cue, TransitionStyle style, int durationMs, qint64 nowMs) {
+  const TraceScope trace("output", "beginTransition", [&cue]() { return cue.id; });
+  // A new take supersedes whatever is still running on this output.
+  completeTransition();
+
   if (style == TransitionStyle::Cut) {
     return playCue(cue);
   }
 
+  transition_ = TransitionState();
+  transition_.cue = cue;
+  transition_.traceStartNs = Trace::isEnabled() ? monotonicNowNs() : -1;
+  fadeOverlay_->setGeometry(rect());
+
+  // The compositor blends layers itself, so a fade is a true crossfade of the
+  // layer rather than a pass through the black overlay.
+  if (style == TransitionStyle::Fade && surface_->beginCrossfade(cue.layer)) {
+    transition_.crossfadeMs = qMax(60, durationMs);
+    transition_.ok = playCue(cue);
+    transition_.played = true;
+    enterPhase(TransitionPhase::Crossfade, nowMs);
+    return true;
+  }
+
   if (style == TransitionStyle::WipeLeft) {
     fadeOverlay_->setStyleSheet("background: black;");
     fadeEffect_->setOpacity(1.0);
     fadeOverlay_->show();
     fadeOverlay_->raise();
 
-    const bool ok = playCue(cue);
-    runWipeReveal(qMax(120, durationMs));
-    fadeOverlay_->hide();
-    return ok;
+    transition_.wipeMs = qMax(120, durationMs);
+    transition_.ok = playCue(cue);
+    transition_.played = true;
+    enterPhase(TransitionPhase::Wipe, nowMs);
+    return true;
   }
 
   const int fadeDuration = qMax(60, durationMs);
-  const QString dipColor = style == TransitionStyle::DipToWhite ? "white" : "black";
-  runFade(0.0, 1.0, fadeDuration / 2, dipColor);
+  const bool dip = style == TransitionStyle::DipToBlack || style == TransitionStyle::DipToWhite;
+  transition_.fadeOutMs = fadeDuration / 2;
+  transition_.holdMs = dip ? 100 : 0;
+  transition_.fadeInMs = fadeDuration / 2;
 
-  const bool ok = playCue(cue);
+  fadeOverlay_->setStyleSheet(
+      QString("background: %1;").arg(style == TransitionStyle::DipToWhite ? "white" : "black"));
+  fadeEffect_->setOpacity(0.0);
+  fadeOverlay_->show();
+  fadeOverlay_->raise();
+  enterPhase(TransitionPhase::FadeOut, nowMs);
+  return true;
+}
 
-  if (style == TransitionStyle::DipToBlack || style == TransitionStyle::DipToWhite) {
-    QEventLoop holdLoop;
-    QTimer::singleShot(100, &holdLoop, &QEventLoop::quit);
-    holdLoop.exec();
+void OutputWindow::advanceTransition(qint64 nowMs) {
+  // Phase boundaries are stamped at their scheduled time rather than at the
+  // tick that noticed them, so outputs started together stay on one timeline
+  // and a late tick can cross several phases at once.
+  while (transition_.phase != TransitionPhase::Idle) {
+    const qint64 elapsed = nowMs - transition_.phaseStartMs;
+
+    switch (transition_.phase) {
+      case TransitionPhase::FadeOut:
+        if (elapsed < transition_.fadeOutMs) {
+          fadeEffect_->setOpacity(static_cast<double>(elapsed) / transition_.fadeOutMs);
+          return;
+        }
+        fadeEffect_->setOpacity(1.0);
+        transition_.ok = playCue(transition_.cue);
+        transition_.played = true;
+        enterPhase(transition_.holdMs > 0 ? TransitionPhase::Hold : TransitionPhase::FadeIn,
+                   transition_.phaseStartMs + transition_.fadeOutMs);
+        break;
+      case TransitionPhase::Hold:
+        if (elapsed < transition_.holdMs) {
+          return;
+        }
+        enterPhase(TransitionPhase::FadeIn, transition_.phaseStartMs + transition_.holdMs);
+        break;
+      case TransitionPhase::FadeIn:
+        if (elapsed < transition_.fadeInMs) {
+          fadeEffect_->setOpacity(1.0 - static_cast<double>(elapsed) / transition_.fadeInMs);
+          return;
+        }
+        finishTransition();
+        return;
+      case TransitionPhase::Crossfade:
+        if (elapsed < transition_.crossfadeMs) {
+          surface_->setLayerOpacity(transition_.cue.layer, static_cast<double>(elapsed) / transition_.crossfadeMs);
+          return;
+        }
+        finishTransition();
+        return;
+      case TransitionPhase::Wipe:
+        if (elapsed < transition_.wipeMs) {
+          const int offset = static_cast<int>(width() * elapsed / transition_.wipeMs);
+          fadeOverlay_->setGeometry(QRect(offset, 0, width(), height()));
+          return;
+        }
+        finishTransition();
+        return;
+      case TransitionPhase::Idle:
+        return;
+    }
   }
-
-  runFade(1.0, 0.0, fadeDuration / 2, dipColor);
-  return ok;
 }
 
+bool OutputWindow::transitionActive() const { return transition_.phase != TransitionPhase::Idle; }
+
 bool OutputWindow::preloadCue(const Cue& cue) { return surface_->preloadCue(cue); }
 
-void OutputWindow::stopLayer(int layer) { surface_->stopLayer(layer); }
+bool OutputWindow::armCue(const Cue& cue) { return surface_->armCue(cue); }
+
+bool OutputWindow::isCueArmed(const Cue& cue) const { return surface_->isCueArmed(cue); }
+
+QString OutputWindow::standbyCueId(int layer) const { return surface_->standbyCueId(layer); }
+
+bool OutputWindow::releaseStandby(int layer, const QString& cueId) { return surface_->releaseStandby(layer, cueId); }
+
+void OutputWindow::stopLayer(int layer) {
+  cancelTransition(layer);
+  surface_->stopLayer(layer);
+}
 
 void OutputWindow::stopAll() {
+  cancelTransition(-1);
   surface_->stopAll();
   showSlate("SLATE\nPlayback stopped");
 }
 
+int OutputWindow::prewarmPlayers(int count) { return surface_->prewarmPlayers(count); }
+
+PlayerPoolStats OutputWindow::playerPoolStats() const { return surface_->playerPoolStats(); }
+
+void OutputWindow::setRenderBackend(RenderBackend backend) { surface_->setRenderBackend(backend); }
+
+void OutputWindow::setFilterPresets(const QMap<QString, QString>& presets) { surface_->setFilterPresets(presets); }
+
+void OutputWindow::setHoldTakes(bool hold) { surface_->setHoldTakes(hold); }
+
+void OutputWindow::startHeldTakes() { surface_->startHeldTakes(); }
+
 void OutputWindow::setCalibration(const OutputCalibration& calibration) {
   calibration_ = calibration;
   edgeBlendOverlay_->setBlendSize(calibration.edgeBlendPx);
@@ -185,36 +287,50 @@ void OutputWindow::showSlate(const QString& message) {
 
 void OutputWindow::hideSlate() { slateLabel_->hide(); }
 
-void OutputWindow::runFade(double from, double to, int durationMs, const QString& colorCss) {
-  fadeOverlay_->setStyleSheet(QString("background: %1;").arg(colorCss));
-  fadeOverlay_->show();
-  fadeOverlay_->raise();
-
-  auto* animation = new QPropertyAnimation(fadeEffect_, "opacity", this);
-  animation->setStartValue(from);
-  animation->setEndValue(to);
-  animation->setDuration(durationMs);
+void OutputWindow::enterPhase(TransitionPhase phase, qint64 startMs) {
+  transition_.phase = phase;
+  transition_.phaseStartMs = startMs;
+}
 
-  QEventLoop loop;
-  connect(animation, &QPropertyAnimation::finished, &loop, &QEventLoop::quit);
-  animation->start(QAbstractAnimation::DeleteWhenStopped);
-  loop.exec();
+void OutputWindow::completeTransition() {
+  if (transition_.phase == TransitionPhase::Idle) {
+    return;
+  }
 
-  if (to <= 0.01) {
-    fadeOverlay_->hide();
+  if (!transition_.played) {
+    transition_.ok = playCue(transition_.cue);
+    transition_.played = true;
   }
+  finishTransition();
 }
 
-void OutputWindow::runWipeReveal(int durationMs) {
-  auto* animation = new QPropertyAnimation(fadeOverlay_, "geometry", this);
-  animation->setDuration(durationMs);
-  animation->setStartValue(rect());
-  animation->setEndValue(QRect(width(), 0, width(), height()));
+void OutputWindow::finishTransition() {
+  if (transition_.phase == TransitionPhase::Crossfade) {
+    surface_->endCrossfade(transition_.cue.layer);
+  }
+  fadeOverlay_->hide();
+  fadeOverlay_->setGeometry(rect());
+  fadeEffect_->setOpacity(0.0);
+
+  const QString cueId = transition_.cue.id;
+  const bool ok = transition_.ok;
+  Trace::complete("output", "transition", transition_.traceStartNs, monotonicNowNs(), cueId);
+  transition_ = TransitionState();
+  emit transitionFinished(cueId, ok);
+}
 
-  QEventLoop loop;
-  connect(animation, &QPropertyAnimation::finished, &loop, &QEventLoop::quit);
-  animation->start(QAbstractAnimation::DeleteWhenStopped);
-  loop.exec();
+void OutputWindow::cancelTransition(int layer) {
+  if (transition_.phase == TransitionPhase::Idle || (layer >= 0 && transition_.cue.layer != layer)) {
+    return;
+  }
 
+  // Stops drop the pending take outright; the router settles its own
+  // bookkeeping for the cancelled route, so nothing is reported here.
+  if (transition_.phase == TransitionPhase::Crossfade) {
+    surface_->endCrossfade(transition_.cue.layer);
+  }
+  fadeOverlay_->hide();
   fadeOverlay_->setGeometry(rect());
+  fadeEffect_->setOpacity(0.0);
+  transition_ = TransitionState();
 }
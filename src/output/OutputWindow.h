@@ -1,10 +1,13 @@
 #pragma once
 
+#include <QMap>
 #include <QWidget>
 
 #include "core/Cue.h"
+#include "core/RenderBackend.h"
 #include "core/Transition.h"
 #include "output/OutputCalibration.h"
+#include "output/PlayerPool.h"
 
 class EdgeBlendOverlay;
 class LayerSurface;
@@ -20,10 +23,27 @@ class OutputWindow : public QWidget {
 
   void showOnScreen(QScreen* screen);
   bool playCue(const Cue& cue);
-  bool playCueWithTransition(const Cue& cue, TransitionStyle style, int durationMs);
+  // Transitions run on the router's shared frame clock: beginTransition()
+  // stamps the start time and advanceTransition() steps the overlay each tick.
+  // Cut plays immediately and returns the load result; other styles return
+  // true and report through transitionFinished once the picture settles.
+  bool beginTransition(const Cue& cue, TransitionStyle style, int durationMs, qint64 nowMs);
+  void advanceTransition(qint64 nowMs);
+  bool transitionActive() const;
   bool preloadCue(const Cue& cue);
+  bool armCue(const Cue& cue);
+  bool isCueArmed(const Cue& cue) const;
+  QString standbyCueId(int layer) const;
+  bool releaseStandby(int layer, const QString& cueId);
   void stopLayer(int layer);
   void stopAll();
+  int prewarmPlayers(int count);
+  PlayerPoolStats playerPoolStats() const;
+  void setRenderBackend(RenderBackend backend);
+  void setFilterPresets(const QMap<QString, QString>& presets);
+  // See LayerSurface::setHoldTakes().
+  void setHoldTakes(bool hold);
+  void startHeldTakes();
 
   void setCalibration(const OutputCalibration& calibration);
   OutputCalibration calibration() const;
@@ -33,6 +53,11 @@ class OutputWindow : public QWidget {
 
  signals:
   void playbackError(const QString& message);
+  void cuePositionChanged(const QString& cueId, int layer, double positionSec, double durationSec);
+  void cueMediaEnded(const QString& cueId, int layer);
+  void transitionFinished(const QString& cueId, bool ok);
+  void cueArmed(const QString& cueId, int layer);
+  void cueOnAir(const QString& cueId, int layer);
 
  protected:
   void resizeEvent(QResizeEvent* event) override;
@@ -40,8 +65,27 @@ class OutputWindow : public QWidget {
  private:
   void showSlate(const QString& message = QString());
   void hideSlate();
-  void runFade(double from, double to, int durationMs, const QString& colorCss = "black");
-  void runWipeReveal(int durationMs);
+  enum class TransitionPhase { Idle, FadeOut, Hold, FadeIn, Wipe, Crossfade };
+
+  struct TransitionState {
+    TransitionPhase phase = TransitionPhase::Idle;
+    Cue cue;
+    qint64 phaseStartMs = 0;
+    int fadeOutMs = 0;
+    int holdMs = 0;
+    int fadeInMs = 0;
+    int wipeMs = 0;
+    int crossfadeMs = 0;
+    bool played = false;
+    bool ok = true;
+    // Trace span start, or -1 when tracing was off at the take.
+    qint64 traceStartNs = -1;
+  };
+
+  void enterPhase(TransitionPhase phase, qint64 startMs);
+  void completeTransition();
+  void finishTransition();
+  void cancelTransition(int layer);
 
   LayerSurface* surface_;
   EdgeBlendOverlay* edgeBlendOverlay_;
@@ -51,4 +95,5 @@ class OutputWindow : public QWidget {
   QLabel* overlayLabel_;
   OutputCalibration calibration_;
   QString fallbackSlatePath_;
+  TransitionState transition_;
 };
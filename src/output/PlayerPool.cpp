@@ -0,0 +1,109 @@
+#include "output/PlayerPool.h"
+
+#include <QElapsedTimer>
+#include <QWidget>
+
+#include "player/IPlayer.h"
+#include "player/MpvPlayer.h"
+
+namespace {
+
+constexpr int kMaxIdlePlayers = 16;
+
+}  // namespace
+
+PlayerPool::PlayerPool(QWidget* host, RenderBackend backend, QObject* parent)
+    : QObject(parent), host_(host), backend_(backend) {}
+
+PlayerPool::~PlayerPool() { qDeleteAll(idle_); }
+
+IPlayer* PlayerPool::acquire() {
+  QElapsedTimer timer;
+  timer.start();
+
+  if (!idle_.isEmpty()) {
+    IPlayer* player = idle_.takeLast();
+    ++stats_.warmAcquires;
+    stats_.totalWarmAcquireNs += timer.nsecsElapsed();
+    return player;
+  }
+
+  IPlayer* player = createPlayer();
+  if (player == nullptr) {
+    return nullptr;
+  }
+  ++stats_.coldStarts;
+  stats_.totalColdStartNs += timer.nsecsElapsed();
+  return player;
+}
+
+void PlayerPool::release(IPlayer* player) {
+  if (player == nullptr) {
+    return;
+  }
+
+  player->stop();
+  player->clearFilters();
+  if (player->view() != nullptr) {
+    player->view()->hide();
+  }
+
+  if (idle_.size() >= kMaxIdlePlayers) {
+    player->deleteLater();
+    return;
+  }
+  idle_.push_back(player);
+}
+
+int PlayerPool::prewarm(int count) {
+  QElapsedTimer timer;
+  timer.start();
+
+  int created = 0;
+  while (idle_.size() < qMin(count, kMaxIdlePlayers)) {
+    IPlayer* player = createPlayer();
+    if (player == nullptr) {
+      break;
+    }
+    idle_.push_back(player);
+    ++created;
+  }
+
+  stats_.prewarmed += created;
+  stats_.totalPrewarmNs += timer.nsecsElapsed();
+  return created;
+}
+
+void PlayerPool::setViewGeometry(const QRect& rect) {
+  for (IPlayer* player : idle_) {
+    if (player->view() != nullptr) {
+      player->view()->setGeometry(rect);
+    }
+  }
+}
+
+int PlayerPool::idleCount() const { return idle_.size(); }
+
+RenderBackend PlayerPool::backend() const { return backend_; }
+
+PlayerPoolStats PlayerPool::stats() const { return stats_; }
+
+IPlayer* PlayerPool::createPlayer() {
+  if (backend_ == RenderBackend::SoftwareCompositor) {
+    return new MpvPlayer(host_, MpvPlayer::OutputMode::SoftwareRender);
+  }
+
+  auto* player = new MpvPlayer(host_);
+  QWidget* view = player->view();
+  if (view == nullptr) {
+    player->deleteLater();
+    return nullptr;
+  }
+
+  // Views stay hidden until a layer takes them; the native window id already
+  // exists, so mpv is bound and can decode into it off-screen.
+  view->setParent(host_);
+  view->setGeometry(host_ != nullptr ? host_->rect() : QRect());
+  view->hide();
+  return player;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QObject>
+#include <QVector>
+
+#include "core/RenderBackend.h"
+
+class IPlayer;
+class QRect;
+class QWidget;
+
+// What a layer's first cue pays to get a player: a cold start creates and
+// initializes mpv, a warm acquire takes a parked one. Prewarming is timed
+// like a cold start, since that is the cost it moves off the GO.
+struct PlayerPoolStats {
+  int coldStarts = 0;
+  qint64 totalColdStartNs = 0;
+  int warmAcquires = 0;
+  qint64 totalWarmAcquireNs = 0;
+  int prewarmed = 0;
+  qint64 totalPrewarmNs = 0;
+
+  PlayerPoolStats& operator+=(const PlayerPoolStats& other) {
+    coldStarts += other.coldStarts;
+    totalColdStartNs += other.totalColdStartNs;
+    warmAcquires += other.warmAcquires;
+    totalWarmAcquireNs += other.totalWarmAcquireNs;
+    prewarmed += other.prewarmed;
+    totalPrewarmNs += other.totalPrewarmNs;
+    return *this;
+  }
+};
+
+// Keeps fully initialized players parked off air so a new layer does not pay
+// mpv_create/mpv_initialize on its first cue. Players match the pool's render
+// backend: window-bound for native windows, view-less for the compositor.
+class PlayerPool : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit PlayerPool(QWidget* host, RenderBackend backend, QObject* parent = nullptr);
+  ~PlayerPool() override;
+
+  IPlayer* acquire();
+  void release(IPlayer* player);
+  int prewarm(int count);
+  void setViewGeometry(const QRect& rect);
+  int idleCount() const;
+  RenderBackend backend() const;
+  PlayerPoolStats stats() const;
+
+ private:
+  IPlayer* createPlayer();
+
+  QWidget* host_;
+  RenderBackend backend_;
+  QVector<IPlayer*> idle_;
+  PlayerPoolStats stats_;
+};
@@ -62,3 +62,5 @@ void PreviewWindow::setOverlayText(const QString& text) {
   overlayLabel_->show();
   overlayLabel_->raise();
 }
+
+void PreviewWindow::setFilterPresets(const QMap<QString, QString>& presets) { surface_->setFilterPresets(presets); }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QMap>
 #include <QWidget>
 
 #include "core/Cue.h"
@@ -18,6 +19,7 @@ class PreviewWindow : public QWidget {
   void stopAll();
   Cue lastCue() const;
   void setOverlayText(const QString& text);
+  void setFilterPresets(const QMap<QString, QString>& presets);
 
  signals:
   void previewError(const QString& message);
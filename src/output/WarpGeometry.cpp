@@ -0,0 +1,75 @@
+#include "output/WarpGeometry.h"
+
+namespace {
+
+QPolygonF rectQuad(const QSizeF& size) {
+  return QPolygonF({QPointF(0.0, 0.0), QPointF(size.width(), 0.0), QPointF(size.width(), size.height()),
+                    QPointF(0.0, size.height())});
+}
+
+}  // namespace
+
+QPolygonF keystoneSourceQuad(const QSizeF& size, const OutputCalibration& calibration) {
+  if (size.width() <= 0 || size.height() <= 0) {
+    return {};
+  }
+
+  if (calibration.keystoneHorizontal == 0 && calibration.keystoneVertical == 0) {
+    return {};
+  }
+
+  const double width = size.width();
+  const double height = size.height();
+
+  const double hNorm = static_cast<double>(calibration.keystoneHorizontal) / 100.0;
+  const double vNorm = static_cast<double>(calibration.keystoneVertical) / 100.0;
+
+  const double topInset = hNorm > 0.0 ? width * hNorm * 0.45 : 0.0;
+  const double bottomInset = hNorm < 0.0 ? width * -hNorm * 0.45 : 0.0;
+  const double leftInset = vNorm > 0.0 ? height * vNorm * 0.45 : 0.0;
+  const double rightInset = vNorm < 0.0 ? height * -vNorm * 0.45 : 0.0;
+
+  return QPolygonF({QPointF(topInset, leftInset), QPointF(width - topInset, rightInset),
+                    QPointF(width - bottomInset, height - rightInset), QPointF(bottomInset, height - leftInset)});
+}
+
+QPolygonF cornerPinDestinationQuad(const QSizeF& size, const OutputCalibration& calibration) {
+  if (size.width() <= 0 || size.height() <= 0 || !calibration.cornerPinEnabled) {
+    return {};
+  }
+
+  QPolygonF quad = rectQuad(size);
+  quad[0] += QPointF(calibration.cornerTopLeftX, calibration.cornerTopLeftY);
+  quad[1] += QPointF(calibration.cornerTopRightX, calibration.cornerTopRightY);
+  quad[2] += QPointF(calibration.cornerBottomRightX, calibration.cornerBottomRightY);
+  quad[3] += QPointF(calibration.cornerBottomLeftX, calibration.cornerBottomLeftY);
+  return quad == rectQuad(size) ? QPolygonF() : quad;
+}
+
+QTransform warpTransform(const QSizeF& size, const OutputCalibration& calibration) {
+  QTransform transform;
+
+  const QPolygonF keystone = keystoneSourceQuad(size, calibration);
+  QTransform keystoneTransform;
+  if (!keystone.isEmpty() && QTransform::quadToQuad(keystone, rectQuad(size), keystoneTransform)) {
+    transform = keystoneTransform;
+  }
+
+  const QPolygonF pin = cornerPinDestinationQuad(size, calibration);
+  QTransform pinTransform;
+  if (!pin.isEmpty() && QTransform::quadToQuad(rectQuad(size), pin, pinTransform)) {
+    transform *= pinTransform;
+  }
+
+  return transform;
+}
+
+QTransform unitWarpTransform(const QSizeF& size, const OutputCalibration& calibration) {
+  if (size.width() <= 0 || size.height() <= 0) {
+    return {};
+  }
+
+  const QTransform toPixels = QTransform::fromScale(size.width(), size.height());
+  const QTransform toUnit = QTransform::fromScale(1.0 / size.width(), 1.0 / size.height());
+  return toPixels * warpTransform(size, calibration) * toUnit;
+}
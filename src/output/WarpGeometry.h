@@ -0,0 +1,21 @@
+#pragma once
+
+#include <QPolygonF>
+#include <QSize>
+#include <QTransform>
+
+#include "output/OutputCalibration.h"
+
+// Keystone and corner-pin geometry for one output. Keystone is expressed as a
+// source quad (the frame region stretched to the output corners, matching the
+// ffmpeg perspective filter's default sense); corner pin is a destination quad
+// (where each frame corner lands on the output).
+QPolygonF keystoneSourceQuad(const QSizeF& size, const OutputCalibration& calibration);
+QPolygonF cornerPinDestinationQuad(const QSizeF& size, const OutputCalibration& calibration);
+
+// Presentation-time warp for compositing; identity when nothing is set.
+QTransform warpTransform(const QSizeF& size, const OutputCalibration& calibration);
+
+// The same warp on the unit square, for players that warp their own output
+// (native windows), independent of the output's pixel size.
+QTransform unitWarpTransform(const QSizeF& size, const OutputCalibration& calibration);
@@ -0,0 +1,160 @@
+#include "player/FilterGraph.h"
+
+namespace {
+
+const char* segmentTag(FilterSegment segment) {
+  switch (segment) {
+    case FilterSegment::Calibration:
+      return "cal";
+    case FilterSegment::Preset:
+      return "pre";
+    case FilterSegment::Cue:
+    default:
+      return "cue";
+  }
+}
+
+}  // namespace
+
+bool splitFilterChain(const QString& chain, QStringList* entries, QString* error) {
+  entries->clear();
+  const QString trimmed = chain.trimmed();
+  if (trimmed.isEmpty()) {
+    return true;
+  }
+
+  int depth = 0;
+  int start = 0;
+  for (int i = 0; i <= trimmed.size(); ++i) {
+    const QChar ch = i < trimmed.size() ? trimmed.at(i) : QChar(',');
+    if (ch == '[') {
+      ++depth;
+    } else if (ch == ']') {
+      if (--depth < 0) {
+        break;
+      }
+    } else if (ch == ',' && depth == 0) {
+      const QString entry = trimmed.mid(start, i - start).trimmed();
+      if (entry.isEmpty()) {
+        if (error != nullptr) {
+          *error = QString("empty filter at offset %1").arg(start);
+        }
+        entries->clear();
+        return false;
+      }
+      entries->push_back(entry);
+      start = i + 1;
+    }
+  }
+
+  if (depth != 0) {
+    if (error != nullptr) {
+      *error = "unbalanced '[' / ']'";
+    }
+    entries->clear();
+    return false;
+  }
+  return true;
+}
+
+bool FilterGraph::setSegment(FilterSegment segment, const QString& chain, QVector<Command>* commands,
+                             QString* error) {
+  commands->clear();
+
+  QStringList entries;
+  if (!splitFilterChain(chain, &entries, error)) {
+    return false;
+  }
+
+  const int index = static_cast<int>(segment);
+  if (entries == entries_[index]) {
+    chains_[index] = chain.trimmed();
+    return true;
+  }
+
+  // Calibration sits in front, so it is prepended and never disturbs the rest.
+  // Later segments are appended, which means everything behind the changed
+  // segment has to come off and go back on to keep the order.
+  if (segment == FilterSegment::Calibration) {
+    appendRemoves(segment, commands);
+    entries_[index] = entries;
+    chains_[index] = chain.trimmed();
+    appendAdds(segment, commands);
+    return true;
+  }
+
+  for (int i = kSegmentCount - 1; i >= index; --i) {
+    appendRemoves(static_cast<FilterSegment>(i), commands);
+  }
+  entries_[index] = entries;
+  chains_[index] = chain.trimmed();
+  for (int i = index; i < kSegmentCount; ++i) {
+    appendAdds(static_cast<FilterSegment>(i), commands);
+  }
+  return true;
+}
+
+QVector<FilterGraph::Command> FilterGraph::clear() {
+  if (isEmpty()) {
+    return {};
+  }
+
+  for (int i = 0; i < kSegmentCount; ++i) {
+    entries_[i].clear();
+    chains_[i].clear();
+  }
+  return {{"clr", QString()}};
+}
+
+FilterGraph::Command FilterGraph::resyncCommand() const {
+  QStringList labeled;
+  for (int i = 0; i < kSegmentCount; ++i) {
+    for (int entry = 0; entry < entries_[i].size(); ++entry) {
+      labeled.push_back(QString("@%1:%2").arg(label(static_cast<FilterSegment>(i), entry), entries_[i].at(entry)));
+    }
+  }
+  return {"set", labeled.join(',')};
+}
+
+void FilterGraph::dropSegment(FilterSegment segment) {
+  const int index = static_cast<int>(segment);
+  entries_[index].clear();
+  chains_[index].clear();
+}
+
+QString FilterGraph::segment(FilterSegment segment) const { return chains_[static_cast<int>(segment)]; }
+
+bool FilterGraph::isEmpty() const {
+  for (int i = 0; i < kSegmentCount; ++i) {
+    if (!entries_[i].isEmpty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+QString FilterGraph::label(FilterSegment segment, int index) {
+  return QString("%1%2").arg(segmentTag(segment)).arg(index);
+}
+
+void FilterGraph::appendRemoves(FilterSegment segment, QVector<Command>* commands) const {
+  const QStringList& entries = entries_[static_cast<int>(segment)];
+  for (int i = 0; i < entries.size(); ++i) {
+    commands->push_back({"remove", QString("@%1").arg(label(segment, i))});
+  }
+}
+
+void FilterGraph::appendAdds(FilterSegment segment, QVector<Command>* commands) const {
+  const QStringList& entries = entries_[static_cast<int>(segment)];
+  if (segment == FilterSegment::Calibration) {
+    // "pre" inserts at the front, so walk backwards to keep entry order.
+    for (int i = entries.size() - 1; i >= 0; --i) {
+      commands->push_back({"pre", QString("@%1:%2").arg(label(segment, i), entries.at(i))});
+    }
+    return;
+  }
+
+  for (int i = 0; i < entries.size(); ++i) {
+    commands->push_back({"add", QString("@%1:%2").arg(label(segment, i), entries.at(i))});
+  }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// Independent parts of a layer's vf chain, in the order mpv applies them.
+enum class FilterSegment { Calibration = 0, Preset = 1, Cue = 2 };
+
+// Splits a vf chain into filter entries on top-level commas; commas inside a
+// bracketed lavfi graph stay with their entry. Returns false on unbalanced
+// brackets or empty entries.
+bool splitFilterChain(const QString& chain, QStringList* entries, QString* error = nullptr);
+
+// Mirrors the labeled vf entries applied to one mpv instance. Each entry is
+// tagged @<segment><index>, and changing a segment yields only the vf
+// remove/add/pre commands that touch that segment (plus any segment that has
+// to be re-appended behind it), so mpv keeps every other filter instance.
+class FilterGraph {
+ public:
+  struct Command {
+    QString operation;
+    QString argument;
+  };
+
+  // Returns the commands to run, or an empty list when nothing changed. An
+  // unparsable chain leaves the graph untouched and returns false.
+  bool setSegment(FilterSegment segment, const QString& chain, QVector<Command>* commands, QString* error = nullptr);
+  QVector<Command> clear();
+  // Single "set" command rebuilding the whole chain, used to resync after mpv
+  // rejected an incremental command.
+  Command resyncCommand() const;
+  void dropSegment(FilterSegment segment);
+  QString segment(FilterSegment segment) const;
+  bool isEmpty() const;
+
+ private:
+  static constexpr int kSegmentCount = 3;
+
+  static QString label(FilterSegment segment, int index);
+  void appendRemoves(FilterSegment segment, QVector<Command>* commands) const;
+  void appendAdds(FilterSegment segment, QVector<Command>* commands) const;
+
+  QStringList entries_[kSegmentCount];
+  QString chains_[kSegmentCount];
+};
@@ -0,0 +1,75 @@
+#include "player/FilterValidator.h"
+
+#include <QStringList>
+
+#include "player/FilterGraph.h"
+
+extern "C" {
+#include <mpv/client.h>
+}
+
+FilterValidator::FilterValidator() {
+  mpv_ = mpv_create();
+  if (mpv_ == nullptr) {
+    return;
+  }
+
+  mpv_set_option_string(mpv_, "vo", "null");
+  mpv_set_option_string(mpv_, "ao", "null");
+  mpv_set_option_string(mpv_, "idle", "yes");
+  mpv_set_option_string(mpv_, "terminal", "no");
+  if (mpv_initialize(mpv_) < 0) {
+    mpv_terminate_destroy(mpv_);
+    mpv_ = nullptr;
+  }
+}
+
+FilterValidator::~FilterValidator() {
+  if (mpv_ != nullptr) {
+    mpv_terminate_destroy(mpv_);
+    mpv_ = nullptr;
+  }
+}
+
+bool FilterValidator::validate(const QString& chain, QString* error) {
+  const QString key = chain.trimmed();
+  if (key.isEmpty()) {
+    return true;
+  }
+
+  auto it = cache_.constFind(key);
+  if (it == cache_.constEnd()) {
+    it = cache_.insert(key, check(key));
+  }
+
+  if (!it.value().ok && error != nullptr) {
+    *error = it.value().error;
+  }
+  return it.value().ok;
+}
+
+int FilterValidator::cachedCount() const { return cache_.size(); }
+
+FilterValidator::Verdict FilterValidator::check(const QString& chain) {
+  Verdict verdict;
+
+  QStringList entries;
+  if (!splitFilterChain(chain, &entries, &verdict.error)) {
+    verdict.ok = false;
+    return verdict;
+  }
+
+  // Without libmpv only the syntax check above applies.
+  if (mpv_ == nullptr) {
+    return verdict;
+  }
+
+  const QByteArray encoded = chain.toUtf8();
+  const int status = mpv_set_property_string(mpv_, "vf", encoded.constData());
+  if (status < 0) {
+    verdict.ok = false;
+    verdict.error = QString::fromUtf8(mpv_error_string(status));
+  }
+  mpv_set_property_string(mpv_, "vf", "");
+  return verdict;
+}
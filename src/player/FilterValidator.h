@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+
+struct mpv_handle;
+
+// Checks vf chains once against an idle libmpv instance and caches the
+// verdict, so a bad filter preset or cue filter is rejected when it is edited
+// instead of when the cue goes live. mpv resolves filter names and option
+// syntax here; argument values a filter only checks on init still surface as
+// playback errors.
+class FilterValidator {
+ public:
+  FilterValidator();
+  ~FilterValidator();
+
+  FilterValidator(const FilterValidator&) = delete;
+  FilterValidator& operator=(const FilterValidator&) = delete;
+
+  bool validate(const QString& chain, QString* error = nullptr);
+  int cachedCount() const;
+
+ private:
+  struct Verdict {
+    bool ok = true;
+    QString error;
+  };
+
+  Verdict check(const QString& chain);
+
+  mpv_handle* mpv_ = nullptr;
+  QHash<QString, Verdict> cache_;
+};
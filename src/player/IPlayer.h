@@ -2,6 +2,9 @@
 
 #include <QObject>
 #include <QString>
+#include <QTransform>
+
+#include "player/FilterGraph.h"
 
 class QWidget;
 
@@ -14,11 +17,24 @@ class IPlayer : public QObject {
 
   virtual QWidget* view() = 0;
   virtual bool load(const QString& filePath, bool loop, bool startPaused) = 0;
-  virtual void setVideoFilter(const QString& filter) = 0;
+  // Replaces one segment of the vf chain; segments left unchanged keep their
+  // filter instances.
+  virtual void setFilterSegment(FilterSegment segment, const QString& chain) = 0;
+  virtual void clearFilters() = 0;
+  // Warps the picture at presentation, frame to output on the unit square;
+  // identity clears it. Never touches the vf chain.
+  virtual void setWarp(const QTransform& warp) = 0;
   virtual void play() = 0;
   virtual void stop() = 0;
   virtual void pause() = 0;
+  virtual double position() const = 0;
+  virtual double duration() const = 0;
 
  signals:
   void playbackError(const QString& message);
+  void positionChanged(double seconds);
+  void durationChanged(double seconds);
+  void endOfFile();
+  void firstFrameReady();
+  void frameDropCountChanged(qint64 count);
 };
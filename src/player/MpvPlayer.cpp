@@ -2,16 +2,94 @@
 
 #include <cstdint>
 
+#include <QDir>
+#include <QFile>
 #include <QFileInfo>
 #include <QMetaObject>
+#include <QStandardPaths>
 #include <QWidget>
 
 extern "C" {
 #include <mpv/client.h>
+#include <mpv/render.h>
 }
 
+#include "core/Trace.h"
+
 namespace {
 
+// reply_userdata ids for mpv_observe_property.
+enum ObservedProperty : quint64 {
+  kObserveTimePos = 1,
+  kObserveDuration,
+  kObserveEofReached,
+  kObserveFrameDropCount,
+};
+
+// Output-stage perspective warp for native windows. Each output pixel samples
+// the frame through the inverse warp, in QTransform's m11..m33 layout. The
+// parameters are dynamic, so changing them never recompiles the shader or
+// reinitializes the video.
+constexpr char kWarpShaderSource[] = R"(//!PARAM warp_m11
+//!TYPE DYNAMIC float
+1.0
+//!PARAM warp_m12
+//!TYPE DYNAMIC float
+0.0
+//!PARAM warp_m13
+//!TYPE DYNAMIC float
+0.0
+//!PARAM warp_m21
+//!TYPE DYNAMIC float
+0.0
+//!PARAM warp_m22
+//!TYPE DYNAMIC float
+1.0
+//!PARAM warp_m23
+//!TYPE DYNAMIC float
+0.0
+//!PARAM warp_m31
+//!TYPE DYNAMIC float
+0.0
+//!PARAM warp_m32
+//!TYPE DYNAMIC float
+0.0
+//!PARAM warp_m33
+//!TYPE DYNAMIC float
+1.0
+//!HOOK OUTPUT
+//!BIND HOOKED
+//!DESC output warp
+vec4 hook() {
+    vec2 p = HOOKED_pos;
+    float w = warp_m13 * p.x + warp_m23 * p.y + warp_m33;
+    vec2 uv = vec2(warp_m11 * p.x + warp_m21 * p.y + warp_m31, warp_m12 * p.x + warp_m22 * p.y + warp_m32) / w;
+    if (w <= 0.0 || any(lessThan(uv, vec2(0.0))) || any(greaterThan(uv, vec2(1.0)))) {
+        return vec4(0.0, 0.0, 0.0, 1.0);
+    }
+    return HOOKED_tex(uv);
+}
+)";
+
+// mpv loads user shaders from files, so the source is written out once per
+// run; empty if that fails.
+QString warpShaderPath() {
+  static const QString path = []() -> QString {
+    const QString cache = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (cache.isEmpty() || !QDir().mkpath(cache)) {
+      return {};
+    }
+    const QString filePath = QDir(cache).filePath("output-warp.glsl");
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+        file.write(kWarpShaderSource, sizeof(kWarpShaderSource) - 1) != qint64(sizeof(kWarpShaderSource) - 1)) {
+      return {};
+    }
+    return filePath;
+  }();
+  return path;
+}
+
 class VideoHostWidget final : public QWidget {
  public:
   explicit VideoHostWidget(QWidget* parent = nullptr) : QWidget(parent) {
@@ -23,11 +101,18 @@ class VideoHostWidget final : public QWidget {
 
 }  // namespace
 
-MpvPlayer::MpvPlayer(QObject* parent) : IPlayer(parent), videoWidget_(new VideoHostWidget) {
+MpvPlayer::MpvPlayer(QObject* parent, OutputMode mode)
+    : IPlayer(parent), mode_(mode), videoWidget_(mode == OutputMode::NativeWindow ? new VideoHostWidget : nullptr) {
   initialize();
 }
 
 MpvPlayer::~MpvPlayer() {
+  if (renderContext_ != nullptr) {
+    mpv_render_context_set_update_callback(renderContext_, nullptr, nullptr);
+    mpv_render_context_free(renderContext_);
+    renderContext_ = nullptr;
+  }
+
   if (mpv_ != nullptr) {
     mpv_set_wakeup_callback(mpv_, nullptr, nullptr);
     mpv_terminate_destroy(mpv_);
@@ -37,9 +122,67 @@ MpvPlayer::~MpvPlayer() {
   delete videoWidget_;
 }
 
+MpvPlayer::OutputMode MpvPlayer::outputMode() const { return mode_; }
+
+bool MpvPlayer::renderSoftwareFrame(const QSize& size, bool force) {
+  if (renderContext_ == nullptr || size.isEmpty()) {
+    return false;
+  }
+
+  const uint64_t flags = mpv_render_context_update(renderContext_);
+  const bool resized = softwareFrame_.size() != size;
+  if (!force && !resized && (flags & MPV_RENDER_UPDATE_FRAME) == 0) {
+    return false;
+  }
+
+  // Format_ARGB32_Premultiplied is 0xAARRGGBB per pixel, i.e. B,G,R,A in
+  // memory on the little-endian targets we ship, which is mpv's "bgra"; the
+  // alpha lets a layer with transparent media show the ones below. An mpv
+  // without it falls back to opaque "bgr0" into Format_RGB32.
+  const QImage::Format format = softwareAlpha_ ? QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32;
+  if (resized || softwareFrame_.format() != format) {
+    softwareFrame_ = QImage(size, format);
+    softwareFrame_.fill(Qt::transparent);
+  }
+
+  int renderSize[2] = {size.width(), size.height()};
+  size_t stride = static_cast<size_t>(softwareFrame_.bytesPerLine());
+  mpv_render_param params[] = {
+      {MPV_RENDER_PARAM_SW_SIZE, renderSize},
+      {MPV_RENDER_PARAM_SW_FORMAT, const_cast<char*>(softwareAlpha_ ? "bgra" : "bgr0")},
+      {MPV_RENDER_PARAM_SW_STRIDE, &stride},
+      {MPV_RENDER_PARAM_SW_POINTER, softwareFrame_.bits()},
+      {MPV_RENDER_PARAM_INVALID, nullptr},
+  };
+
+  const int status = mpv_render_context_render(renderContext_, params);
+  if (status < 0 && softwareAlpha_) {
+    softwareAlpha_ = false;
+    return renderSoftwareFrame(size, true);
+  }
+  if (status < 0) {
+    emit playbackError(QString("libmpv software render failed: %1").arg(mpv_error_string(status)));
+    return false;
+  }
+  if (!softwareAlpha_) {
+    // mpv leaves bgr0's padding byte undefined, but Format_RGB32 needs it at
+    // 0xFF or blending reads it as alpha.
+    for (int y = 0; y < softwareFrame_.height(); ++y) {
+      auto* line = reinterpret_cast<quint32*>(softwareFrame_.scanLine(y));
+      for (int x = 0; x < softwareFrame_.width(); ++x) {
+        line[x] |= 0xff000000u;
+      }
+    }
+  }
+  return true;
+}
+
+const QImage& MpvPlayer::softwareFrame() const { return softwareFrame_; }
+
 QWidget* MpvPlayer::view() { return videoWidget_; }
 
 bool MpvPlayer::load(const QString& filePath, bool loop, bool startPaused) {
+  const TraceScope trace("mpv", "load", [&filePath]() { return filePath; });
   if (!initialized_ && !initialize()) {
     return false;
   }
@@ -49,13 +192,24 @@ bool MpvPlayer::load(const QString& filePath, bool loop, bool startPaused) {
     return false;
   }
 
-  const QString absolute = QFileInfo(filePath).absoluteFilePath();
+  const QString absolute = filePath.contains("://") ? filePath : QFileInfo(filePath).absoluteFilePath();
   const QByteArray encodedPath = absolute.toUtf8();
 
   if (!setPropertyString("loop-file", loop ? "inf" : "no")) {
     return false;
   }
 
+  // Pause before loadfile so a preloaded cue holds on its first decoded frame
+  // instead of running a few frames before the pause lands.
+  if (!setPropertyString("pause", startPaused ? "yes" : "no")) {
+    return false;
+  }
+
+  position_ = 0.0;
+  duration_ = 0.0;
+  awaitingFirstFrame_ = true;
+  eofReported_ = false;
+
   const char* command[] = {"loadfile", encodedPath.constData(), "replace", nullptr};
   const int status = mpv_command(mpv_, command);
   if (status < 0) {
@@ -63,23 +217,88 @@ bool MpvPlayer::load(const QString& filePath, bool loop, bool startPaused) {
     return false;
   }
 
-  if (startPaused) {
-    pause();
+  return true;
+}
+
+void MpvPlayer::setFilterSegment(FilterSegment segment, const QString& chain) {
+  if (mpv_ == nullptr) {
+    return;
   }
 
-  return true;
+  QVector<FilterGraph::Command> commands;
+  QString error;
+  if (!filterGraph_.setSegment(segment, chain, &commands, &error)) {
+    emit playbackError(QString("Invalid video filter '%1': %2").arg(chain, error));
+    return;
+  }
+
+  if (runFilterCommands(commands)) {
+    return;
+  }
+
+  // mpv refused part of the change; drop the segment and rebuild the rest in
+  // one go so the graph mirror matches what is actually applied.
+  filterGraph_.dropSegment(segment);
+  runFilterCommands({filterGraph_.resyncCommand()});
 }
 
-void MpvPlayer::setVideoFilter(const QString& filter) {
+void MpvPlayer::clearFilters() {
   if (mpv_ == nullptr) {
     return;
   }
+  runFilterCommands(filterGraph_.clear());
+}
 
-  const QByteArray encoded = filter.toUtf8();
-  const int status = mpv_set_property_string(mpv_, "vf", encoded.isEmpty() ? "" : encoded.constData());
-  if (status < 0) {
-    emit playbackError(QString("libmpv set video filter failed: %1").arg(mpv_error_string(status)));
+void MpvPlayer::setWarp(const QTransform& warp) {
+  if (mpv_ == nullptr || mode_ != OutputMode::NativeWindow || warp == warp_) {
+    return;
+  }
+
+  bool invertible = false;
+  const QTransform inverse = warp.inverted(&invertible);
+  if (!invertible) {
+    emit playbackError("Output warp is degenerate; keeping the previous one.");
+    return;
+  }
+  // The shader goes in with the first real warp; until then the output
+  // pipeline stays exactly as it was.
+  if (!warpShaderLoaded_ && warp.isIdentity()) {
+    warp_ = warp;
+    return;
   }
+
+  const TraceScope trace("mpv", "setWarp");
+  const QString options = QString("warp_m11=%1,warp_m12=%2,warp_m13=%3,warp_m21=%4,warp_m22=%5,warp_m23=%6,"
+                                  "warp_m31=%7,warp_m32=%8,warp_m33=%9")
+                              .arg(inverse.m11(), 0, 'g', 9)
+                              .arg(inverse.m12(), 0, 'g', 9)
+                              .arg(inverse.m13(), 0, 'g', 9)
+                              .arg(inverse.m21(), 0, 'g', 9)
+                              .arg(inverse.m22(), 0, 'g', 9)
+                              .arg(inverse.m23(), 0, 'g', 9)
+                              .arg(inverse.m31(), 0, 'g', 9)
+                              .arg(inverse.m32(), 0, 'g', 9)
+                              .arg(inverse.m33(), 0, 'g', 9);
+  if (!setPropertyString("glsl-shader-opts", options.toUtf8().constData())) {
+    return;
+  }
+
+  if (!warpShaderLoaded_) {
+    const QString path = warpShaderPath();
+    if (path.isEmpty()) {
+      emit playbackError("Could not write the output warp shader.");
+      return;
+    }
+    const QByteArray pathBytes = path.toUtf8();
+    const char* args[] = {"change-list", "glsl-shaders", "append", pathBytes.constData(), nullptr};
+    const int status = mpv_command(mpv_, args);
+    if (status < 0) {
+      emit playbackError(QString("libmpv could not load the output warp shader: %1").arg(mpv_error_string(status)));
+      return;
+    }
+    warpShaderLoaded_ = true;
+  }
+  warp_ = warp;
 }
 
 void MpvPlayer::play() {
@@ -108,6 +327,10 @@ void MpvPlayer::pause() {
   setPropertyString("pause", "yes");
 }
 
+double MpvPlayer::position() const { return position_; }
+
+double MpvPlayer::duration() const { return duration_; }
+
 void MpvPlayer::wakeup(void* context) {
   auto* self = static_cast<MpvPlayer*>(context);
   if (self == nullptr) {
@@ -117,6 +340,16 @@ void MpvPlayer::wakeup(void* context) {
   QMetaObject::invokeMethod(self, [self]() { self->processEvents(); }, Qt::QueuedConnection);
 }
 
+void MpvPlayer::renderUpdate(void* context) {
+  auto* self = static_cast<MpvPlayer*>(context);
+  if (self == nullptr) {
+    return;
+  }
+
+  // Called on an mpv thread; the compositor renders on the GUI thread.
+  QMetaObject::invokeMethod(self, [self]() { emit self->frameAvailable(); }, Qt::QueuedConnection);
+}
+
 void MpvPlayer::processEvents() {
   if (mpv_ == nullptr) {
     return;
@@ -132,19 +365,73 @@ void MpvPlayer::processEvents() {
       break;
     }
 
+    if (event->event_id == MPV_EVENT_PROPERTY_CHANGE) {
+      const auto* property = static_cast<const mpv_event_property*>(event->data);
+      if (property != nullptr && property->format != MPV_FORMAT_NONE) {
+        handlePropertyChange(event->reply_userdata, property->data);
+      }
+      continue;
+    }
+
+    if (event->event_id == MPV_EVENT_PLAYBACK_RESTART) {
+      if (awaitingFirstFrame_) {
+        awaitingFirstFrame_ = false;
+        emit firstFrameReady();
+      }
+      continue;
+    }
+
     if (event->event_id == MPV_EVENT_END_FILE) {
-      // Playback completion hook for future cue-state integration.
+      // With keep-open=yes a natural end arrives as eof-reached; END_FILE with
+      // reason EOF only shows up if that option is overridden.
+      const auto* endFile = static_cast<const mpv_event_end_file*>(event->data);
+      if (endFile != nullptr && endFile->reason == MPV_END_FILE_REASON_EOF) {
+        reportEndOfFile();
+      }
       continue;
     }
   }
 }
 
+void MpvPlayer::handlePropertyChange(quint64 id, const void* data) {
+  switch (id) {
+    case kObserveTimePos:
+      position_ = *static_cast<const double*>(data);
+      emit positionChanged(position_);
+      break;
+    case kObserveDuration:
+      duration_ = *static_cast<const double*>(data);
+      emit durationChanged(duration_);
+      break;
+    case kObserveEofReached:
+      // Ignore eof-reached until the current file has started, so a stale flag
+      // from the previous file cannot end the new one.
+      if (*static_cast<const int*>(data) != 0 && !awaitingFirstFrame_) {
+        reportEndOfFile();
+      }
+      break;
+    case kObserveFrameDropCount:
+      emit frameDropCountChanged(static_cast<qint64>(*static_cast<const int64_t*>(data)));
+      break;
+    default:
+      break;
+  }
+}
+
+void MpvPlayer::reportEndOfFile() {
+  if (eofReported_) {
+    return;
+  }
+  eofReported_ = true;
+  emit endOfFile();
+}
+
 bool MpvPlayer::initialize() {
   if (initialized_) {
     return true;
   }
 
-  if (videoWidget_ == nullptr) {
+  if (mode_ == OutputMode::NativeWindow && videoWidget_ == nullptr) {
     emit playbackError("Failed to initialize video host widget.");
     return false;
   }
@@ -155,16 +442,22 @@ bool MpvPlayer::initialize() {
     return false;
   }
 
-  int64_t wid = static_cast<int64_t>(videoWidget_->winId());
-  if (mpv_set_option(mpv_, "wid", MPV_FORMAT_INT64, &wid) < 0) {
-    emit playbackError("libmpv could not bind to Qt window.");
-    mpv_terminate_destroy(mpv_);
-    mpv_ = nullptr;
-    return false;
+  if (mode_ == OutputMode::NativeWindow) {
+    int64_t wid = static_cast<int64_t>(videoWidget_->winId());
+    if (mpv_set_option(mpv_, "wid", MPV_FORMAT_INT64, &wid) < 0) {
+      emit playbackError("libmpv could not bind to Qt window.");
+      mpv_terminate_destroy(mpv_);
+      mpv_ = nullptr;
+      return false;
+    }
+
+    mpv_set_option_string(mpv_, "vo", "gpu-next");
+    mpv_set_option_string(mpv_, "hwdec", "auto-safe");
+  } else {
+    mpv_set_option_string(mpv_, "vo", "libmpv");
+    mpv_set_option_string(mpv_, "hwdec", "no");
   }
 
-  mpv_set_option_string(mpv_, "vo", "gpu-next");
-  mpv_set_option_string(mpv_, "hwdec", "auto-safe");
   mpv_set_option_string(mpv_, "alpha", "yes");
   mpv_set_option_string(mpv_, "terminal", "no");
   mpv_set_option_string(mpv_, "keep-open", "yes");
@@ -177,11 +470,59 @@ bool MpvPlayer::initialize() {
     return false;
   }
 
+  if (mode_ == OutputMode::SoftwareRender && !createRenderContext()) {
+    mpv_terminate_destroy(mpv_);
+    mpv_ = nullptr;
+    return false;
+  }
+
+  mpv_observe_property(mpv_, kObserveTimePos, "time-pos", MPV_FORMAT_DOUBLE);
+  mpv_observe_property(mpv_, kObserveDuration, "duration", MPV_FORMAT_DOUBLE);
+  mpv_observe_property(mpv_, kObserveEofReached, "eof-reached", MPV_FORMAT_FLAG);
+  mpv_observe_property(mpv_, kObserveFrameDropCount, "frame-drop-count", MPV_FORMAT_INT64);
+
   mpv_set_wakeup_callback(mpv_, &MpvPlayer::wakeup, this);
   initialized_ = true;
   return true;
 }
 
+bool MpvPlayer::createRenderContext() {
+  mpv_render_param params[] = {
+      {MPV_RENDER_PARAM_API_TYPE, const_cast<char*>(MPV_RENDER_API_TYPE_SW)},
+      {MPV_RENDER_PARAM_INVALID, nullptr},
+  };
+
+  const int status = mpv_render_context_create(&renderContext_, mpv_, params);
+  if (status < 0) {
+    emit playbackError(QString("libmpv software render context failed: %1").arg(mpv_error_string(status)));
+    renderContext_ = nullptr;
+    return false;
+  }
+
+  mpv_render_context_set_update_callback(renderContext_, &MpvPlayer::renderUpdate, this);
+  return true;
+}
+
+bool MpvPlayer::runFilterCommands(const QVector<FilterGraph::Command>& commands) {
+  if (commands.isEmpty()) {
+    return true;
+  }
+
+  const TraceScope trace("mpv", "filterReinit");
+  for (const FilterGraph::Command& command : commands) {
+    const QByteArray operation = command.operation.toUtf8();
+    const QByteArray argument = command.argument.toUtf8();
+    const char* args[] = {"vf", operation.constData(), argument.constData(), nullptr};
+    const int status = mpv_command(mpv_, args);
+    if (status < 0) {
+      emit playbackError(QString("libmpv vf %1 '%2' failed: %3")
+                             .arg(command.operation, command.argument, mpv_error_string(status)));
+      return false;
+    }
+  }
+  return true;
+}
+
 bool MpvPlayer::setPropertyString(const char* name, const char* value) {
   if (mpv_ == nullptr) {
     return false;
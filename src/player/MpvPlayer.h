@@ -1,33 +1,70 @@
 #pragma once
 
+#include <QImage>
 #include <QPointer>
+#include <QTransform>
 
 #include "player/IPlayer.h"
 
 struct mpv_handle;
+struct mpv_render_context;
 
 class MpvPlayer final : public IPlayer {
   Q_OBJECT
 
  public:
-  explicit MpvPlayer(QObject* parent = nullptr);
+  // NativeWindow binds mpv to its own native child window (vo=gpu-next).
+  // SoftwareRender uses the libmpv render API with MPV_RENDER_API_TYPE_SW and
+  // has no view; a compositor pulls frames through renderSoftwareFrame().
+  enum class OutputMode { NativeWindow, SoftwareRender };
+
+  explicit MpvPlayer(QObject* parent = nullptr, OutputMode mode = OutputMode::NativeWindow);
   ~MpvPlayer() override;
 
+  OutputMode outputMode() const;
+  bool renderSoftwareFrame(const QSize& size, bool force = false);
+  const QImage& softwareFrame() const;
+
   QWidget* view() override;
   bool load(const QString& filePath, bool loop, bool startPaused) override;
-  void setVideoFilter(const QString& filter) override;
+  void setFilterSegment(FilterSegment segment, const QString& chain) override;
+  void clearFilters() override;
+  // Native windows only; the compositor paints its own warp.
+  void setWarp(const QTransform& warp) override;
   void play() override;
   void stop() override;
   void pause() override;
+  double position() const override;
+  double duration() const override;
+
+ signals:
+  void frameAvailable();
 
  private:
   static void wakeup(void* context);
+  static void renderUpdate(void* context);
 
   void processEvents();
+  void handlePropertyChange(quint64 id, const void* data);
+  void reportEndOfFile();
   bool initialize();
+  bool createRenderContext();
   bool setPropertyString(const char* name, const char* value);
+  bool runFilterCommands(const QVector<FilterGraph::Command>& commands);
 
+  OutputMode mode_;
   QPointer<QWidget> videoWidget_;
   mpv_handle* mpv_ = nullptr;
+  mpv_render_context* renderContext_ = nullptr;
+  QImage softwareFrame_;
+  // Cleared if this mpv cannot render "bgra".
+  bool softwareAlpha_ = true;
+  FilterGraph filterGraph_;
+  QTransform warp_;
+  bool warpShaderLoaded_ = false;
   bool initialized_ = false;
+  double position_ = 0.0;
+  double duration_ = 0.0;
+  bool awaitingFirstFrame_ = false;
+  bool eofReported_ = false;
 };
@@ -67,6 +67,8 @@ QJsonObject cueToJson(const Cue& cue, const QDir& baseDir, bool useRelativeMedia
   object.insert("playlistAutoAdvance", cue.playlistAutoAdvance);
   object.insert("playlistLoop", cue.playlistLoop);
   object.insert("playlistAdvanceDelayMs", cue.playlistAdvanceDelayMs);
+  object.insert("advanceTrigger", advanceTriggerToString(cue.advanceTrigger));
+  object.insert("advanceLeadMs", cue.advanceLeadMs);
   object.insert("autoStopMs", cue.autoStopMs);
   return object;
 }
@@ -100,6 +102,8 @@ Cue cueFromJson(const QJsonObject& object, const QDir& baseDir) {
   cue.playlistAutoAdvance = object.value("playlistAutoAdvance").toBool(false);
   cue.playlistLoop = object.value("playlistLoop").toBool(false);
   cue.playlistAdvanceDelayMs = object.value("playlistAdvanceDelayMs").toInt(0);
+  cue.advanceTrigger = advanceTriggerFromString(object.value("advanceTrigger").toString("after_delay"));
+  cue.advanceLeadMs = object.value("advanceLeadMs").toInt(0);
   cue.autoStopMs = object.value("autoStopMs").toInt(0);
   return cue;
 }
@@ -115,6 +119,15 @@ QJsonObject calibrationToJson(int screenIndex, const OutputCalibration& calibrat
   object.insert("maskTopPx", calibration.maskTopPx);
   object.insert("maskRightPx", calibration.maskRightPx);
   object.insert("maskBottomPx", calibration.maskBottomPx);
+  object.insert("cornerPinEnabled", calibration.cornerPinEnabled);
+  object.insert("cornerTopLeftX", calibration.cornerTopLeftX);
+  object.insert("cornerTopLeftY", calibration.cornerTopLeftY);
+  object.insert("cornerTopRightX", calibration.cornerTopRightX);
+  object.insert("cornerTopRightY", calibration.cornerTopRightY);
+  object.insert("cornerBottomLeftX", calibration.cornerBottomLeftX);
+  object.insert("cornerBottomLeftY", calibration.cornerBottomLeftY);
+  object.insert("cornerBottomRightX", calibration.cornerBottomRightX);
+  object.insert("cornerBottomRightY", calibration.cornerBottomRightY);
   return object;
 }
 
@@ -128,6 +141,15 @@ OutputCalibration calibrationFromJson(const QJsonObject& object) {
   calibration.maskTopPx = object.value("maskTopPx").toInt(0);
   calibration.maskRightPx = object.value("maskRightPx").toInt(0);
   calibration.maskBottomPx = object.value("maskBottomPx").toInt(0);
+  calibration.cornerPinEnabled = object.value("cornerPinEnabled").toBool(false);
+  calibration.cornerTopLeftX = object.value("cornerTopLeftX").toInt(0);
+  calibration.cornerTopLeftY = object.value("cornerTopLeftY").toInt(0);
+  calibration.cornerTopRightX = object.value("cornerTopRightX").toInt(0);
+  calibration.cornerTopRightY = object.value("cornerTopRightY").toInt(0);
+  calibration.cornerBottomLeftX = object.value("cornerBottomLeftX").toInt(0);
+  calibration.cornerBottomLeftY = object.value("cornerBottomLeftY").toInt(0);
+  calibration.cornerBottomRightX = object.value("cornerBottomRightX").toInt(0);
+  calibration.cornerBottomRightY = object.value("cornerBottomRightY").toInt(0);
   return calibration;
 }
 
@@ -159,6 +181,13 @@ QJsonObject configToJson(const AppConfig& config, const QDir& baseDir) {
   object.insert("failoverPeerPort", config.failoverPeerPort);
   object.insert("failoverListenPort", config.failoverListenPort);
   object.insert("failoverSharedKey", config.failoverSharedKey);
+  object.insert("renderBackend", renderBackendToString(config.renderBackend));
+  object.insert("prefetchBudgetMb", config.prefetchBudgetMb);
+  object.insert("prefetchHeadMb", config.prefetchHeadMb);
+  object.insert("timecodeFreewheelMs", config.timecodeFreewheelMs);
+  object.insert("standbyLookahead", config.standbyLookahead);
+  object.insert("standbyMaxDecoders", config.standbyMaxDecoders);
+  object.insert("standbyBudgetMb", config.standbyBudgetMb);
   return object;
 }
 
@@ -190,6 +219,13 @@ AppConfig configFromJson(const QJsonObject& object, const QDir& baseDir) {
   config.failoverPeerPort = object.value("failoverPeerPort").toInt(9101);
   config.failoverListenPort = object.value("failoverListenPort").toInt(9101);
   config.failoverSharedKey = object.value("failoverSharedKey").toString();
+  config.renderBackend = renderBackendFromString(object.value("renderBackend").toString("native_windows"));
+  config.prefetchBudgetMb = object.value("prefetchBudgetMb").toInt(512);
+  config.prefetchHeadMb = object.value("prefetchHeadMb").toInt(32);
+  config.timecodeFreewheelMs = object.value("timecodeFreewheelMs").toInt(1000);
+  config.standbyLookahead = object.value("standbyLookahead").toInt(4);
+  config.standbyMaxDecoders = object.value("standbyMaxDecoders").toInt(4);
+  config.standbyBudgetMb = object.value("standbyBudgetMb").toInt(1024);
   return config;
 }
 
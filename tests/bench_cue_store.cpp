@@ -0,0 +1,229 @@
+#include <initializer_list>
+#include <iostream>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include "core/CueStore.h"
+
+namespace {
+
+// A touring show: most cues play their own clip, with a holding slate and a
+// handful of looping backgrounds reused across it.
+constexpr int kCueCount = 800;
+constexpr int kSlateEvery = 10;
+constexpr int kBackgrounds = 20;
+constexpr int kCuesPerPlaylist = 70;
+constexpr int kTargetSets = 4;
+constexpr int kFilterPresets = 3;
+constexpr int kFilterChains = 7;
+constexpr int kLiveUrls = 2;
+constexpr int kPasses = 1000;
+
+bool require(bool condition, const char* message) {
+  if (condition) {
+    return true;
+  }
+
+  std::cerr << "Benchmark check failed: " << message << '\n';
+  return false;
+}
+
+template <typename Visit>
+void forEachString(const Cue& cue, Visit visit) {
+  visit(cue.id);
+  visit(cue.playlistId);
+  visit(cue.timecodeTrigger);
+  visit(cue.hotkey);
+  visit(cue.name);
+  visit(cue.filePath);
+  visit(cue.targetSetId);
+  visit(cue.liveInputUrl);
+  visit(cue.filterPresetId);
+  visit(cue.videoFilter);
+}
+
+// The cue array plus every string buffer it references, each distinct buffer
+// counted once: a QArrayData header in front of capacity + 1 UTF-16 units.
+qint64 footprintBytes(const QVector<Cue>& cues) {
+  QSet<const QChar*> buffers;
+  qint64 bytes = cues.capacity() * static_cast<qint64>(sizeof(Cue));
+  for (const Cue& cue : cues) {
+    forEachString(cue, [&](const QString& value) {
+      if (value.isEmpty() || buffers.contains(value.constData())) {
+        return;
+      }
+      buffers.insert(value.constData());
+      bytes += static_cast<qint64>(sizeof(QArrayData)) + (value.capacity() + 1) * static_cast<qint64>(sizeof(char16_t));
+    });
+  }
+  return bytes;
+}
+
+// Every string is built on its own, the way a project load produces them, so
+// equal values start out in separate buffers.
+QVector<Cue> buildShow() {
+  QVector<Cue> cues;
+  cues.reserve(kCueCount);
+  for (int i = 0; i < kCueCount; ++i) {
+    Cue cue;
+    cue.id = QString("cue-%1").arg(i, 4, 10, QChar('0'));
+    cue.name = QString("Act %1 / scene %2 / cue %3").arg(i / 300 + 1).arg(i / 20 + 1).arg(i % 20 + 1);
+    if (i % kSlateEvery == 0) {
+      cue.filePath = "/shows/tour-2026/media/slate-holding.mov";
+    } else if (i % kSlateEvery <= 2) {
+      cue.filePath = QString("/shows/tour-2026/media/loops/bg-%1.mov").arg(i % kBackgrounds, 2, 10, QChar('0'));
+    } else {
+      cue.filePath = QString("/shows/tour-2026/media/scenes/sc%1-%2.mov").arg(i / 20 + 1).arg(i % 20 + 1);
+    }
+    cue.playlistId = QString("playlist-%1").arg(i / kCuesPerPlaylist);
+    cue.targetSetId = QString("set-%1").arg(i % kTargetSets);
+    cue.layer = i % 4;
+    cue.targetScreen = i % 3;
+    if (i % 6 == 0) {
+      cue.filterPresetId = QString("preset-%1").arg((i / 6) % kFilterPresets);
+    }
+    if (i % 25 == 0) {
+      cue.videoFilter = QString("eq=brightness=0.0%1,hflip").arg((i / 25) % kFilterChains);
+    }
+    if (i % 2 == 0) {
+      cue.timecodeTrigger = QString("01:%1:%2:00").arg((i / 60) % 60, 2, 10, QChar('0')).arg(i % 60, 2, 10, QChar('0'));
+    }
+    if (i % 20 == 0) {
+      cue.hotkey = QString("Ctrl+Shift+%1").arg((i / 20) % 10);
+    }
+    if (i % 80 == 0) {
+      cue.isLiveInput = true;
+      cue.liveInputUrl = QString("ndi://stage-cam-%1").arg((i / 80) % kLiveUrls);
+    }
+    cues.push_back(cue);
+  }
+  return cues;
+}
+
+// Distinct non-empty values across the fields CueStore interns.
+int distinctInternedValues(const QVector<Cue>& cues) {
+  QSet<QString> values;
+  for (const Cue& cue : cues) {
+    for (const QString* value : {&cue.playlistId, &cue.filePath, &cue.targetSetId, &cue.liveInputUrl,
+                                 &cue.filterPresetId, &cue.videoFilter}) {
+      if (!value->isEmpty()) {
+        values.insert(*value);
+      }
+    }
+  }
+  return static_cast<int>(values.size());
+}
+
+bool sameStrings(const Cue& lhs, const Cue& rhs) {
+  return lhs.id == rhs.id && lhs.playlistId == rhs.playlistId && lhs.timecodeTrigger == rhs.timecodeTrigger &&
+         lhs.hotkey == rhs.hotkey && lhs.name == rhs.name && lhs.filePath == rhs.filePath &&
+         lhs.targetSetId == rhs.targetSetId && lhs.liveInputUrl == rhs.liveInputUrl &&
+         lhs.filterPresetId == rhs.filterPresetId && lhs.videoFilter == rhs.videoFilter;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  QCoreApplication app(argc, argv);
+  Q_UNUSED(app);
+
+  const QVector<Cue> plain = buildShow();
+  const qint64 plainBytes = footprintBytes(plain);
+
+  QElapsedTimer timer;
+  timer.start();
+  CueStore store;
+  store.assign(plain);
+  const qint64 assignNs = timer.nsecsElapsed();
+  const qint64 storeBytes = footprintBytes(store.cues());
+
+  if (!require(store.size() == kCueCount, "Every cue should be stored.")) {
+    return 1;
+  }
+  for (int row = 0; row < kCueCount; ++row) {
+    if (!require(sameStrings(store.at(row), plain.at(row)), "Interning changed a cue's values.")) {
+      return 1;
+    }
+  }
+  if (!require(store.at(0).filePath.constData() == store.at(kSlateEvery).filePath.constData(),
+               "Cues on the same media file should share one buffer.")) {
+    return 1;
+  }
+  const int kInterned = distinctInternedValues(plain);
+  if (!require(store.internedCount() == kInterned, "Only the repeated fields should be interned.")) {
+    return 1;
+  }
+  if (!require(!store.isValidRow(kCueCount) && store.at(kCueCount).id.isEmpty(),
+               "Rows out of range should read as an empty cue.")) {
+    return 1;
+  }
+
+  Cue edited = store.at(1);
+  edited.filePath = "/shows/tour-2026/media/slate-holding.mov";
+  store.replace(1, edited);
+  if (!require(store.at(1).filePath.constData() == store.at(0).filePath.constData(),
+               "Edited cues should pick up interned values.")) {
+    return 1;
+  }
+
+  // Values no cue holds any more leave the table.
+  edited.filePath = "/shows/tour-2026/media/one-off.mov";
+  store.replace(1, edited);
+  const int withOneOff = store.internedCount();
+  edited.filePath = store.at(0).filePath;
+  store.replace(1, edited);
+  if (!require(withOneOff == kInterned + 1 && store.internedCount() == kInterned,
+               "Replacing a cue should release values only it held.")) {
+    return 1;
+  }
+  CueStore emptied;
+  emptied.assign(plain.mid(0, kCuesPerPlaylist));
+  while (emptied.size() > 0) {
+    emptied.removeAt(emptied.size() - 1);
+  }
+  if (!require(emptied.internedCount() == 0, "Removing every cue should empty the table.")) {
+    return 1;
+  }
+
+  // The old accessor handed back a copy per row; every string in it took a
+  // reference and released it again.
+  qint64 copySum = 0;
+  timer.restart();
+  for (int pass = 0; pass < kPasses; ++pass) {
+    for (int row = 0; row < kCueCount; ++row) {
+      const Cue cue = plain.at(row);
+      copySum += cue.layer + cue.filePath.size();
+    }
+  }
+  const qint64 copyNs = timer.nsecsElapsed();
+
+  qint64 refSum = 0;
+  timer.restart();
+  for (int pass = 0; pass < kPasses; ++pass) {
+    for (int row = 0; row < kCueCount; ++row) {
+      const Cue& cue = store.at(row);
+      refSum += cue.layer + cue.filePath.size();
+    }
+  }
+  const qint64 refNs = timer.nsecsElapsed();
+  if (!require(copySum == refSum, "Copy and reference walks disagree.")) {
+    return 1;
+  }
+
+  // Reported, not asserted: what interning saves depends on how much a show
+  // repeats itself.
+  const double ratio = static_cast<double>(storeBytes) / static_cast<double>(plainBytes);
+  const double rows = static_cast<double>(kCueCount) * kPasses;
+  std::cout << "cues=" << kCueCount << " sizeof(Cue)=" << sizeof(Cue) << " interned=" << store.internedCount()
+            << " assign_ms=" << assignNs / 1000000.0 << '\n'
+            << "plain: bytes=" << plainBytes << " per_cue=" << plainBytes / kCueCount << '\n'
+            << "store: bytes=" << storeBytes << " per_cue=" << storeBytes / kCueCount << " ratio=" << ratio << '\n'
+            << "walk: copy_ns_per_row=" << copyNs / rows << " ref_ns_per_row=" << refNs / rows << '\n';
+
+  std::cout << "cue_store_bench passed\n";
+  return 0;
+}
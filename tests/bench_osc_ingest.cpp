@@ -0,0 +1,340 @@
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QUdpSocket>
+#include <QVector>
+#include <QtEndian>
+
+#include "control/OscPacketRing.h"
+#include "control/OscParser.h"
+#include "control/OscReceiver.h"
+#include "core/TriggerStamp.h"
+
+namespace {
+
+constexpr int kDistinctPackets = 256;
+constexpr int kRounds = 40;
+// Datagrams in flight at once; well inside the ring and the socket buffer so
+// nothing is dropped on loopback.
+constexpr int kWindow = 64;
+constexpr qint64 kWaitTimeoutMs = 5000;
+
+bool require(bool condition, const char* message) {
+  if (condition) {
+    return true;
+  }
+
+  std::cerr << "Benchmark check failed: " << message << '\n';
+  return false;
+}
+
+// The per-datagram path OscServer used before: a QByteArray per read, QString
+// conversions and a QVector of arguments per message, regex tokenising.
+struct LegacyArgument {
+  enum class Type { Int, Float, String } type = Type::String;
+  int intValue = 0;
+  float floatValue = 0.0f;
+  QString stringValue;
+};
+
+struct LegacyMessage {
+  QString address;
+  QVector<LegacyArgument> args;
+};
+
+bool legacyReadPaddedString(const QByteArray& data, int* offset, QString* out) {
+  const int start = *offset;
+  int end = start;
+  while (end < data.size() && data.at(end) != '\0') {
+    ++end;
+  }
+  if (end >= data.size()) {
+    return false;
+  }
+  *out = QString::fromUtf8(data.constData() + start, end - start);
+  int aligned = end + 1;
+  while (aligned % 4 != 0) {
+    ++aligned;
+  }
+  if (aligned > data.size()) {
+    return false;
+  }
+  *offset = aligned;
+  return true;
+}
+
+bool legacyParseOsc(const QByteArray& datagram, LegacyMessage* message) {
+  if (datagram.isEmpty() || datagram.at(0) != '/') {
+    return false;
+  }
+  int offset = 0;
+  QString typeTags;
+  if (!legacyReadPaddedString(datagram, &offset, &message->address) ||
+      !legacyReadPaddedString(datagram, &offset, &typeTags) || !typeTags.startsWith(',')) {
+    return false;
+  }
+  message->args.clear();
+  for (int i = 1; i < typeTags.size(); ++i) {
+    LegacyArgument arg;
+    const QChar type = typeTags.at(i);
+    if (type == 'i' || type == 'f') {
+      if (offset + 4 > datagram.size()) {
+        return false;
+      }
+      const quint32 raw = qFromBigEndian<quint32>(reinterpret_cast<const uchar*>(datagram.constData() + offset));
+      if (type == 'i') {
+        arg.type = LegacyArgument::Type::Int;
+        arg.intValue = static_cast<int>(raw);
+      } else {
+        arg.type = LegacyArgument::Type::Float;
+        std::memcpy(&arg.floatValue, &raw, sizeof(float));
+      }
+      offset += 4;
+    } else if (type == 's') {
+      if (!legacyReadPaddedString(datagram, &offset, &arg.stringValue)) {
+        return false;
+      }
+    } else {
+      return false;
+    }
+    message->args.push_back(arg);
+  }
+  return true;
+}
+
+bool legacyParseText(const QByteArray& datagram, LegacyMessage* message) {
+  const QString line = QString::fromUtf8(datagram).trimmed();
+  const QStringList parts = line.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
+  if (parts.isEmpty()) {
+    return false;
+  }
+  QString command = parts.first().toLower();
+  if (command == "play") {
+    command = "/cue/play";
+  } else if (command == "take") {
+    command = "/cue/take";
+  } else if (command == "dmx") {
+    command = "/dmx";
+  } else if (!command.startsWith('/')) {
+    return false;
+  }
+  message->address = command;
+  message->args.clear();
+  for (int i = 1; i < parts.size(); ++i) {
+    LegacyArgument arg;
+    bool ok = false;
+    arg.intValue = parts.at(i).toInt(&ok);
+    arg.type = ok ? LegacyArgument::Type::Int : LegacyArgument::Type::String;
+    if (!ok) {
+      arg.stringValue = parts.at(i);
+    }
+    message->args.push_back(arg);
+  }
+  return true;
+}
+
+void appendPadded(QByteArray* out, const QByteArray& text) {
+  out->append(text);
+  out->append('\0');
+  while (out->size() % 4 != 0) {
+    out->append('\0');
+  }
+}
+
+void appendInt(QByteArray* out, qint32 value) {
+  char raw[4];
+  qToBigEndian(value, raw);
+  out->append(raw, 4);
+}
+
+// A show-control mix: mostly /cue/play and /dmx from a console, some text
+// commands and a few string-carrying messages.
+std::vector<QByteArray> makePackets() {
+  std::vector<QByteArray> packets;
+  for (int i = 0; i < kDistinctPackets; ++i) {
+    QByteArray packet;
+    switch (i % 4) {
+      case 0:
+        appendPadded(&packet, "/cue/play");
+        appendPadded(&packet, ",i");
+        appendInt(&packet, i);
+        break;
+      case 1:
+        appendPadded(&packet, "/dmx");
+        appendPadded(&packet, ",ii");
+        appendInt(&packet, i % 512 + 1);
+        appendInt(&packet, i % 256);
+        break;
+      case 2:
+        appendPadded(&packet, "/timecode");
+        appendPadded(&packet, ",si");
+        appendPadded(&packet, QByteArray("01:02:03:") + QByteArray::number(i % 30));
+        appendInt(&packet, 30);
+        break;
+      default:
+        packet = QByteArray("PLAY  ") + QByteArray::number(i) + "\n";
+        break;
+    }
+    packets.push_back(packet);
+  }
+  return packets;
+}
+
+bool sameMessage(const LegacyMessage& legacy, const OscMessageView& view) {
+  if (legacy.address.toUtf8() != QByteArray(view.address.data(), static_cast<qsizetype>(view.address.size())) ||
+      legacy.args.size() != view.argCount) {
+    return false;
+  }
+  for (int i = 0; i < view.argCount; ++i) {
+    const LegacyArgument& expected = legacy.args.at(i);
+    const OscArgumentView& actual = view.args[static_cast<std::size_t>(i)];
+    if (static_cast<int>(expected.type) != static_cast<int>(actual.type) || expected.intValue != actual.intValue ||
+        expected.stringValue.toUtf8() !=
+            QByteArray(actual.stringValue.data(), static_cast<qsizetype>(actual.stringValue.size()))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool waitFor(QCoreApplication& app, const auto& done) {
+  QElapsedTimer timer;
+  timer.start();
+  while (!done()) {
+    if (timer.elapsed() > kWaitTimeoutMs) {
+      return false;
+    }
+    app.processEvents(QEventLoop::AllEvents, 5);
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  QCoreApplication app(argc, argv);
+  const std::vector<QByteArray> packets = makePackets();
+  bool ok = true;
+
+  // The per-datagram cost of the old path, for comparison only.
+  QElapsedTimer timer;
+  timer.start();
+  qint64 legacyChecksum = 0;
+  for (int round = 0; round < kRounds; ++round) {
+    for (const QByteArray& source : packets) {
+      // The legacy path allocated the datagram buffer on every read.
+      QByteArray datagram;
+      datagram.resize(source.size());
+      std::memcpy(datagram.data(), source.constData(), static_cast<std::size_t>(source.size()));
+      LegacyMessage message;
+      if (legacyParseOsc(datagram, &message) || legacyParseText(datagram, &message)) {
+        legacyChecksum += message.args.size();
+      }
+    }
+  }
+  const qint64 legacyNs = timer.nsecsElapsed();
+
+  OscPacketRing ring;
+  QThread ioThread;
+  auto* receiver = new OscReceiver(&ring);
+  receiver->moveToThread(&ioThread);
+  QObject::connect(&ioThread, &QThread::finished, receiver, &QObject::deleteLater);
+  ioThread.start();
+
+  bool listening = false;
+  QString error;
+  QMetaObject::invokeMethod(
+      receiver, [&]() { listening = receiver->open(0, &error); }, Qt::BlockingQueuedConnection);
+  if (!require(listening, "UDP receiver opens")) {
+    std::cerr << error.toStdString() << '\n';
+    ioThread.quit();
+    ioThread.wait();
+    return 1;
+  }
+  const quint16 port = receiver->port();
+
+  // The first round checks every packet against the legacy parse of the same
+  // bytes; the rest only count, so the timing covers the ingest path.
+  bool verifying = true;
+  bool agree = true;
+  qint64 received = 0;
+  qint64 drains = 0;
+  qint64 ringChecksum = 0;
+  qint64 latencyNs = 0;
+  QObject::connect(receiver, &OscReceiver::packetsReady, &app, [&]() {
+    ring.clearDrainScheduled();
+    ++drains;
+    const qint64 drainNs = monotonicNowNs();
+    while (OscPacket* packet = ring.front()) {
+      if (verifying) {
+        const QByteArray datagram(packet->bytes(), packet->size);
+        LegacyMessage legacy;
+        agree &= packet->parsed && (legacyParseOsc(datagram, &legacy) || legacyParseText(datagram, &legacy)) &&
+                 sameMessage(legacy, packet->message);
+      }
+      ringChecksum += packet->message.argCount;
+      latencyNs += drainNs - packet->ingressNs;
+      ++received;
+      ring.pop();
+    }
+  });
+
+  QUdpSocket sender;
+  qint64 sent = 0;
+  const auto sendRound = [&]() {
+    for (std::size_t next = 0; next < packets.size();) {
+      for (int i = 0; i < kWindow && next < packets.size(); ++i, ++next) {
+        sender.writeDatagram(packets[next], QHostAddress::LocalHost, port);
+        ++sent;
+      }
+      if (!waitFor(app, [&]() { return received == sent; })) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  ok &= require(sendRound(), "first round arrives");
+  ok &= require(agree, "ring and legacy parsers agree");
+  verifying = false;
+  const qint64 warmReceived = received;
+  const qint64 warmDrains = drains;
+  ringChecksum = 0;
+  latencyNs = 0;
+
+  timer.restart();
+  for (int round = 0; ok && round < kRounds; ++round) {
+    ok &= require(sendRound(), "every datagram arrives");
+  }
+  const qint64 udpNs = timer.nsecsElapsed();
+  ok &= require(receiver->takeDropped() == 0, "nothing dropped");
+  ok &= require(ringChecksum == legacyChecksum, "same argument totals");
+
+  QMetaObject::invokeMethod(receiver, [receiver]() { receiver->close(); }, Qt::BlockingQueuedConnection);
+  ioThread.quit();
+  ioThread.wait();
+
+  if (!ok) {
+    return 1;
+  }
+
+  // Reported, not asserted: wall-clock numbers vary with the host.
+  const qint64 total = received - warmReceived;
+  const qint64 totalDrains = qMax<qint64>(1, drains - warmDrains);
+  std::cout << "osc_ingest_bench passed"
+            << " packets=" << total << " udp_ns_per_packet=" << static_cast<double>(udpNs) / total
+            << " packets_per_sec=" << static_cast<qint64>(total * 1e9 / qMax<qint64>(1, udpNs))
+            << " packets_per_drain=" << static_cast<double>(total) / totalDrains
+            << " ingress_to_drain_us=" << static_cast<double>(latencyNs) / total / 1e3
+            << " legacy_parse_ns_per_packet=" << static_cast<double>(legacyNs) / total << '\n';
+  return 0;
+}
@@ -0,0 +1,252 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QHostAddress>
+#include <QMetaObject>
+#include <QTcpSocket>
+#include <QThread>
+
+#include "control/OscPacketRing.h"
+#include "control/OscSlip.h"
+#include "control/OscTcpServer.h"
+#include "control/OscWriter.h"
+
+namespace {
+
+constexpr int kSessions = 200;
+constexpr int kFramesPerSession = 1000;
+// Over a ring slot, so it travels in the slot's spill buffer.
+constexpr int kLargeTextBytes = 6000;
+constexpr qint64 kConnectTimeoutMs = 10000;
+constexpr qint64 kStreamTimeoutMs = 60000;
+
+bool require(bool condition, const char* message) {
+  if (condition) {
+    return true;
+  }
+
+  std::cerr << "Benchmark check failed: " << message << '\n';
+  return false;
+}
+
+QByteArray decodeAll(const QByteArray& stream, int chunk, qint64* oversized) {
+  OscSlipDecoder decoder;
+  QByteArray frames;
+  for (int offset = 0; offset < stream.size(); offset += chunk) {
+    const int size = qMin(chunk, static_cast<int>(stream.size()) - offset);
+    int used = 0;
+    while (used < size) {
+      bool frameReady = false;
+      used += decoder.feed(stream.constData() + offset + used, size - used, &frameReady);
+      if (frameReady) {
+        frames += decoder.frame();
+        frames += '|';
+      }
+    }
+  }
+  *oversized = decoder.takeOversized();
+  return frames;
+}
+
+bool checkSlip() {
+  bool ok = true;
+  const QByteArray awkward = QByteArray("a\xC0" "b\xDB" "c\xDB\xDC", 7);
+  QByteArray stream;
+  OscSlipDecoder::encode(awkward, &stream);
+  ok &= require(!stream.mid(1, stream.size() - 2).contains('\xC0'), "END is escaped inside a frame");
+  OscSlipDecoder::encode("plain", &stream);
+
+  qint64 oversized = 0;
+  const QByteArray expected = awkward + '|' + QByteArray("plain|");
+  ok &= require(decodeAll(stream, static_cast<int>(stream.size()), &oversized) == expected, "frames decode whole");
+  ok &= require(decodeAll(stream, 1, &oversized) == expected, "frames decode byte by byte");
+
+  // Back-to-back ENDs are empty frames and vanish; an oversized frame is
+  // skipped without losing the one after it.
+  QByteArray tooBig;
+  OscSlipDecoder::encode(QByteArray(OscSlipDecoder::kMaxFrame + 1, 'x'), &tooBig);
+  OscSlipDecoder::encode("after", &tooBig);
+  ok &= require(decodeAll(QByteArray("\xC0\xC0") + tooBig, 1000, &oversized) == "after|", "oversized frame skipped");
+  ok &= require(oversized == 1, "oversized frame counted");
+  return ok;
+}
+
+bool waitFor(QCoreApplication& app, qint64 timeoutMs, const auto& done) {
+  QElapsedTimer timer;
+  timer.start();
+  while (!done()) {
+    if (timer.elapsed() > timeoutMs) {
+      return false;
+    }
+    app.processEvents(QEventLoop::AllEvents, 5);
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  QCoreApplication app(argc, argv);
+  bool ok = checkSlip();
+
+  OscPacketRing ring;
+  QThread ioThread;
+  auto* server = new OscTcpServer(&ring);
+  server->moveToThread(&ioThread);
+  QObject::connect(&ioThread, &QThread::finished, server, &QObject::deleteLater);
+  ioThread.start();
+
+  bool listening = false;
+  QString error;
+  QMetaObject::invokeMethod(
+      server, [&]() { listening = server->listen(0, &error); }, Qt::BlockingQueuedConnection);
+  if (!require(listening, "TCP server listens")) {
+    std::cerr << error.toStdString() << '\n';
+    ioThread.quit();
+    ioThread.wait();
+    return 1;
+  }
+
+  // Sessions are known by the client's local port, which is the server's
+  // view of the peer port.
+  QHash<quint16, int> clientForPort;
+  QHash<quint32, int> clientForSession;
+  std::vector<int> nextSequence(kSessions, 0);
+  std::vector<int> largeFrames(kSessions, 0);
+  qint64 frames = 0;
+  qint64 bytes = 0;
+  bool inOrder = true;
+  bool sameSession = true;
+  bool largeIntact = true;
+
+  QObject::connect(server, &OscTcpServer::packetsReady, &app, [&]() {
+    ring.clearDrainScheduled();
+    while (OscPacket* packet = ring.front()) {
+      const int client = clientForPort.value(packet->sender.port, -1);
+      if (client >= 0 && packet->parsed) {
+        const int known = clientForSession.value(packet->sender.session, client);
+        clientForSession.insert(packet->sender.session, client);
+        sameSession &= known == client && packet->sender.session != 0;
+
+        const OscMessageView& message = packet->message;
+        if (message.address == "/dmx" && message.hasArg(1, OscArgumentView::Type::Int)) {
+          inOrder &= message.args[0].intValue == client && message.args[1].intValue == nextSequence[client];
+          ++nextSequence[client];
+        } else if (message.address == "/text" && message.hasArg(0, OscArgumentView::Type::String)) {
+          largeIntact &= message.args[0].stringValue.size() == static_cast<std::size_t>(kLargeTextBytes) &&
+                         packet->size > OscPacket::kCapacity;
+          ++largeFrames[client];
+        }
+      }
+      ++frames;
+      bytes += packet->size;
+      ring.pop();
+    }
+  });
+
+  QElapsedTimer timer;
+  timer.start();
+  std::vector<QTcpSocket*> clients;
+  for (int i = 0; i < kSessions; ++i) {
+    auto* client = new QTcpSocket(&app);
+    client->connectToHost(QHostAddress::LocalHost, server->port());
+    clients.push_back(client);
+  }
+  ok &= require(waitFor(app, kConnectTimeoutMs,
+                        [&]() {
+                          for (const QTcpSocket* client : clients) {
+                            if (client->state() != QAbstractSocket::ConnectedState) {
+                              return false;
+                            }
+                          }
+                          return server->sessionCount() == kSessions;
+                        }),
+                "every client gets a session");
+  const qint64 connectNs = timer.nsecsElapsed();
+
+  // Each client streams its numbered frames with a large one in the middle;
+  // the ring fills many times over, so reading has to pause and resume.
+  OscWriter writer;
+  std::vector<QByteArray> streams(kSessions);
+  for (int i = 0; i < kSessions; ++i) {
+    clientForPort.insert(clients[static_cast<std::size_t>(i)]->localPort(), i);
+    for (int sequence = 0; sequence < kFramesPerSession; ++sequence) {
+      writer.begin("/dmx", "ii");
+      writer.addInt(i);
+      writer.addInt(sequence);
+      OscSlipDecoder::encode(writer.data(), &streams[static_cast<std::size_t>(i)]);
+      if (sequence == kFramesPerSession / 2) {
+        writer.begin("/text", "s");
+        writer.addString(std::string(kLargeTextBytes, static_cast<char>('a' + i % 26)));
+        OscSlipDecoder::encode(writer.data(), &streams[static_cast<std::size_t>(i)]);
+      }
+    }
+  }
+
+  const qint64 expectedFrames = static_cast<qint64>(kSessions) * (kFramesPerSession + 1);
+  timer.restart();
+  for (int i = 0; i < kSessions; ++i) {
+    clients[static_cast<std::size_t>(i)]->write(streams[static_cast<std::size_t>(i)]);
+  }
+  ok &= require(waitFor(app, kStreamTimeoutMs, [&]() { return frames >= expectedFrames; }), "every frame arrives");
+  const qint64 streamNs = qMax<qint64>(1, timer.nsecsElapsed());
+
+  ok &= require(frames == expectedFrames, "no frame lost or duplicated");
+  ok &= require(inOrder, "frames keep their order within a session");
+  ok &= require(sameSession, "a client keeps one session id");
+  ok &= require(largeIntact, "large frames arrive whole");
+  for (int i = 0; i < kSessions; ++i) {
+    ok &= require(nextSequence[static_cast<std::size_t>(i)] == kFramesPerSession &&
+                      largeFrames[static_cast<std::size_t>(i)] == 1,
+                  "every session delivered all its frames");
+  }
+
+  // A reply goes back down the session it is addressed to.
+  const quint32 replySession = clientForSession.key(0, 0);
+  writer.begin("/feedback/error", "s");
+  writer.addString("reply\xC0");
+  const QByteArray reply = writer.data();
+  QMetaObject::invokeMethod(server, [&, reply]() { server->send(replySession, reply); });
+  OscSlipDecoder replyDecoder;
+  bool replied = false;
+  ok &= require(replySession != 0 && waitFor(app, kConnectTimeoutMs,
+                                             [&]() {
+                                               const QByteArray incoming = clients[0]->readAll();
+                                               int used = 0;
+                                               while (used < incoming.size() && !replied) {
+                                                 used += replyDecoder.feed(incoming.constData() + used,
+                                                                           static_cast<int>(incoming.size()) - used,
+                                                                           &replied);
+                                               }
+                                               return replied;
+                                             }),
+                "reply arrives on its session");
+  ok &= require(replyDecoder.frame() == reply, "reply decodes intact");
+
+  for (QTcpSocket* client : clients) {
+    client->disconnectFromHost();
+  }
+  ok &= require(waitFor(app, kConnectTimeoutMs, [&]() { return server->sessionCount() == 0; }), "sessions close");
+  ok &= require(server->takeDropped() == 0, "nothing dropped");
+
+  QMetaObject::invokeMethod(server, [server]() { server->close(); }, Qt::BlockingQueuedConnection);
+  ioThread.quit();
+  ioThread.wait();
+
+  if (!ok) {
+    return 1;
+  }
+
+  const double streamSec = static_cast<double>(streamNs) / 1e9;
+  std::cout << "osc_tcp_bench passed: " << kSessions << " sessions connected in "
+            << static_cast<double>(connectNs) / 1e6 << " ms, " << frames << " frames in " << streamSec * 1e3
+            << " ms (" << static_cast<double>(frames) / streamSec << " frames/s, "
+            << static_cast<double>(bytes) / streamSec / (1024.0 * 1024.0) << " MB/s)\n";
+  return 0;
+}
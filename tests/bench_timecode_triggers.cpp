@@ -0,0 +1,193 @@
+#include <iostream>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <QStringList>
+#include <QVector>
+
+#include "core/Timecode.h"
+#include "core/TimecodeTriggerTable.h"
+
+namespace {
+
+constexpr int kCueCount = 10000;
+constexpr int kWildcardCues = 500;
+constexpr int kFps = 30;
+constexpr int kTableTicks = kFps * 60 * 10;
+constexpr int kLegacyTicks = kFps * 10;
+
+bool require(bool condition, const char* message) {
+  if (condition) {
+    return true;
+  }
+
+  std::cerr << "Benchmark check failed: " << message << '\n';
+  return false;
+}
+
+// Ticks start at 01:00:00:00, the usual show start.
+Timecode timecodeForTick(int tick) { return Timecode::fromFrames(kFps * 3600 + tick, kFps); }
+
+// Every frame of a day must survive frames -> fields -> frames, including
+// the drop-frame rates where whole frame numbers are skipped.
+bool roundTripsEveryFrame(int fps, bool dropFrame) {
+  for (qint32 frames = 0;; ++frames) {
+    const Timecode timecode = Timecode::fromFrames(frames, fps, dropFrame);
+    if (!timecode.isValid()) {
+      return frames > 0;
+    }
+    Timecode parsed;
+    if (Timecode::fromParts(timecode.parts(), fps, dropFrame) != timecode ||
+        !Timecode::parse(timecode.toString(), &parsed, fps) || parsed != timecode) {
+      std::cerr << "Round trip failed at " << frames << " (" << timecode.toString().toStdString() << ")\n";
+      return false;
+    }
+  }
+}
+
+// The per-tick path this table replaced: normalize with a fresh regex, then
+// test every cue's trigger, splitting wildcard triggers on each call.
+QString legacyNormalize(const QString& rawTimecode) {
+  const QString trimmed = rawTimecode.trimmed();
+  QRegularExpression fullPattern(R"(^(\d{1,2}):(\d{1,2}):(\d{1,2})(?::(\d{1,2}))?$)");
+  const QRegularExpressionMatch match = fullPattern.match(trimmed);
+  if (!match.hasMatch()) {
+    return {};
+  }
+  return QString("%1:%2:%3:%4")
+      .arg(match.captured(1).toInt(), 2, 10, QChar('0'))
+      .arg(match.captured(2).toInt(), 2, 10, QChar('0'))
+      .arg(match.captured(3).toInt(), 2, 10, QChar('0'))
+      .arg(match.captured(4).isEmpty() ? 0 : match.captured(4).toInt(), 2, 10, QChar('0'));
+}
+
+bool legacyMatches(const QString& cueTrigger, const QString& normalizedTimecode) {
+  const QString trigger = cueTrigger.trimmed().toLower();
+  if (trigger.isEmpty()) {
+    return false;
+  }
+  if (!trigger.contains('*')) {
+    return legacyNormalize(trigger) == normalizedTimecode;
+  }
+
+  const QStringList triggerParts = trigger.split(':');
+  const QStringList incomingParts = normalizedTimecode.split(':');
+  if (triggerParts.size() != 4 || incomingParts.size() != 4) {
+    return false;
+  }
+  for (int i = 0; i < 4; ++i) {
+    if (triggerParts.at(i) == "*") {
+      continue;
+    }
+    if (QString("%1").arg(triggerParts.at(i).toInt(), 2, 10, QChar('0')) != incomingParts.at(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  QCoreApplication app(argc, argv);
+  Q_UNUSED(app);
+
+  if (!require(roundTripsEveryFrame(25, false) && roundTripsEveryFrame(30, true) && roundTripsEveryFrame(60, true),
+               "Timecode conversions should round trip.")) {
+    return 1;
+  }
+  if (!require(Timecode::fromFrames(17982, 30, true).toString() == "00:10:00;00" &&
+                   Timecode::fromFrames(1800, 30, true).toString() == "00:01:00;02",
+               "Drop-frame labels should skip frames 0 and 1 outside tenth minutes.")) {
+    return 1;
+  }
+
+  // Exact triggers spread across the first ten minutes, plus a slice of
+  // wildcard triggers that fire once a second or once a minute.
+  QVector<Cue> cues;
+  cues.reserve(kCueCount);
+  for (int i = 0; i < kCueCount; ++i) {
+    Cue cue;
+    cue.id = QString("cue-%1").arg(i);
+    if (i < kWildcardCues) {
+      cue.timecodeTrigger = i % 2 == 0 ? QString("*:*:%1:00").arg(i % 60, 2, 10, QChar('0'))
+                                       : QString("*:%1:00:*").arg(i % 60, 2, 10, QChar('0'));
+    } else {
+      cue.timecodeTrigger = timecodeForTick((i * 7) % kTableTicks).toString();
+    }
+    cues.push_back(cue);
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  TimecodeTriggerTable table;
+  table.rebuild(cues);
+  const qint64 rebuildNs = timer.nsecsElapsed();
+  if (!require(table.triggerCount() == kCueCount, "Every trigger should compile.")) {
+    return 1;
+  }
+
+  // At high rates frame numbers pass 99 and must not carry into seconds.
+  TimecodeTriggerTable highRate;
+  Cue secondCue;
+  secondCue.timecodeTrigger = "00:00:01:00";
+  highRate.rebuild({secondCue});
+  QVector<int> highRateRows;
+  highRate.match(Timecode::fromParts({0, 0, 0, 100}, Timecode::kMaxFps), &highRateRows);
+  if (!require(highRateRows.isEmpty(), "Frame 100 should not match the next second.")) {
+    return 1;
+  }
+  highRate.match(Timecode::fromParts({0, 0, 1, 0}, Timecode::kMaxFps), &highRateRows);
+  if (!require(highRateRows.size() == 1, "The exact second should still match at a high rate.")) {
+    return 1;
+  }
+
+  QVector<int> rows;
+  qint64 tableMatches = 0;
+  timer.restart();
+  for (int tick = 0; tick < kTableTicks; ++tick) {
+    table.match(timecodeForTick(tick), &rows);
+    tableMatches += rows.size();
+  }
+  const qint64 tableNs = timer.nsecsElapsed();
+
+  qint64 legacyMatchCount = 0;
+  qint64 tableMatchesInWindow = 0;
+  timer.restart();
+  for (int tick = 0; tick < kLegacyTicks; ++tick) {
+    const QString normalized = legacyNormalize(timecodeForTick(tick).toString());
+    const QVector<Cue> snapshot = cues;
+    for (const Cue& cue : snapshot) {
+      if (legacyMatches(cue.timecodeTrigger, normalized)) {
+        ++legacyMatchCount;
+      }
+    }
+  }
+  const qint64 legacyNs = timer.nsecsElapsed();
+
+  for (int tick = 0; tick < kLegacyTicks; ++tick) {
+    table.match(timecodeForTick(tick), &rows);
+    tableMatchesInWindow += rows.size();
+  }
+  if (!require(tableMatchesInWindow == legacyMatchCount, "Table and per-cue scan disagree on matches.")) {
+    return 1;
+  }
+
+  const double tableTickUs = tableNs / 1000.0 / kTableTicks;
+  const double legacyTickUs = legacyNs / 1000.0 / kLegacyTicks;
+  std::cout << "cues=" << kCueCount << " fps=" << kFps << " rebuild_us=" << rebuildNs / 1000.0 << '\n'
+            << "table: ticks=" << kTableTicks << " matches=" << tableMatches << " us_per_tick=" << tableTickUs << '\n'
+            << "scan:  ticks=" << kLegacyTicks << " matches=" << legacyMatchCount << " us_per_tick=" << legacyTickUs
+            << '\n'
+            << "speedup=" << (tableTickUs > 0.0 ? legacyTickUs / tableTickUs : 0.0) << "x\n";
+
+  // A tick has to fit well inside one frame.
+  constexpr double kFrameUs = 1000000.0 / kFps;
+  if (!require(tableTickUs < kFrameUs / 10.0, "Table tick exceeds a tenth of a frame.")) {
+    return 1;
+  }
+
+  std::cout << "timecode_trigger_bench passed\n";
+  return 0;
+}
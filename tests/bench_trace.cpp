@@ -0,0 +1,165 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QString>
+
+#include "core/Trace.h"
+
+namespace {
+
+constexpr int kThreads = 4;
+constexpr int kGosPerThread = 3000;
+constexpr int kSpansPerGo = 3;
+constexpr int kSpans = kThreads * kGosPerThread * kSpansPerGo;
+constexpr int kDisabledSpans = 1000000;
+constexpr int kOverflow = 100;
+constexpr int kShortLivedThreads = 32;
+
+bool require(bool condition, const char* message) {
+  if (condition) {
+    return true;
+  }
+
+  std::cerr << "Benchmark check failed: " << message << '\n';
+  return false;
+}
+
+// Shaped like a GO: an outer span with a cue id around two nested ones.
+void recordGos(int count, const QString& cueId) {
+  for (int i = 0; i < count; ++i) {
+    const TraceScope go("playback", "playCueAtRow", [&cueId]() { return cueId; });
+    {
+      const TraceScope route("output", "routeCue", [&cueId]() { return cueId; });
+    }
+    const TraceScope load("mpv", "load");
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  QCoreApplication app(argc, argv);
+  Q_UNUSED(app);
+
+  const QString cueId("3f2c9a7e-4b1d-4c55-9e0a-6d8f1b2c3a4e");
+
+  QElapsedTimer timer;
+  timer.start();
+  for (int i = 0; i < kDisabledSpans; ++i) {
+    const TraceScope span("playback", "disabled");
+  }
+  const double disabledNs = static_cast<double>(timer.nsecsElapsed()) / kDisabledSpans;
+
+  int detailsMade = 0;
+  {
+    const TraceScope span("playback", "disabled", [&detailsMade]() {
+      ++detailsMade;
+      return QString("formatted");
+    });
+  }
+  if (!require(detailsMade == 0, "A detail should not be made while tracing is off.")) {
+    return 1;
+  }
+
+  Trace::start();
+  timer.restart();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&cueId]() { recordGos(kGosPerThread, cueId); });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  const double enabledNs = static_cast<double>(timer.nsecsElapsed()) / kSpans;
+  Trace::stop();
+
+  TraceStats stats;
+  const QByteArray json = Trace::toChromeJson(&stats);
+  if (!require(stats.threads == kThreads && stats.events == kSpans && stats.dropped == 0,
+               "Every span from every thread should be kept.")) {
+    return 1;
+  }
+
+  const QJsonDocument document = QJsonDocument::fromJson(json);
+  const QJsonArray events = document.object().value("traceEvents").toArray();
+  // One process name and one name per thread ride along with the spans.
+  if (!require(events.size() == stats.events + 1 + kThreads, "The export should hold every event once.")) {
+    return 1;
+  }
+
+  QSet<int> threadIds;
+  int withDetail = 0;
+  for (const QJsonValue& value : events) {
+    const QJsonObject event = value.toObject();
+    if (event.value("ph").toString() != "X") {
+      continue;
+    }
+    threadIds.insert(event.value("tid").toInt());
+    if (!require(event.value("ts").toDouble() >= 0.0 && event.value("dur").toDouble() >= 0.0,
+                 "Spans should start after the session and have a length.")) {
+      return 1;
+    }
+    if (event.value("args").toObject().value("detail").toString() == cueId) {
+      ++withDetail;
+    }
+  }
+  if (!require(threadIds.size() == kThreads, "Each thread should export under its own id.")) {
+    return 1;
+  }
+  if (!require(withDetail == 2 * kThreads * kGosPerThread, "Details should survive the export.")) {
+    return 1;
+  }
+
+  // A new session starts empty; a full buffer drops and counts the rest.
+  Trace::start();
+  std::thread flood([]() {
+    for (int i = 0; i < Trace::kEventsPerThread + kOverflow; ++i) {
+      Trace::instant("control", "flood");
+    }
+  });
+  flood.join();
+  Trace::stop();
+  Trace::toChromeJson(&stats);
+  if (!require(stats.threads == 1 && stats.events == Trace::kEventsPerThread && stats.dropped == kOverflow,
+               "A full buffer should drop and count further events.")) {
+    return 1;
+  }
+
+  // Threads that come and go hand their buffers on: once a session has
+  // moved past their events, new threads reuse them instead of allocating.
+  const auto runShortLived = []() {
+    for (int i = 0; i < kShortLivedThreads; ++i) {
+      std::thread worker([]() { Trace::instant("control", "shortLived"); });
+      worker.join();
+    }
+  };
+  Trace::start();
+  runShortLived();
+  Trace::stop();
+  Trace::toChromeJson(&stats);
+  const int buffersBefore = stats.buffers;
+  Trace::start();
+  runShortLived();
+  Trace::stop();
+  Trace::toChromeJson(&stats);
+  if (!require(stats.events == kShortLivedThreads && stats.buffers == buffersBefore,
+               "Buffers of exited threads should be reused.")) {
+    return 1;
+  }
+
+  // Timings are reported, not enforced: a loaded machine would fail any
+  // fixed limit without the code having changed.
+  std::cout << "threads=" << kThreads << " spans=" << kSpans << " json_bytes=" << json.size()
+            << " buffers=" << stats.buffers << '\n'
+            << "disabled_ns_per_span=" << disabledNs << " enabled_ns_per_span=" << enabledNs << '\n';
+
+  std::cout << "trace_bench passed\n";
+  return 0;
+}
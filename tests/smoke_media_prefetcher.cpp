@@ -0,0 +1,158 @@
+#include <iostream>
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QtEndian>
+
+#include "media/MediaPrefetcher.h"
+
+namespace {
+
+constexpr qint64 kKiB = 1024;
+constexpr qint64 kHeadBytes = 64 * kKiB;
+constexpr qint64 kMdatBytes = 2 * 1024 * kKiB;
+constexpr qint64 kHeadMoovBytes = 4 * kKiB;
+constexpr qint64 kTailMoovBytes = 256 * kKiB;
+constexpr qint64 kWaitTimeoutMs = 5000;
+// How long the walk is given to overrun its budget before it is trusted.
+constexpr qint64 kSettleMs = 200;
+
+bool require(bool condition, const char* message) {
+  if (condition) {
+    return true;
+  }
+
+  std::cerr << "Smoke check failed: " << message << '\n';
+  return false;
+}
+
+// An atom of totalBytes with a zeroed payload; 64-bit sizes use the
+// largesize field.
+QByteArray atom(const char* type, qint64 totalBytes, bool largeSize = false) {
+  QByteArray bytes;
+  char raw[8];
+  if (largeSize) {
+    qToBigEndian<quint32>(1, raw);
+    bytes.append(raw, 4);
+    bytes.append(type, 4);
+    qToBigEndian<quint64>(static_cast<quint64>(totalBytes), raw);
+    bytes.append(raw, 8);
+  } else {
+    qToBigEndian<quint32>(static_cast<quint32>(totalBytes), raw);
+    bytes.append(raw, 4);
+    bytes.append(type, 4);
+  }
+  bytes.append(QByteArray(static_cast<qsizetype>(totalBytes - bytes.size()), '\0'));
+  return bytes;
+}
+
+bool writeFile(const QString& path, const QByteArray& bytes) {
+  QFile file(path);
+  return file.open(QIODevice::WriteOnly | QIODevice::Truncate) && file.write(bytes) == bytes.size();
+}
+
+PrefetchLayout layoutOf(const QString& path) {
+  QFile file(path);
+  return file.open(QIODevice::ReadOnly) ? MediaPrefetcher::readLayout(file) : PrefetchLayout{};
+}
+
+qint64 costOf(const QString& path) {
+  qint64 total = 0;
+  for (const auto& range : MediaPrefetcher::warmRanges(layoutOf(path), kHeadBytes)) {
+    total += range.second;
+  }
+  return total;
+}
+
+bool waitFor(QCoreApplication& app, qint64 timeoutMs, const auto& done) {
+  QElapsedTimer timer;
+  timer.start();
+  while (!done()) {
+    if (timer.elapsed() > timeoutMs) {
+      return false;
+    }
+    app.processEvents(QEventLoop::AllEvents, 5);
+  }
+  return true;
+}
+
+// Warms paths under budget and returns the stats once expectedFiles are warm
+// and the walk has had time to overrun.
+PrefetchStats runWalk(QCoreApplication& app, const QStringList& paths, qint64 budgetBytes, int expectedFiles) {
+  MediaPrefetcher prefetcher;
+  prefetcher.setHeadBytes(kHeadBytes);
+  prefetcher.setBudgetBytes(budgetBytes);
+  prefetcher.prefetch(paths);
+  waitFor(app, kWaitTimeoutMs, [&]() { return prefetcher.stats().warmFiles >= expectedFiles; });
+  waitFor(app, kSettleMs, []() { return false; });
+  return prefetcher.stats();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  QCoreApplication app(argc, argv);
+  QTemporaryDir dir;
+  if (!require(dir.isValid(), "temporary directory")) {
+    return 1;
+  }
+
+  const QByteArray ftyp = atom("ftyp", 24);
+  const QString headPath = dir.filePath("moov-head.mp4");
+  const QString tailPath = dir.filePath("moov-tail.mp4");
+  const QString largePath = dir.filePath("large-mdat.mov");
+  const QString truncatedPath = dir.filePath("truncated.mp4");
+  const QString rawPath = dir.filePath("not-mp4.mxf");
+  bool ok = true;
+  ok &= require(writeFile(headPath, ftyp + atom("moov", kHeadMoovBytes) + atom("mdat", kMdatBytes)), "head file");
+  ok &= require(writeFile(tailPath, ftyp + atom("mdat", kMdatBytes) + atom("moov", kTailMoovBytes)), "tail file");
+  ok &= require(writeFile(largePath, ftyp + atom("mdat", kMdatBytes, true) + atom("moov", kHeadMoovBytes)),
+                "large mdat file");
+  ok &= require(writeFile(truncatedPath, ftyp + atom("mdat", kMdatBytes) + atom("moov", kHeadMoovBytes).left(512)),
+                "truncated file");
+  ok &= require(writeFile(rawPath, QByteArray(static_cast<qsizetype>(kMdatBytes), 'x')), "raw file");
+  if (!ok) {
+    return 1;
+  }
+
+  // Atom walk.
+  const PrefetchLayout head = layoutOf(headPath);
+  ok &= require(head.moovOffset == ftyp.size() && head.moovBytes == kHeadMoovBytes, "moov found at the head");
+  const PrefetchLayout tail = layoutOf(tailPath);
+  ok &= require(tail.moovOffset == ftyp.size() + kMdatBytes && tail.moovBytes == kTailMoovBytes,
+                "moov found at the tail");
+  ok &= require(layoutOf(largePath).moovOffset == ftyp.size() + kMdatBytes, "64-bit atom size skipped");
+  ok &= require(layoutOf(rawPath).moovOffset == -1, "non-MP4 has no moov");
+
+  // Warm ranges and their cost.
+  ok &= require(MediaPrefetcher::warmRanges(head, kHeadBytes) == QVector<QPair<qint64, qint64>>{{0, kHeadBytes}},
+                "head moov is inside the head window");
+  ok &= require(MediaPrefetcher::warmRanges(tail, kHeadBytes) ==
+                    QVector<QPair<qint64, qint64>>({{0, kHeadBytes}, {tail.moovOffset, kTailMoovBytes}}),
+                "tail moov is read beyond the head window");
+  ok &= require(costOf(truncatedPath) == kHeadBytes + 512, "moov past the end of the file is clamped");
+  ok &= require(costOf(rawPath) == kMdatBytes, "other containers read their tail");
+
+  // Budget walk: the tail file's moov counts against the budget, and a file
+  // that does not fit holds back everything less likely than it.
+  const qint64 headCost = costOf(headPath);
+  const qint64 tailCost = costOf(tailPath);
+  const PrefetchStats fits = runWalk(app, {headPath, tailPath, rawPath}, headCost + tailCost + kKiB, 2);
+  ok &= require(fits.warmFiles == 2 && fits.warmBytes == headCost + tailCost, "walk warms what fits");
+  ok &= require(fits.totalReadAheadBytes == headCost + tailCost, "walk stops at the budget");
+
+  const PrefetchStats blocked = runWalk(app, {tailPath, headPath}, tailCost - kKiB, 0);
+  ok &= require(blocked.warmFiles == 0 && blocked.totalReadAheadBytes == 0, "tail moov charged before warming");
+
+  if (!ok) {
+    return 1;
+  }
+
+  std::cout << "media_prefetcher_smoke passed: head cost " << headCost << " bytes, tail cost " << tailCost
+            << " bytes\n";
+  return 0;
+}
@@ -0,0 +1,80 @@
+#include <array>
+#include <iostream>
+#include <string_view>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+#include "control/OscAddressSpace.h"
+
+namespace {
+
+constexpr int kMatches = 1000000;
+
+bool require(bool condition, const char* message) {
+  if (condition) {
+    return true;
+  }
+
+  std::cerr << "Smoke check failed: " << message << '\n';
+  return false;
+}
+
+int routeOf(const OscAddressSpace& space, std::string_view address, std::string_view* capture = nullptr) {
+  std::array<OscRouteMatch, 4> matches;
+  const int count = space.match(address, matches.data(), static_cast<int>(matches.size()));
+  if (count != 1) {
+    return -count - 1;
+  }
+  if (capture != nullptr && matches[0].captureCount > 0) {
+    *capture = matches[0].captures[0];
+  }
+  return matches[0].route;
+}
+
+}  // namespace
+
+// Literal and placeholder routes, each OSC 1.0 pattern form, and the dispatch
+// cost of a plain address against routes shaped like the ones OscServer
+// registers.
+int main(int argc, char* argv[]) {
+  QCoreApplication app(argc, argv);
+  Q_UNUSED(app);
+
+  OscAddressSpace space;
+  bool ok = true;
+  ok &= require(space.addRoute("/cue/play", 0) && space.addRoute("/cue/play/<row>", 1) &&
+                    space.addRoute("/cue/preload", 2) && space.addRoute("/cue/take", 3) &&
+                    space.addRoute("/cue/id/<id>/go", 4) && space.addRoute("/layer/<screen>/<layer>/stop", 5),
+                "routes register");
+  ok &= require(!space.addRoute("/cue/play", 6) && !space.addRoute("/cue/*", 6),
+                "duplicate and pattern routes rejected");
+
+  std::string_view capture;
+  ok &= require(routeOf(space, "/cue/play") == 0 && routeOf(space, "/cue/play/") == 0, "literal route");
+  ok &= require(routeOf(space, "/cue/play/12", &capture) == 1 && capture == "12", "row placeholder");
+  ok &= require(routeOf(space, "/cue/id/3f2c-9a7e/go", &capture) == 4 && capture == "3f2c-9a7e", "cue id placeholder");
+  ok &= require(routeOf(space, "/layer/1/2/stop") == 5, "layer placeholders");
+  ok &= require(routeOf(space, "/cue/pl?y") == 0 && routeOf(space, "/cue/[s-z]ake") == 3, "? and [] patterns");
+  ok &= require(routeOf(space, "/cue/[!p]*") == 3, "negated set");
+  ok &= require(routeOf(space, "/cue/{play,take}") == -3 && routeOf(space, "/cue/p*") == -3, "{} and * fan out");
+  ok &= require(routeOf(space, "/cue/stop") == -1 && routeOf(space, "/cue//play") == -1, "unknown address");
+
+  const char* addresses[] = {"/cue/play", "/cue/play/7", "/cue/take", "/cue/id/3f2c9a7e-4b1d/go", "/layer/0/1/stop"};
+  std::array<OscRouteMatch, 4> matches;
+  int found = 0;
+  QElapsedTimer timer;
+  timer.start();
+  for (int i = 0; i < kMatches; ++i) {
+    found += space.match(addresses[i % 5], matches.data(), static_cast<int>(matches.size()));
+  }
+  const double matchNs = static_cast<double>(timer.nsecsElapsed()) / kMatches;
+  ok &= require(found == kMatches, "every address routes");
+
+  if (!ok) {
+    return 1;
+  }
+
+  std::cout << "osc_address_space_smoke passed: address_match_ns=" << matchNs << '\n';
+  return 0;
+}
@@ -0,0 +1,183 @@
+#include <chrono>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QStringList>
+#include <QUdpSocket>
+#include <QVector>
+#include <QtEndian>
+
+#include "control/OscParser.h"
+#include "control/OscServer.h"
+#include "control/OscWriter.h"
+
+namespace {
+
+constexpr qint64 kWaitTimeoutMs = 5000;
+constexpr qint64 kAheadMs = 300;
+// Due times are honoured to the scheduler's slack and timer grain.
+constexpr qint64 kEarlyToleranceMs = 20;
+constexpr qint64 kNtpUnixOffsetSec = 2208988800LL;
+
+bool require(bool condition, const char* message) {
+  if (condition) {
+    return true;
+  }
+
+  std::cerr << "Smoke check failed: " << message << '\n';
+  return false;
+}
+
+void appendInt(QByteArray* out, qint32 value) {
+  char raw[4];
+  qToBigEndian(value, raw);
+  out->append(raw, 4);
+}
+
+QByteArray makeMessage(const char* address, std::initializer_list<qint32> ints = {}) {
+  const std::string typeTags(ints.size(), 'i');
+  OscWriter writer;
+  writer.begin(address, typeTags);
+  for (qint32 value : ints) {
+    writer.addInt(value);
+  }
+  return writer.data();
+}
+
+QByteArray makeBundle(quint64 timetag, const std::vector<QByteArray>& elements) {
+  // "#bundle" with its terminating NUL fills the first 8 bytes.
+  QByteArray bundle("#bundle", 8);
+  char raw[8];
+  qToBigEndian(timetag, raw);
+  bundle.append(raw, 8);
+  for (const QByteArray& element : elements) {
+    appendInt(&bundle, static_cast<qint32>(element.size()));
+    bundle.append(element);
+  }
+  return bundle;
+}
+
+quint64 timetagAfterMs(qint64 aheadMs) {
+  const qint64 unixNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::system_clock::now().time_since_epoch())
+                            .count() +
+                        aheadMs * 1000000;
+  const quint64 seconds = static_cast<quint64>(unixNs / 1000000000 + kNtpUnixOffsetSec);
+  const quint64 fraction = (static_cast<quint64>(unixNs % 1000000000) << 32) / 1000000000U;
+  return (seconds << 32) | fraction;
+}
+
+// A nested bundle is flattened in wire order and never runs before the
+// bundle holding it; a malformed element rejects the whole bundle.
+bool checkParser() {
+  const quint64 later = (quint64(3900000000U) << 32) | 0x80000000U;
+  const QByteArray inner =
+      makeBundle(OscParser::kImmediately, {makeMessage("/cue/play", {2}), makeMessage("/dmx", {7, 1})});
+  const QByteArray outer = makeBundle(later, {makeMessage("/cue/play", {1}), inner, makeMessage("/cue/take")});
+
+  bool ok = true;
+  OscBundleView bundle;
+  ok &= require(OscParser::isBundle(outer.constData(), static_cast<int>(outer.size())), "bundle recognised");
+  ok &= require(OscParser::parseBundle(outer.constData(), static_cast<int>(outer.size()), &bundle), "bundle parses");
+  ok &= require(bundle.messageCount == 4, "nested bundle flattened");
+
+  const char* expected[] = {"/cue/play", "/cue/play", "/dmx", "/cue/take"};
+  for (int i = 0; ok && i < bundle.messageCount; ++i) {
+    const OscBundleElement& element = bundle.messages[static_cast<std::size_t>(i)];
+    OscMessageView message;
+    ok &= require(OscParser::parseMessage(element.bytes.data(), static_cast<int>(element.bytes.size()), &message) &&
+                      message.address == expected[i],
+                  "bundle keeps wire order");
+    ok &= require(element.timetag == later, "nested timetag not earlier than its parent");
+  }
+  ok &= require(OscParser::timetagToUnixNs(later) == (3900000000LL - kNtpUnixOffsetSec) * 1000000000LL + 500000000LL,
+                "timetag converts to Unix time");
+
+  QByteArray truncated = outer;
+  truncated.chop(4);
+  ok &= require(!OscParser::parseBundle(truncated.constData(), static_cast<int>(truncated.size()), &bundle),
+                "truncated bundle rejected");
+  return ok;
+}
+
+bool waitFor(QCoreApplication& app, const auto& done) {
+  QElapsedTimer timer;
+  timer.start();
+  while (!done()) {
+    if (timer.elapsed() > kWaitTimeoutMs) {
+      return false;
+    }
+    app.processEvents(QEventLoop::AllEvents, 5);
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  QCoreApplication app(argc, argv);
+  bool ok = checkParser();
+
+  OscServer server;
+  if (!require(server.start(0), "OSC server starts")) {
+    return 1;
+  }
+
+  int groups = 0;
+  QVector<int> groupRows;
+  QStringList groupCueIds;
+  QVector<int> singleRows;
+  QStringList singleCueIds;
+  int dmxMessages = 0;
+  QObject::connect(&server, &OscServer::playGroupRequested, &app,
+                   [&](const QVector<int>& rows, const QStringList& cueIds, const TriggerStamp&) {
+                     ++groups;
+                     groupRows = rows;
+                     groupCueIds = cueIds;
+                   });
+  QObject::connect(&server, &OscServer::playRowRequested, &app,
+                   [&](int row, const TriggerStamp&) { singleRows.push_back(row); });
+  QObject::connect(&server, &OscServer::playCueIdRequested, &app,
+                   [&](const QString& cueId, const TriggerStamp&) { singleCueIds.push_back(cueId); });
+  QObject::connect(&server, &OscServer::dmxValueReceived, &app, [&](int, int, const TriggerStamp&) { ++dmxMessages; });
+
+  QUdpSocket sender;
+  const auto send = [&](const QByteArray& packet) {
+    sender.writeDatagram(packet, QHostAddress::LocalHost, server.port());
+  };
+
+  // The GOs of one bundle leave as one group; its other messages still run.
+  send(makeBundle(OscParser::kImmediately, {makeMessage("/cue/play", {1}), makeMessage("/cue/id/abc/go"),
+                                            makeMessage("/dmx", {5, 9})}));
+  ok &= require(waitFor(app, [&]() { return groups == 1 && dmxMessages == 1; }), "immediate bundle runs");
+  ok &= require(groupRows == QVector<int>{1} && groupCueIds == QStringList{"abc"}, "bundle GOs grouped");
+  ok &= require(singleRows.isEmpty() && singleCueIds.isEmpty(), "grouped GOs are not also sent alone");
+
+  // A lone GO in a bundle goes out as a plain GO.
+  send(makeBundle(OscParser::kImmediately, {makeMessage("/cue/play", {4})}));
+  ok &= require(waitFor(app, [&]() { return singleRows.size() == 1; }), "single-GO bundle runs");
+  ok &= require(groups == 1 && singleRows.first() == 4, "single GO is not grouped");
+
+  // A timetagged group is held as a whole until it falls due.
+  QElapsedTimer due;
+  due.start();
+  send(makeBundle(timetagAfterMs(kAheadMs), {makeMessage("/cue/play", {2}), makeMessage("/cue/play", {3})}));
+  ok &= require(waitFor(app, [&]() { return groups == 2; }), "scheduled bundle runs");
+  const qint64 heldMs = due.elapsed();
+  ok &= require(heldMs >= kAheadMs - kEarlyToleranceMs, "scheduled group waits for its timetag");
+  ok &= require(groupRows == QVector<int>({2, 3}), "scheduled GOs grouped");
+
+  server.stop();
+  if (!ok) {
+    return 1;
+  }
+
+  std::cout << "osc_bundle_smoke passed: scheduled group held " << heldMs << " ms for " << kAheadMs << " ms\n";
+  return 0;
+}
@@ -0,0 +1,60 @@
+#include <iostream>
+
+#include <QCoreApplication>
+
+#include "control/OscParser.h"
+#include "control/OscWriter.h"
+
+namespace {
+
+bool require(bool condition, const char* message) {
+  if (condition) {
+    return true;
+  }
+
+  std::cerr << "Smoke check failed: " << message << '\n';
+  return false;
+}
+
+}  // namespace
+
+// Feedback messages written by OscWriter read back through the parser, and
+// the writer keeps one buffer from message to message.
+int main(int argc, char* argv[]) {
+  QCoreApplication app(argc, argv);
+  Q_UNUSED(app);
+
+  OscWriter writer;
+  const auto parseWritten = [&writer](OscMessageView* message) {
+    return OscParser::parseMessage(writer.data().constData(), static_cast<int>(writer.data().size()), message);
+  };
+
+  writer.begin("/feedback/layer/1/2/time", "fff");
+  writer.addFloat(1.5f);
+  writer.addFloat(8.5f);
+  writer.addFloat(10.0f);
+  OscMessageView message;
+  bool ok = require(parseWritten(&message), "written message parses");
+  ok &= require(message.address == "/feedback/layer/1/2/time" && message.argCount == 3 &&
+                    message.hasArg(2, OscArgumentView::Type::Float) && message.args[1].floatValue == 8.5f,
+                "float arguments round-trip");
+
+  const char* buffer = writer.data().constData();
+  writer.begin("/feedback/cue/live", "ssii");
+  writer.addString("abc");
+  writer.addString({});
+  writer.addInt(1);
+  writer.addInt(-2);
+  ok &= require(writer.data().constData() == buffer, "a shorter message reuses the buffer");
+  ok &= require(writer.data().size() % 4 == 0 && parseWritten(&message), "string arguments are padded");
+  ok &= require(message.args[0].stringValue == "abc" && message.args[1].stringValue.empty() &&
+                    message.args[3].intValue == -2,
+                "string and int arguments round-trip");
+
+  if (!ok) {
+    return 1;
+  }
+
+  std::cout << "osc_writer_smoke passed\n";
+  return 0;
+}
@@ -56,6 +56,8 @@ int main(int argc, char* argv[]) {
   cue.playlistAutoAdvance = true;
   cue.playlistLoop = true;
   cue.playlistAdvanceDelayMs = 1250;
+  cue.advanceTrigger = AdvanceTrigger::MediaEnd;
+  cue.advanceLeadMs = 400;
   cue.autoStopMs = 5000;
   input.cues.push_back(cue);
 
@@ -68,6 +70,15 @@ int main(int argc, char* argv[]) {
   calibration.maskTopPx = 20;
   calibration.maskRightPx = 30;
   calibration.maskBottomPx = 40;
+  calibration.cornerPinEnabled = true;
+  calibration.cornerTopLeftX = 12;
+  calibration.cornerTopLeftY = -8;
+  calibration.cornerTopRightX = -14;
+  calibration.cornerTopRightY = 6;
+  calibration.cornerBottomLeftX = 4;
+  calibration.cornerBottomLeftY = -3;
+  calibration.cornerBottomRightX = -9;
+  calibration.cornerBottomRightY = 11;
   input.calibrations.insert(2, calibration);
 
   input.config.oscPort = 9100;
@@ -93,6 +104,13 @@ int main(int argc, char* argv[]) {
   input.config.failoverPeerPort = 9201;
   input.config.failoverListenPort = 9200;
   input.config.failoverSharedKey = "shared-secret";
+  input.config.renderBackend = RenderBackend::SoftwareCompositor;
+  input.config.prefetchBudgetMb = 1024;
+  input.config.prefetchHeadMb = 48;
+  input.config.timecodeFreewheelMs = 2500;
+  input.config.standbyLookahead = 6;
+  input.config.standbyMaxDecoders = 3;
+  input.config.standbyBudgetMb = 768;
 
   const QString projectPath = tempDir.filePath("roundtrip.show");
   QString error;
@@ -193,6 +211,12 @@ int main(int argc, char* argv[]) {
   if (!require(loadedCue.playlistAdvanceDelayMs == cue.playlistAdvanceDelayMs, "Cue playlistAdvanceDelayMs mismatch.")) {
     return 1;
   }
+  if (!require(loadedCue.advanceTrigger == cue.advanceTrigger, "Cue advanceTrigger mismatch.")) {
+    return 1;
+  }
+  if (!require(loadedCue.advanceLeadMs == cue.advanceLeadMs, "Cue advanceLeadMs mismatch.")) {
+    return 1;
+  }
   if (!require(loadedCue.autoStopMs == cue.autoStopMs, "Cue autoStopMs mismatch.")) {
     return 1;
   }
@@ -228,6 +252,21 @@ int main(int argc, char* argv[]) {
   if (!require(loadedCalibration.maskBottomPx == calibration.maskBottomPx, "Calibration maskBottomPx mismatch.")) {
     return 1;
   }
+  if (!require(loadedCalibration.cornerPinEnabled == calibration.cornerPinEnabled,
+               "Calibration cornerPinEnabled mismatch.")) {
+    return 1;
+  }
+  if (!require(loadedCalibration.cornerTopLeftX == calibration.cornerTopLeftX &&
+                   loadedCalibration.cornerTopLeftY == calibration.cornerTopLeftY &&
+                   loadedCalibration.cornerTopRightX == calibration.cornerTopRightX &&
+                   loadedCalibration.cornerTopRightY == calibration.cornerTopRightY &&
+                   loadedCalibration.cornerBottomLeftX == calibration.cornerBottomLeftX &&
+                   loadedCalibration.cornerBottomLeftY == calibration.cornerBottomLeftY &&
+                   loadedCalibration.cornerBottomRightX == calibration.cornerBottomRightX &&
+                   loadedCalibration.cornerBottomRightY == calibration.cornerBottomRightY,
+               "Calibration corner pin mismatch.")) {
+    return 1;
+  }
 
   if (!require(output.config.oscPort == input.config.oscPort, "Config oscPort mismatch.")) {
     return 1;
@@ -304,6 +343,24 @@ int main(int argc, char* argv[]) {
                "Config failoverSharedKey mismatch.")) {
     return 1;
   }
+  if (!require(output.config.renderBackend == input.config.renderBackend, "Config renderBackend mismatch.")) {
+    return 1;
+  }
+  if (!require(output.config.prefetchBudgetMb == input.config.prefetchBudgetMb &&
+                   output.config.prefetchHeadMb == input.config.prefetchHeadMb,
+               "Config prefetch settings mismatch.")) {
+    return 1;
+  }
+  if (!require(output.config.timecodeFreewheelMs == input.config.timecodeFreewheelMs,
+               "Config timecode freewheel mismatch.")) {
+    return 1;
+  }
+  if (!require(output.config.standbyLookahead == input.config.standbyLookahead &&
+                   output.config.standbyMaxDecoders == input.config.standbyMaxDecoders &&
+                   output.config.standbyBudgetMb == input.config.standbyBudgetMb,
+               "Config standby settings mismatch.")) {
+    return 1;
+  }
 
   std::cout << "project_serializer_smoke passed\n";
   return 0;
@@ -0,0 +1,70 @@
+#include <iostream>
+
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QTimer>
+
+#include "player/MpvPlayer.h"
+
+namespace {
+
+bool require(bool condition, const char* message) {
+  if (condition) {
+    return true;
+  }
+
+  std::cerr << "Smoke check failed: " << message << '\n';
+  return false;
+}
+
+bool hasNonBlackPixel(const QImage& image) {
+  for (int y = 0; y < image.height(); y += 8) {
+    for (int x = 0; x < image.width(); x += 8) {
+      if ((image.pixel(x, y) & 0x00ffffff) != 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  QCoreApplication app(argc, argv);
+
+  // Software render mode creates no widget, so this runs headless on CPU-only
+  // nodes with nothing but libmpv and its lavfi test source.
+  MpvPlayer player(nullptr, MpvPlayer::OutputMode::SoftwareRender);
+  QObject::connect(&player, &IPlayer::playbackError,
+                   [](const QString& message) { std::cerr << message.toStdString() << '\n'; });
+
+  if (!require(player.view() == nullptr, "Software render player should not create a view.")) {
+    return 1;
+  }
+  if (!require(player.load("av://lavfi:testsrc=size=320x240:rate=25", false, false), "Test source failed to load.")) {
+    return 1;
+  }
+
+  const QSize frameSize(320, 240);
+  bool rendered = false;
+  QEventLoop loop;
+  QObject::connect(&player, &MpvPlayer::frameAvailable, &loop, [&]() {
+    if (player.renderSoftwareFrame(frameSize) && hasNonBlackPixel(player.softwareFrame())) {
+      rendered = true;
+      loop.quit();
+    }
+  });
+  QTimer::singleShot(10000, &loop, &QEventLoop::quit);
+  loop.exec();
+
+  if (!require(rendered, "No software frame was rendered within 10 seconds.")) {
+    return 1;
+  }
+  if (!require(player.softwareFrame().size() == frameSize, "Software frame size mismatch.")) {
+    return 1;
+  }
+
+  std::cout << "software_render_smoke passed\n";
+  return 0;
+}